@@ -108,17 +108,19 @@ enum class E_SH_TYPE : uint32_t {
     SH_TYPE_PRE_INIT = 16,
     SH_TYPE_GROUP = 17,
     SH_TYPE_SYMTBL_SHNDX = 18,
-    SH_TYPE_OPENCL_SOURCE = 0xff000000,           // CL source to link into LLVM binary
-    SH_TYPE_OPENCL_HEADER = 0xff000001,           // CL header to link into LLVM binary
-    SH_TYPE_OPENCL_LLVM_TEXT = 0xff000002,        // LLVM text
-    SH_TYPE_OPENCL_LLVM_BINARY = 0xff000003,      // LLVM byte code
-    SH_TYPE_OPENCL_LLVM_ARCHIVE = 0xff000004,     // LLVM archives(s)
-    SH_TYPE_OPENCL_DEV_BINARY = 0xff000005,       // Device binary (coherent by default)
-    SH_TYPE_OPENCL_OPTIONS = 0xff000006,          // CL Options
-    SH_TYPE_OPENCL_PCH = 0xff000007,              // PCH (pre-compiled headers)
-    SH_TYPE_OPENCL_DEV_DEBUG = 0xff000008,        // Device debug
-    SH_TYPE_SPIRV = 0xff000009,                   // SPIRV
-    SH_TYPE_NON_COHERENT_DEV_BINARY = 0xff00000a, // Non-coherent Device binary
+    SH_TYPE_OPENCL_SOURCE = 0xff000000,             // CL source to link into LLVM binary
+    SH_TYPE_OPENCL_HEADER = 0xff000001,             // CL header to link into LLVM binary
+    SH_TYPE_OPENCL_LLVM_TEXT = 0xff000002,          // LLVM text
+    SH_TYPE_OPENCL_LLVM_BINARY = 0xff000003,        // LLVM byte code
+    SH_TYPE_OPENCL_LLVM_ARCHIVE = 0xff000004,       // LLVM archives(s)
+    SH_TYPE_OPENCL_DEV_BINARY = 0xff000005,         // Device binary (coherent by default)
+    SH_TYPE_OPENCL_OPTIONS = 0xff000006,            // CL Options
+    SH_TYPE_OPENCL_PCH = 0xff000007,                // PCH (pre-compiled headers)
+    SH_TYPE_OPENCL_DEV_DEBUG = 0xff000008,          // Device debug
+    SH_TYPE_SPIRV = 0xff000009,                     // SPIRV
+    SH_TYPE_NON_COHERENT_DEV_BINARY = 0xff00000a,   // Non-coherent Device binary
+    SH_TYPE_OPENCL_KERNEL_METADATA = 0xff00000b,    // Precomputed kernel info metadata
+    SH_TYPE_OPENCL_DEV_BINARY_VARIANT = 0xff00000c, // Device binary for one target of a multi-device binary
 };
 
 // E_SH_FLAG - List of section header flags.
@@ -0,0 +1,410 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "offline_compiler/batch_compiler.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/helpers/hw_info.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace OCLRT {
+
+////////////////////////////////////////////////////////////////////////////////
+// ctor
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler::BatchCompiler() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// dtor
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler::~BatchCompiler() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// Create
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler *BatchCompiler::create(size_t numArgs, const char *const *argv, int &retVal) {
+    retVal = CL_SUCCESS;
+    auto pBatchCompiler = new BatchCompiler();
+
+    if (pBatchCompiler) {
+        retVal = pBatchCompiler->initialize(numArgs, argv);
+    }
+
+    if (retVal != CL_SUCCESS) {
+        delete pBatchCompiler;
+        pBatchCompiler = nullptr;
+    }
+
+    return pBatchCompiler;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// isBatchCommandLine
+////////////////////////////////////////////////////////////////////////////////
+bool BatchCompiler::isBatchCommandLine(size_t numArgs, const char *const *argv) {
+    for (size_t argIndex = 1; argIndex < numArgs; argIndex++) {
+        if (strcmp(argv[argIndex], "-batch") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// splitCommandLine
+////////////////////////////////////////////////////////////////////////////////
+bool BatchCompiler::splitCommandLine(const std::string &line, std::vector<std::string> &argsOut) {
+    std::string arg;
+    bool inArg = false;
+    bool inQuotes = false;
+
+    for (auto c : line) {
+        if (c == '"') {
+            inQuotes = !inQuotes;
+            inArg = true;
+        } else if (!inQuotes && (c == ' ' || c == '\t')) {
+            if (inArg) {
+                argsOut.push_back(arg);
+                arg.clear();
+                inArg = false;
+            }
+        } else {
+            arg += c;
+            inArg = true;
+        }
+    }
+    if (inArg) {
+        argsOut.push_back(arg);
+    }
+
+    return !inQuotes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Initialize
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::initialize(size_t numArgs, const char *const *argv) {
+    int retVal = parseCommandLine(numArgs, argv);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    void *pManifest = nullptr;
+    size_t manifestSize = loadDataFromFile(manifestFile.c_str(), pManifest);
+    if (manifestSize == 0) {
+        deleteDataReadFromFile(pManifest);
+        printf("Error: Cannot read batch manifest %s.\n", manifestFile.c_str());
+        return INVALID_FILE;
+    }
+    std::string manifest(reinterpret_cast<char *>(pManifest), manifestSize);
+    deleteDataReadFromFile(pManifest);
+
+    retVal = parseManifest(manifest);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    // compiler libraries are loaded once and shared by all batch items
+    compilerLibraries = std::make_shared<CompilerLibraries>();
+    retVal = compilerLibraries->load();
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, static_cast<uint32_t>(items.size()));
+
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ParseCommandLine
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::parseCommandLine(size_t numArgs, const char *const *argv) {
+    int retVal = CL_SUCCESS;
+
+    for (uint32_t argIndex = 1; argIndex < numArgs; argIndex++) {
+        if ((strcmp(argv[argIndex], "-batch") == 0) &&
+            (argIndex + 1 < numArgs)) {
+            manifestFile = argv[argIndex + 1];
+            argIndex++;
+        } else if ((strcmp(argv[argIndex], "-threads") == 0) &&
+                   (argIndex + 1 < numArgs)) {
+            numThreads = static_cast<uint32_t>(atoi(argv[argIndex + 1]));
+            argIndex++;
+        } else if ((strcmp(argv[argIndex], "-pack") == 0) &&
+                   (argIndex + 1 < numArgs)) {
+            packFile = argv[argIndex + 1];
+            argIndex++;
+        } else if (strcmp(argv[argIndex], "-q") == 0) {
+            quiet = true;
+        } else if (strcmp(argv[argIndex], "-?") == 0) {
+            printUsage();
+            retVal = PRINT_USAGE;
+        } else {
+            printf("Invalid option (arg %d): %s\n", argIndex, argv[argIndex]);
+            retVal = INVALID_COMMAND_LINE;
+            break;
+        }
+    }
+
+    if (retVal == CL_SUCCESS) {
+        if (manifestFile.empty()) {
+            printf("Error: Batch manifest file name missing.\n");
+            retVal = INVALID_COMMAND_LINE;
+        } else if (!fileExists(manifestFile)) {
+            printf("Error: Batch manifest %s missing.\n", manifestFile.c_str());
+            retVal = INVALID_FILE;
+        }
+    }
+
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ParseManifest
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::parseManifest(const std::string &manifest) {
+    std::istringstream manifestStream(manifest);
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (std::getline(manifestStream, line)) {
+        lineNumber++;
+        auto trimPos = line.find_last_not_of(" \t\r");
+        line = (trimPos == std::string::npos) ? "" : line.substr(0, trimPos + 1);
+        auto firstPos = line.find_first_not_of(" \t");
+        if (firstPos == std::string::npos || line[firstPos] == '#') {
+            continue;
+        }
+
+        std::vector<std::string> args;
+        if (!splitCommandLine(line, args)) {
+            printf("Error: Unterminated quote in batch manifest line %zu.\n", lineNumber);
+            return INVALID_COMMAND_LINE;
+        }
+        addItems(lineNumber, args);
+    }
+
+    if (items.empty()) {
+        printf("Error: Batch manifest %s does not contain any builds.\n", manifestFile.c_str());
+        return INVALID_FILE;
+    }
+
+    return CL_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AddItems
+////////////////////////////////////////////////////////////////////////////////
+void BatchCompiler::addItems(size_t lineNumber, std::vector<std::string> &args) {
+    if (quiet && std::find(args.begin(), args.end(), "-q") == args.end()) {
+        args.push_back("-q");
+    }
+
+    std::string inputFile;
+    std::vector<std::string> devices;
+    size_t deviceArgIndex = args.size();
+    for (size_t argIndex = 0; argIndex + 1 < args.size(); argIndex++) {
+        if (args[argIndex] == "-file") {
+            inputFile = args[argIndex + 1];
+        } else if (args[argIndex] == "-device") {
+            // comma separated device list expands into one build per device
+            deviceArgIndex = argIndex + 1;
+            std::istringstream deviceList(args[deviceArgIndex]);
+            std::string device;
+            while (std::getline(deviceList, device, ',')) {
+                if (!device.empty()) {
+                    devices.push_back(device);
+                }
+            }
+        }
+    }
+    if (devices.empty()) {
+        devices.push_back("");
+    }
+
+    for (auto &device : devices) {
+        BatchItem item;
+        item.lineNumber = lineNumber;
+        item.args = args;
+        if (deviceArgIndex < args.size()) {
+            item.args[deviceArgIndex] = device;
+        }
+        item.description = inputFile + " (" + device + ")";
+        items.push_back(std::move(item));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// CompileItem
+////////////////////////////////////////////////////////////////////////////////
+void BatchCompiler::compileItem(BatchItem &item) {
+    std::vector<const char *> argv;
+    argv.reserve(item.args.size() + 1);
+    argv.push_back("cloc");
+    for (auto &arg : item.args) {
+        argv.push_back(arg.c_str());
+    }
+
+    std::unique_ptr<OfflineCompiler> pCompiler(OfflineCompiler::create(argv.size(), argv.data(), item.retVal, compilerLibraries));
+    if (pCompiler == nullptr) {
+        return;
+    }
+
+    item.retVal = pCompiler->build();
+    item.buildLog = pCompiler->getBuildLog();
+
+    if (item.retVal == CL_SUCCESS && !packFile.empty()) {
+        size_t genBinarySize = 0;
+        auto pGenBinary = pCompiler->getGenBinary(genBinarySize);
+        auto hwInfo = pCompiler->peekHardwareInfo();
+        item.variant.coreFamily = hwInfo->pPlatform->eRenderCoreFamily;
+        item.variant.productFamily = hwInfo->pPlatform->eProductFamily;
+        item.variant.deviceBinary.assign(pGenBinary, genBinarySize);
+
+        size_t irBinarySize = 0;
+        auto pIrBinary = pCompiler->getIrBinary(irBinarySize, item.isSpirV);
+        if (pIrBinary) {
+            item.irBinary.assign(pIrBinary, irBinarySize);
+        }
+        item.options = pCompiler->getOptions();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Build
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::build() {
+    std::atomic<size_t> nextItem{0};
+    auto worker = [&]() {
+        for (size_t itemIndex = nextItem++; itemIndex < items.size(); itemIndex = nextItem++) {
+            compileItem(items[itemIndex]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32_t threadIndex = 1; threadIndex < numThreads; threadIndex++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto &workerThread : workers) {
+        workerThread.join();
+    }
+
+    int retVal = printResults();
+    if (retVal == CL_SUCCESS && !packFile.empty()) {
+        retVal = writeMultiDeviceBinary();
+    }
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PrintResults
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::printResults() {
+    int retVal = CL_SUCCESS;
+    size_t numFailed = 0;
+
+    for (size_t itemIndex = 0; itemIndex < items.size(); itemIndex++) {
+        auto &item = items[itemIndex];
+        if (item.buildLog.empty() == false) {
+            printf("%s\n", item.buildLog.c_str());
+        }
+
+        if (item.retVal == CL_SUCCESS) {
+            if (!isQuiet()) {
+                printf("[%zu/%zu] line %zu, %s: Build succeeded.\n", itemIndex + 1, items.size(), item.lineNumber, item.description.c_str());
+            }
+        } else {
+            printf("[%zu/%zu] line %zu, %s: Build failed with error code: %d\n", itemIndex + 1, items.size(), item.lineNumber, item.description.c_str(), item.retVal);
+            if (retVal == CL_SUCCESS) {
+                retVal = item.retVal;
+            }
+            numFailed++;
+        }
+    }
+
+    if (!isQuiet() || numFailed != 0) {
+        printf("Batch build finished: %zu succeeded, %zu failed.\n", items.size() - numFailed, numFailed);
+    }
+
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// WriteMultiDeviceBinary
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::writeMultiDeviceBinary() {
+    std::vector<DeviceBinaryVariant::Desc> variants;
+    for (auto &item : items) {
+        for (auto &variant : variants) {
+            if (variant.productFamily == item.variant.productFamily) {
+                printf("Error: Cannot pack line %zu, %s: device is already built on another line.\n", item.lineNumber, item.description.c_str());
+                return INVALID_COMMAND_LINE;
+            }
+        }
+        variants.push_back(std::move(item.variant));
+    }
+
+    // the first build provides the IR and options used by the runtime when no device binary matches
+    auto &fallbackItem = items[0];
+    CLElfLib::ElfBinaryStorage binary;
+    MultiDeviceBinaryWriter::write(variants, fallbackItem.irBinary, fallbackItem.isSpirV, fallbackItem.options, binary);
+
+    if (writeDataToFile(packFile.c_str(), binary.data(), binary.size()) != binary.size()) {
+        printf("Error: Cannot write multi-device binary %s.\n", packFile.c_str());
+        return INVALID_FILE;
+    }
+    if (!isQuiet()) {
+        printf("Multi-device binary with %zu device binaries written to %s.\n", variants.size(), packFile.c_str());
+    }
+    return CL_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PrintUsage
+////////////////////////////////////////////////////////////////////////////////
+void BatchCompiler::printUsage() {
+    printf("Compiles all builds listed in a manifest file, reusing compiler libraries between builds\n\n");
+    printf("cloc -batch <manifest> [-threads <count>] [-pack <filename>] [-q]\n\n");
+    printf("  -batch <manifest>            Indicates the manifest file. Each line holds the cloc\n");
+    printf("                               options of a single build, e.g.:\n");
+    printf("                               -file <filename> -device <device_type>[,<device_type>...] [OPTIONS]\n");
+    printf("                               Empty lines and lines starting with # are ignored.\n");
+    printf("  -threads <count>             Number of builds compiled in parallel.\n");
+    printf("                               Defaults to the number of hardware threads.\n");
+    printf("  -pack <filename>             Bundles the device binaries of all builds into a single\n");
+    printf("                               multi-device binary, loadable with clCreateProgramWithBinary\n");
+    printf("                               on any of the devices. The IR and options of the first build\n");
+    printf("                               are used to rebuild the program on other devices.\n");
+    printf("  -q                           Be more quiet. print only warnings and errors.\n");
+    printf("  -?                           Print this usage message.\n");
+}
+
+} // namespace OCLRT
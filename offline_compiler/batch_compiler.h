@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "offline_compiler/offline_compiler.h"
+#include "runtime/program/multi_device_binary.h"
+#include "CL/cl.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+
+class BatchCompiler {
+  public:
+    static BatchCompiler *create(size_t numArgs, const char *const *argv, int &retVal);
+    static bool isBatchCommandLine(size_t numArgs, const char *const *argv);
+    static bool splitCommandLine(const std::string &line, std::vector<std::string> &argsOut);
+
+    int build();
+    void printUsage();
+
+    BatchCompiler &operator=(const BatchCompiler &) = delete;
+    BatchCompiler(const BatchCompiler &) = delete;
+    ~BatchCompiler();
+
+    bool isQuiet() const {
+        return quiet;
+    }
+
+  protected:
+    struct BatchItem {
+        size_t lineNumber = 0;
+        std::vector<std::string> args;
+        std::string description;
+        int retVal = CL_SUCCESS;
+        std::string buildLog;
+
+        // outputs kept for -pack
+        DeviceBinaryVariant::Desc variant = {};
+        std::string irBinary;
+        bool isSpirV = false;
+        std::string options;
+    };
+
+    BatchCompiler();
+
+    int initialize(size_t numArgs, const char *const *argv);
+    int parseCommandLine(size_t numArgs, const char *const *argv);
+    int parseManifest(const std::string &manifest);
+    void addItems(size_t lineNumber, std::vector<std::string> &args);
+    void compileItem(BatchItem &item);
+    int printResults();
+    int writeMultiDeviceBinary();
+
+    std::string manifestFile;
+    std::string packFile;
+    uint32_t numThreads = 0;
+    bool quiet = false;
+
+    std::vector<BatchItem> items;
+    std::shared_ptr<CompilerLibraries> compilerLibraries = nullptr;
+};
+} // namespace OCLRT
@@ -20,6 +20,7 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "offline_compiler/batch_compiler.h"
 #include "offline_compiler/offline_compiler.h"
 #include "offline_compiler/utilities/safety_caller.h"
 #include "runtime/os_interface/os_library.h"
@@ -30,6 +31,16 @@ using namespace OCLRT;
 
 int main(int numArgs, const char *argv[]) {
     int retVal = CL_SUCCESS;
+
+    if (BatchCompiler::isBatchCommandLine(numArgs, argv)) {
+        BatchCompiler *pBatchCompiler = BatchCompiler::create(numArgs, argv, retVal);
+        if (retVal == CL_SUCCESS) {
+            retVal = pBatchCompiler->build();
+        }
+        delete pBatchCompiler;
+        return retVal;
+    }
+
     OfflineCompiler *pCompiler = OfflineCompiler::create(numArgs, argv, retVal);
 
     if (retVal == CL_SUCCESS) {
@@ -29,6 +29,8 @@
 #include "ocl_igc_interface/platform_helper.h"
 #include "offline_compiler.h"
 #include "igfxfmid.h"
+#include "runtime/compiler_interface/binary_cache.h"
+#include "runtime/compiler_interface/compiler_options.h"
 #include "runtime/helpers/file_io.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/os_inc_base.h"
@@ -37,6 +39,7 @@
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/validators.h"
+#include "runtime/memory_manager/memory_constants.h"
 #include "runtime/platform/extensions.h"
 #include "elf/writer.h"
 #include <iomanip>
@@ -100,14 +103,150 @@ OfflineCompiler::~OfflineCompiler() {
     delete[] genBinary;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// CompilerLibraries
+////////////////////////////////////////////////////////////////////////////////
+CompilerLibraries::CompilerLibraries() = default;
+
+CompilerLibraries::~CompilerLibraries() {
+    // device contexts have to be released before the libraries are unloaded
+    igcDeviceContexts.clear();
+    fclDeviceContexts.clear();
+    igcMain.reset();
+    fclMain.reset();
+}
+
+int CompilerLibraries::load() {
+    this->fclLib.reset(OsLibrary::load(Os::frontEndDllName));
+    if (this->fclLib == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    auto fclCreateMain = reinterpret_cast<CIF::CreateCIFMainFunc_t>(this->fclLib->getProcAddress(CIF::CreateCIFMainFuncName));
+    if (fclCreateMain == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    this->fclMain = CIF::RAII::UPtr(createMainNoSanitize(fclCreateMain));
+    if (this->fclMain == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    if (false == this->fclMain->IsCompatible<IGC::FclOclDeviceCtx>()) {
+        // given FCL is not compatible
+        DEBUG_BREAK_IF(true);
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    this->igcLib.reset(OsLibrary::load(Os::igcDllName));
+    if (this->igcLib == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    auto igcCreateMain = reinterpret_cast<CIF::CreateCIFMainFunc_t>(this->igcLib->getProcAddress(CIF::CreateCIFMainFuncName));
+    if (igcCreateMain == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    this->igcMain = CIF::RAII::UPtr(createMainNoSanitize(igcCreateMain));
+    if (this->igcMain == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    if (false == this->igcMain->IsCompatible<IGC::IgcOclDeviceCtx>()) {
+        // given IGC is not compatible
+        DEBUG_BREAK_IF(true);
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    return CL_SUCCESS;
+}
+
+CIF::RAII::UPtr_t<IGC::FclOclDeviceCtxTagOCL> CompilerLibraries::getFclDeviceCtx(const HardwareInfo &hwInfo) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = fclDeviceContexts.find(&hwInfo);
+    if (it != fclDeviceContexts.end()) {
+        return CIF::RAII::RetainAndPack<IGC::FclOclDeviceCtxTagOCL>(it->second.get());
+    }
+
+    auto newDeviceCtx = fclMain->CreateInterface<IGC::FclOclDeviceCtxTagOCL>();
+    if (newDeviceCtx == nullptr) {
+        return nullptr;
+    }
+    newDeviceCtx->SetOclApiVersion(hwInfo.capabilityTable.clVersionSupport * 10);
+
+    auto deviceCtx = CIF::RAII::RetainAndPack<IGC::FclOclDeviceCtxTagOCL>(newDeviceCtx.get());
+    fclDeviceContexts[&hwInfo] = std::move(newDeviceCtx);
+    return deviceCtx;
+}
+
+CIF::RAII::UPtr_t<IGC::IgcOclDeviceCtxTagOCL> CompilerLibraries::getIgcDeviceCtx(const HardwareInfo &hwInfo) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = igcDeviceContexts.find(&hwInfo);
+    if (it != igcDeviceContexts.end()) {
+        return CIF::RAII::RetainAndPack<IGC::IgcOclDeviceCtxTagOCL>(it->second.get());
+    }
+
+    auto newDeviceCtx = igcMain->CreateInterface<IGC::IgcOclDeviceCtxTagOCL>();
+    if (newDeviceCtx == nullptr) {
+        return nullptr;
+    }
+    newDeviceCtx->SetProfilingTimerResolution(static_cast<float>(hwInfo.capabilityTable.defaultProfilingTimerResolution));
+    auto igcPlatform = newDeviceCtx->GetPlatformHandle();
+    auto igcGtSystemInfo = newDeviceCtx->GetGTSystemInfoHandle();
+    auto igcFeWa = newDeviceCtx->GetIgcFeaturesAndWorkaroundsHandle();
+    if ((igcPlatform == nullptr) || (igcGtSystemInfo == nullptr) || (igcFeWa == nullptr)) {
+        return nullptr;
+    }
+    IGC::PlatformHelper::PopulateInterfaceWith(*igcPlatform.get(), *hwInfo.pPlatform);
+    IGC::GtSysInfoHelper::PopulateInterfaceWith(*igcGtSystemInfo.get(), *hwInfo.pSysInfo);
+    // populate with features
+    igcFeWa.get()->SetFtrDesktop(hwInfo.pSkuTable->ftrDesktop);
+    igcFeWa.get()->SetFtrChannelSwizzlingXOREnabled(hwInfo.pSkuTable->ftrChannelSwizzlingXOREnabled);
+
+    igcFeWa.get()->SetFtrGtBigDie(hwInfo.pSkuTable->ftrGtBigDie);
+    igcFeWa.get()->SetFtrGtMediumDie(hwInfo.pSkuTable->ftrGtMediumDie);
+    igcFeWa.get()->SetFtrGtSmallDie(hwInfo.pSkuTable->ftrGtSmallDie);
+
+    igcFeWa.get()->SetFtrGT1(hwInfo.pSkuTable->ftrGT1);
+    igcFeWa.get()->SetFtrGT1_5(hwInfo.pSkuTable->ftrGT1_5);
+    igcFeWa.get()->SetFtrGT2(hwInfo.pSkuTable->ftrGT2);
+    igcFeWa.get()->SetFtrGT3(hwInfo.pSkuTable->ftrGT3);
+    igcFeWa.get()->SetFtrGT4(hwInfo.pSkuTable->ftrGT4);
+
+    igcFeWa.get()->SetFtrIVBM0M1Platform(hwInfo.pSkuTable->ftrIVBM0M1Platform);
+    igcFeWa.get()->SetFtrGTL(hwInfo.pSkuTable->ftrGT1);
+    igcFeWa.get()->SetFtrGTM(hwInfo.pSkuTable->ftrGT2);
+    igcFeWa.get()->SetFtrGTH(hwInfo.pSkuTable->ftrGT3);
+
+    igcFeWa.get()->SetFtrSGTPVSKUStrapPresent(hwInfo.pSkuTable->ftrSGTPVSKUStrapPresent);
+    igcFeWa.get()->SetFtrGTA(hwInfo.pSkuTable->ftrGTA);
+    igcFeWa.get()->SetFtrGTC(hwInfo.pSkuTable->ftrGTC);
+    igcFeWa.get()->SetFtrGTX(hwInfo.pSkuTable->ftrGTX);
+    igcFeWa.get()->SetFtr5Slice(hwInfo.pSkuTable->ftr5Slice);
+
+    igcFeWa.get()->SetFtrGpGpuMidThreadLevelPreempt(hwInfo.pSkuTable->ftrGpGpuMidThreadLevelPreempt);
+    igcFeWa.get()->SetFtrIoMmuPageFaulting(hwInfo.pSkuTable->ftrIoMmuPageFaulting);
+    igcFeWa.get()->SetFtrWddm2Svm(hwInfo.pSkuTable->ftrWddm2Svm);
+    igcFeWa.get()->SetFtrPooledEuEnabled(hwInfo.pSkuTable->ftrPooledEuEnabled);
+
+    igcFeWa.get()->SetFtrResourceStreamer(hwInfo.pSkuTable->ftrResourceStreamer);
+
+    auto deviceCtx = CIF::RAII::RetainAndPack<IGC::IgcOclDeviceCtxTagOCL>(newDeviceCtx.get());
+    igcDeviceContexts[&hwInfo] = std::move(newDeviceCtx);
+    return deviceCtx;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Create
 ////////////////////////////////////////////////////////////////////////////////
-OfflineCompiler *OfflineCompiler::create(size_t numArgs, const char *const *argv, int &retVal) {
+OfflineCompiler *OfflineCompiler::create(size_t numArgs, const char *const *argv, int &retVal,
+                                         std::shared_ptr<CompilerLibraries> compilerLibraries) {
     retVal = CL_SUCCESS;
     auto pOffCompiler = new OfflineCompiler();
 
     if (pOffCompiler) {
+        pOffCompiler->compilerLibraries = std::move(compilerLibraries);
         retVal = pOffCompiler->initialize(numArgs, argv);
     }
 
@@ -138,9 +277,9 @@ int OfflineCompiler::buildSourceCode() {
         if (false == inputIsIntermediateRepresentation) {
             IGC::CodeType::CodeType_t intermediateRepresentation = useLlvmText ? IGC::CodeType::llvmLl : preferredIntermediateRepresentation;
             // sourceCode.size() returns the number of characters without null terminated char
-            auto fclSrc = CIF::Builtins::CreateConstBuffer(fclMain.get(), sourceCode.c_str(), sourceCode.size() + 1);
-            auto fclOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), options.c_str(), options.size());
-            auto fclInternalOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), internalOptions.c_str(), internalOptions.size());
+            auto fclSrc = CIF::Builtins::CreateConstBuffer(compilerLibraries->getFclMain(), sourceCode.c_str(), sourceCode.size() + 1);
+            auto fclOptions = CIF::Builtins::CreateConstBuffer(compilerLibraries->getFclMain(), options.c_str(), options.size());
+            auto fclInternalOptions = CIF::Builtins::CreateConstBuffer(compilerLibraries->getFclMain(), internalOptions.c_str(), internalOptions.size());
 
             auto fclTranslationCtx = fclDeviceCtx->CreateTranslationCtx(IGC::CodeType::oclC, intermediateRepresentation);
             auto igcTranslationCtx = igcDeviceCtx->CreateTranslationCtx(intermediateRepresentation, IGC::CodeType::oclGenBin);
@@ -177,9 +316,9 @@ int OfflineCompiler::buildSourceCode() {
                                                      nullptr, 0);
 
         } else {
-            auto igcSrc = CIF::Builtins::CreateConstBuffer(igcMain.get(), sourceCode.c_str(), sourceCode.size());
-            auto igcOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), nullptr, 0);
-            auto igcInternalOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), internalOptions.c_str(), internalOptions.size());
+            auto igcSrc = CIF::Builtins::CreateConstBuffer(compilerLibraries->getIgcMain(), sourceCode.c_str(), sourceCode.size());
+            auto igcOptions = CIF::Builtins::CreateConstBuffer(compilerLibraries->getIgcMain(), nullptr, 0);
+            auto igcInternalOptions = CIF::Builtins::CreateConstBuffer(compilerLibraries->getIgcMain(), internalOptions.c_str(), internalOptions.size());
             auto igcTranslationCtx = igcDeviceCtx->CreateTranslationCtx(inputFileSpirV ? IGC::CodeType::spirV : IGC::CodeType::llvmBc, IGC::CodeType::oclGenBin);
             igcOutput = igcTranslationCtx->Translate(igcSrc.get(), igcOptions.get(), igcInternalOptions.get(), nullptr, 0);
         }
@@ -212,6 +351,9 @@ int OfflineCompiler::build() {
     if (retVal == CL_SUCCESS) {
         generateElfBinary();
         writeOutAllFiles();
+        if (!cacheDirectory.empty()) {
+            writeOutCacheEntry();
+        }
     }
 
     return retVal;
@@ -337,100 +479,24 @@ int OfflineCompiler::initialize(size_t numArgs, const char *const *argv) {
         sourceCode = (pSource != nullptr) ? getStringWithinDelimiters((char *)pSourceFromFile) : (char *)pSourceFromFile;
     }
 
-    this->fclLib.reset(OsLibrary::load(Os::frontEndDllName));
-    if (this->fclLib == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    auto fclCreateMain = reinterpret_cast<CIF::CreateCIFMainFunc_t>(this->fclLib->getProcAddress(CIF::CreateCIFMainFuncName));
-    if (fclCreateMain == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    this->fclMain = CIF::RAII::UPtr(createMainNoSanitize(fclCreateMain));
-    if (this->fclMain == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    if (false == this->fclMain->IsCompatible<IGC::FclOclDeviceCtx>()) {
-        // given FCL is not compatible
-        DEBUG_BREAK_IF(true);
-        return CL_OUT_OF_HOST_MEMORY;
+    if (compilerLibraries == nullptr) {
+        compilerLibraries = std::make_shared<CompilerLibraries>();
+        retVal = compilerLibraries->load();
+        if (retVal != CL_SUCCESS) {
+            return retVal;
+        }
     }
 
-    this->fclDeviceCtx = this->fclMain->CreateInterface<IGC::FclOclDeviceCtxTagOCL>();
+    this->fclDeviceCtx = compilerLibraries->getFclDeviceCtx(*hwInfo);
     if (this->fclDeviceCtx == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
     }
-
-    fclDeviceCtx->SetOclApiVersion(hwInfo->capabilityTable.clVersionSupport * 10);
     preferredIntermediateRepresentation = fclDeviceCtx->GetPreferredIntermediateRepresentation();
 
-    this->igcLib.reset(OsLibrary::load(Os::igcDllName));
-    if (this->igcLib == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    auto igcCreateMain = reinterpret_cast<CIF::CreateCIFMainFunc_t>(this->igcLib->getProcAddress(CIF::CreateCIFMainFuncName));
-    if (igcCreateMain == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    this->igcMain = CIF::RAII::UPtr(createMainNoSanitize(igcCreateMain));
-    if (this->igcMain == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    if (false == this->igcMain->IsCompatible<IGC::IgcOclDeviceCtx>()) {
-        // given IGC is not compatible
-        DEBUG_BREAK_IF(true);
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    this->igcDeviceCtx = this->igcMain->CreateInterface<IGC::IgcOclDeviceCtxTagOCL>();
+    this->igcDeviceCtx = compilerLibraries->getIgcDeviceCtx(*hwInfo);
     if (this->igcDeviceCtx == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
     }
-    this->igcDeviceCtx->SetProfilingTimerResolution(static_cast<float>(hwInfo->capabilityTable.defaultProfilingTimerResolution));
-    auto igcPlatform = this->igcDeviceCtx->GetPlatformHandle();
-    auto igcGtSystemInfo = this->igcDeviceCtx->GetGTSystemInfoHandle();
-    auto igcFeWa = this->igcDeviceCtx->GetIgcFeaturesAndWorkaroundsHandle();
-    if ((igcPlatform == nullptr) || (igcGtSystemInfo == nullptr) || (igcFeWa == nullptr)) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-    IGC::PlatformHelper::PopulateInterfaceWith(*igcPlatform.get(), *hwInfo->pPlatform);
-    IGC::GtSysInfoHelper::PopulateInterfaceWith(*igcGtSystemInfo.get(), *hwInfo->pSysInfo);
-    // populate with features
-    igcFeWa.get()->SetFtrDesktop(hwInfo->pSkuTable->ftrDesktop);
-    igcFeWa.get()->SetFtrChannelSwizzlingXOREnabled(hwInfo->pSkuTable->ftrChannelSwizzlingXOREnabled);
-
-    igcFeWa.get()->SetFtrGtBigDie(hwInfo->pSkuTable->ftrGtBigDie);
-    igcFeWa.get()->SetFtrGtMediumDie(hwInfo->pSkuTable->ftrGtMediumDie);
-    igcFeWa.get()->SetFtrGtSmallDie(hwInfo->pSkuTable->ftrGtSmallDie);
-
-    igcFeWa.get()->SetFtrGT1(hwInfo->pSkuTable->ftrGT1);
-    igcFeWa.get()->SetFtrGT1_5(hwInfo->pSkuTable->ftrGT1_5);
-    igcFeWa.get()->SetFtrGT2(hwInfo->pSkuTable->ftrGT2);
-    igcFeWa.get()->SetFtrGT3(hwInfo->pSkuTable->ftrGT3);
-    igcFeWa.get()->SetFtrGT4(hwInfo->pSkuTable->ftrGT4);
-
-    igcFeWa.get()->SetFtrIVBM0M1Platform(hwInfo->pSkuTable->ftrIVBM0M1Platform);
-    igcFeWa.get()->SetFtrGTL(hwInfo->pSkuTable->ftrGT1);
-    igcFeWa.get()->SetFtrGTM(hwInfo->pSkuTable->ftrGT2);
-    igcFeWa.get()->SetFtrGTH(hwInfo->pSkuTable->ftrGT3);
-
-    igcFeWa.get()->SetFtrSGTPVSKUStrapPresent(hwInfo->pSkuTable->ftrSGTPVSKUStrapPresent);
-    igcFeWa.get()->SetFtrGTA(hwInfo->pSkuTable->ftrGTA);
-    igcFeWa.get()->SetFtrGTC(hwInfo->pSkuTable->ftrGTC);
-    igcFeWa.get()->SetFtrGTX(hwInfo->pSkuTable->ftrGTX);
-    igcFeWa.get()->SetFtr5Slice(hwInfo->pSkuTable->ftr5Slice);
-
-    igcFeWa.get()->SetFtrGpGpuMidThreadLevelPreempt(hwInfo->pSkuTable->ftrGpGpuMidThreadLevelPreempt);
-    igcFeWa.get()->SetFtrIoMmuPageFaulting(hwInfo->pSkuTable->ftrIoMmuPageFaulting);
-    igcFeWa.get()->SetFtrWddm2Svm(hwInfo->pSkuTable->ftrWddm2Svm);
-    igcFeWa.get()->SetFtrPooledEuEnabled(hwInfo->pSkuTable->ftrPooledEuEnabled);
-
-    igcFeWa.get()->SetFtrResourceStreamer(hwInfo->pSkuTable->ftrResourceStreamer);
 
     return retVal;
 }
@@ -491,6 +557,10 @@ int OfflineCompiler::parseCommandLine(size_t numArgs, const char *const *argv) {
                    (argIndex + 1 < numArgs)) {
             outputDirectory = argv[argIndex + 1];
             argIndex++;
+        } else if ((stringsAreEqual(argv[argIndex], "-cache_dir")) &&
+                   (argIndex + 1 < numArgs)) {
+            cacheDirectory = argv[argIndex + 1];
+            argIndex++;
         } else if (stringsAreEqual(argv[argIndex], "-q")) {
             quiet = true;
         } else if (stringsAreEqual(argv[argIndex], "-?")) {
@@ -520,9 +590,16 @@ int OfflineCompiler::parseCommandLine(size_t numArgs, const char *const *argv) {
             retVal = getHardwareInfo(deviceName.c_str());
             if (retVal != CL_SUCCESS) {
                 printf("Error: Cannot get HW Info for device %s.\n", deviceName.c_str());
+            } else if (cacheDirectory.empty()) {
+                std::string extensionsList = getExtensionsList(*hwInfo);
+                internalOptions.append(convertEnabledExtensionsToCompilerInternalOptions(extensionsList.c_str()));
+            } else if (inputFileLlvm || inputFileSpirV) {
+                printf("Error: Cache entries can be generated only for OpenCL C source input.\n");
+                retVal = INVALID_COMMAND_LINE;
+            } else {
+                // cached binary has to be built exactly as the runtime would build it
+                internalOptions = getRuntimeInternalOptions(compile64 || (is64bit && !compile32));
             }
-            std::string extensionsList = getExtensionsList(*hwInfo);
-            internalOptions.append(convertEnabledExtensionsToCompilerInternalOptions(extensionsList.c_str()));
         }
     }
 
@@ -533,11 +610,37 @@ int OfflineCompiler::parseCommandLine(size_t numArgs, const char *const *argv) {
 // ParseCommandLine
 ////////////////////////////////////////////////////////////////////////////////
 void OfflineCompiler::parseDebugSettings() {
+    if (!cacheDirectory.empty()) {
+        // already applied to the runtime internal options
+        return;
+    }
     if (DebugManager.flags.EnableStatelessToStatefulBufferOffsetOpt.get()) {
         internalOptions += "-cl-intel-has-buffer-offset-arg ";
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// GetRuntimeInternalOptions
+////////////////////////////////////////////////////////////////////////////////
+std::string OfflineCompiler::getRuntimeInternalOptions(bool target64bit) const {
+    uint32_t clVersion = hwInfo->capabilityTable.clVersionSupport;
+    if (DebugManager.flags.ForceOCLVersion.get() != 0) {
+        clVersion = DebugManager.flags.ForceOCLVersion.get();
+    }
+    // as in Device::initializeCaps with 32-bit allocator available
+    bool force32BitAddressing = target64bit && (DebugManager.flags.Force32bitAddressing.get() || clVersion < 20);
+    // as in HwHelper::setupHardwareCapabilities
+    bool statelessToStatefulWithOffsetSupported = hwInfo->pPlatform->eRenderCoreFamily != IGFX_GEN8_CORE;
+
+    std::string runtimeInternalOptions = CompilerOptions::getDeviceInternalOptions(clVersion, force32BitAddressing, statelessToStatefulWithOffsetSupported);
+    runtimeInternalOptions.append(CompilerOptions::preserveVec3Type);
+
+    std::string extensionsList = getDeviceExtensions(*hwInfo, clVersion);
+    runtimeInternalOptions.append(convertEnabledExtensionsToCompilerInternalOptions(extensionsList.c_str()));
+
+    return runtimeInternalOptions;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // ParseBinAsCharArray
 ////////////////////////////////////////////////////////////////////////////////
@@ -651,8 +754,14 @@ void OfflineCompiler::printUsage() {
     printf("  -spirv_input                  Indicates input file is a SpirV binary\n");
     printf("  -options <options>           Compiler options.\n");
     printf("  -options_name                Add suffix with compile options to filename\n");
+    printf("  -cache_dir <cache_dir>       Builds the program as the runtime does and stores it in\n");
+    printf("                               <cache_dir> as a runtime program binary cache entry.\n");
     printf("  -q                           Be more quiet. print only warnings and errors.\n");
     printf("  -?                           Print this usage message.\n");
+    printf("\n");
+    printf("cloc -batch <manifest> [-threads <count>] [-q]\n\n");
+    printf("  -batch <manifest>            Compiles all builds listed in the manifest file in parallel.\n");
+    printf("                               See cloc -batch <manifest> -? for details.\n");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -705,6 +814,26 @@ bool OfflineCompiler::generateElfBinary() {
     return retVal;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// MakeDirectories
+////////////////////////////////////////////////////////////////////////////////
+void makeDirectories(const std::string &directory) {
+    std::list<std::string> dirList;
+    std::string tmp = directory;
+    size_t pos = directory.size() + 1;
+
+    do {
+        dirList.push_back(tmp);
+        pos = tmp.find_last_of("/\\", pos);
+        tmp = tmp.substr(0, pos);
+    } while (pos != std::string::npos);
+
+    while (!dirList.empty()) {
+        MakeDirectory(dirList.back().c_str());
+        dirList.pop_back();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // WriteOutAllFiles
 ////////////////////////////////////////////////////////////////////////////////
@@ -718,20 +847,7 @@ void OfflineCompiler::writeOutAllFiles() {
     }
 
     if (outputDirectory != "") {
-        std::list<std::string> dirList;
-        std::string tmp = outputDirectory;
-        size_t pos = outputDirectory.size() + 1;
-
-        do {
-            dirList.push_back(tmp);
-            pos = tmp.find_last_of("/\\", pos);
-            tmp = tmp.substr(0, pos);
-        } while (pos != std::string::npos);
-
-        while (!dirList.empty()) {
-            MakeDirectory(dirList.back().c_str());
-            dirList.pop_back();
-        }
+        makeDirectories(outputDirectory);
     }
 
     if (irBinary) {
@@ -777,6 +893,35 @@ void OfflineCompiler::writeOutAllFiles() {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// WriteOutCacheEntry
+////////////////////////////////////////////////////////////////////////////////
+bool OfflineCompiler::writeOutCacheEntry() {
+    if (!genBinary || !genBinarySize) {
+        return false;
+    }
+
+    // same key as computed by CompilerInterface::build for this source and device
+    ArrayRef<const char> input(sourceCode.c_str(), sourceCode.size());
+    if (sourceCode.find("#include") != std::string::npos) {
+        input = ArrayRef<const char>(irBinary, irBinarySize);
+    }
+    auto kernelFileHash = BinaryCache::getCachedFileName(*hwInfo, input,
+                                                         ArrayRef<const char>(options.c_str(), options.size()),
+                                                         ArrayRef<const char>(internalOptions.c_str(), internalOptions.size()));
+
+    makeDirectories(cacheDirectory);
+    std::string cacheFile = generateFilePath(cacheDirectory, kernelFileHash, BinaryCache::cacheFileExtension);
+    if (writeDataToFile(cacheFile.c_str(), genBinary, genBinarySize) == 0) {
+        printf("Error: Cannot write cache entry %s.\n", cacheFile.c_str());
+        return false;
+    }
+    if (!isQuiet()) {
+        printf("Cache entry written to %s\n", cacheFile.c_str());
+    }
+    return true;
+}
+
 bool OfflineCompiler::readOptionsFromFile(std::string &options, const std::string &file) {
     if (!fileExists(file)) {
         return false;
@@ -26,8 +26,10 @@
 #include "ocl_igc_interface/fcl_ocl_device_ctx.h"
 #include "elf/writer.h"
 #include <cstdint>
-#include <string>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 
 namespace OCLRT {
 
@@ -43,10 +45,46 @@ enum ErrorCode {
 };
 
 std::string generateFilePath(const std::string &directory, const std::string &fileNameBase, const char *extension);
+void makeDirectories(const std::string &directory);
+
+// Compiler libraries loaded once and device contexts created once per device,
+// shared by all OfflineCompiler instances of a single cloc process
+class CompilerLibraries {
+  public:
+    CompilerLibraries();
+    ~CompilerLibraries();
+    CompilerLibraries(const CompilerLibraries &) = delete;
+    CompilerLibraries &operator=(const CompilerLibraries &) = delete;
+
+    int load();
+
+    CIF::CIFMain *getFclMain() const {
+        return fclMain.get();
+    }
+
+    CIF::CIFMain *getIgcMain() const {
+        return igcMain.get();
+    }
+
+    CIF::RAII::UPtr_t<IGC::FclOclDeviceCtxTagOCL> getFclDeviceCtx(const HardwareInfo &hwInfo);
+    CIF::RAII::UPtr_t<IGC::IgcOclDeviceCtxTagOCL> getIgcDeviceCtx(const HardwareInfo &hwInfo);
+
+  protected:
+    std::unique_ptr<OsLibrary> igcLib;
+    CIF::RAII::UPtr_t<CIF::CIFMain> igcMain = nullptr;
+
+    std::unique_ptr<OsLibrary> fclLib;
+    CIF::RAII::UPtr_t<CIF::CIFMain> fclMain = nullptr;
+
+    std::mutex mtx;
+    std::map<const HardwareInfo *, CIF::RAII::UPtr_t<IGC::FclOclDeviceCtxTagOCL>> fclDeviceContexts;
+    std::map<const HardwareInfo *, CIF::RAII::UPtr_t<IGC::IgcOclDeviceCtxTagOCL>> igcDeviceContexts;
+};
 
 class OfflineCompiler {
   public:
-    static OfflineCompiler *create(size_t numArgs, const char *const *argv, int &retVal);
+    static OfflineCompiler *create(size_t numArgs, const char *const *argv, int &retVal,
+                                   std::shared_ptr<CompilerLibraries> compilerLibraries = nullptr);
     int build();
     std::string &getBuildLog();
     void printUsage();
@@ -59,6 +97,22 @@ class OfflineCompiler {
         return quiet;
     }
 
+    const HardwareInfo *peekHardwareInfo() const {
+        return hwInfo;
+    }
+    const std::string &getOptions() const {
+        return options;
+    }
+    char *getGenBinary(size_t &genBinarySize) const {
+        genBinarySize = this->genBinarySize;
+        return genBinary;
+    }
+    char *getIrBinary(size_t &irBinarySize, bool &isSpirV) const {
+        irBinarySize = this->irBinarySize;
+        isSpirV = this->isSpirV;
+        return irBinary;
+    }
+
     std::string parseBinAsCharArray(uint8_t *binary, size_t size, std::string &fileName);
     static bool readOptionsFromFile(std::string &optionsOut, const std::string &file);
 
@@ -71,6 +125,7 @@ class OfflineCompiler {
     int initialize(size_t numArgs, const char *const *argv);
     int parseCommandLine(size_t numArgs, const char *const *argv);
     void parseDebugSettings();
+    std::string getRuntimeInternalOptions(bool target64bit) const;
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
     int buildSourceCode();
     void updateBuildLog(const char *pErrorString, const size_t errorStringSize);
@@ -86,6 +141,7 @@ class OfflineCompiler {
         return suffix;
     }
     void writeOutAllFiles();
+    bool writeOutCacheEntry();
     const HardwareInfo *hwInfo = nullptr;
 
     std::string deviceName;
@@ -93,6 +149,7 @@ class OfflineCompiler {
     std::string inputFile;
     std::string outputFile;
     std::string outputDirectory;
+    std::string cacheDirectory;
     std::string options;
     std::string internalOptions;
     std::string sourceCode;
@@ -115,12 +172,8 @@ class OfflineCompiler {
     char *debugDataBinary = nullptr;
     size_t debugDataBinarySize = 0;
 
-    std::unique_ptr<OsLibrary> igcLib = nullptr;
-    CIF::RAII::UPtr_t<CIF::CIFMain> igcMain = nullptr;
+    std::shared_ptr<CompilerLibraries> compilerLibraries = nullptr;
     CIF::RAII::UPtr_t<IGC::IgcOclDeviceCtxTagOCL> igcDeviceCtx = nullptr;
-
-    std::unique_ptr<OsLibrary> fclLib = nullptr;
-    CIF::RAII::UPtr_t<CIF::CIFMain> fclMain = nullptr;
     CIF::RAII::UPtr_t<IGC::FclOclDeviceCtxTagOCL> fclDeviceCtx = nullptr;
     IGC::CodeType::CodeType_t preferredIntermediateRepresentation;
 };
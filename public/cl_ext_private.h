@@ -29,6 +29,17 @@
 
 #define CL_DEVICE_DRIVER_VERSION_INTEL_NEO1 0x454E4831 // Driver version is ENH1
 
+/***************************************
+ * * Internal only queue wait strategy *
+ * ****************************************/
+#define CL_QUEUE_WAIT_STRATEGY_INTEL 0x4210
+
+#define CL_QUEUE_WAIT_STRATEGY_YIELD_INTEL 1
+#define CL_QUEUE_WAIT_STRATEGY_SPIN_INTEL 2
+#define CL_QUEUE_WAIT_STRATEGY_BACKOFF_INTEL 3
+#define CL_QUEUE_WAIT_STRATEGY_SLEEP_INTEL 4
+#define CL_QUEUE_WAIT_STRATEGY_ADAPTIVE_INTEL 5
+
 /***************************************
  * * cl_intel_debug_info extension *
  * ****************************************/
@@ -48,3 +59,19 @@
  * ****************************************/
 /* performance counter */
 #define CL_PROFILING_COMMAND_PERFCOUNTERS_INTEL 0x407F
+
+/***************************************
+ * * cl_intel_set_kernel_args extension *
+ * ****************************************/
+#define cl_intel_set_kernel_args 1
+
+// Kinds of values passed to clSetKernelArgsINTEL
+#define CL_KERNEL_ARG_VALUE_INTEL 0x4200
+#define CL_KERNEL_ARG_SVM_POINTER_INTEL 0x4201
+
+typedef struct _cl_kernel_arg_desc_intel {
+    cl_uint argIndex;
+    cl_uint argKind;
+    size_t argSize;
+    const void *argValue;
+} cl_kernel_arg_desc_intel;
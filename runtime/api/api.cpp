@@ -3341,6 +3341,7 @@ void *CL_API_CALL clGetExtensionFunctionAddress(const char *func_name) {
     RETURN_FUNC_PTR_IF_EXIST(clGetAcceleratorInfoINTEL);
     RETURN_FUNC_PTR_IF_EXIST(clRetainAcceleratorINTEL);
     RETURN_FUNC_PTR_IF_EXIST(clReleaseAcceleratorINTEL);
+    RETURN_FUNC_PTR_IF_EXIST(clSetKernelArgsINTEL);
 
     void *ret = sharingFactory.getExtensionFunctionAddress(func_name);
     if (ret != nullptr)
@@ -3676,27 +3677,31 @@ cl_int CL_API_CALL clSetKernelArgSVMPointer(cl_kernel kernel,
         return retVal;
     }
 
-    if (argIndex >= pKernel->getKernelArgsNumber()) {
-        retVal = CL_INVALID_ARG_INDEX;
+    retVal = pKernel->setArgSvmPointer(argIndex, argValue);
+    return retVal;
+}
+
+cl_int CL_API_CALL clSetKernelArgsINTEL(cl_kernel kernel,
+                                        cl_uint numArgs,
+                                        const cl_kernel_arg_desc_intel *argDescs) {
+    Kernel *pKernel = nullptr;
+
+    auto retVal = validateObjects(WithCastToInternal(kernel, &pKernel));
+    API_ENTER(&retVal);
+
+    DBG_LOG_INPUTS("kernel", kernel, "numArgs", numArgs, "argDescs", argDescs);
+
+    if (CL_SUCCESS != retVal) {
         return retVal;
     }
 
-    cl_int kernelArgAddressQualifier = pKernel->getKernelArgAddressQualifier(argIndex);
-    if ((kernelArgAddressQualifier != CL_KERNEL_ARG_ADDRESS_GLOBAL) &&
-        (kernelArgAddressQualifier != CL_KERNEL_ARG_ADDRESS_CONSTANT)) {
-        retVal = CL_INVALID_ARG_VALUE;
+    if (numArgs == 0 || argDescs == nullptr) {
+        retVal = CL_INVALID_VALUE;
         return retVal;
     }
 
-    GraphicsAllocation *pSvmAlloc = nullptr;
-    if (argValue != nullptr) {
-        pSvmAlloc = pKernel->getContext().getSVMAllocsManager()->getSVMAlloc(argValue);
-        if (pSvmAlloc == nullptr) {
-            retVal = CL_INVALID_ARG_VALUE;
-            return retVal;
-        }
-    }
-    retVal = pKernel->setArgSvmAlloc(argIndex, const_cast<void *>(argValue), pSvmAlloc);
+    TakeOwnershipWrapper<Kernel> kernelOwnership(*pKernel);
+    retVal = pKernel->setArgs(numArgs, argDescs);
     return retVal;
 }
 
@@ -3880,6 +3885,7 @@ cl_command_queue CL_API_CALL clCreateCommandQueueWithProperties(cl_context conte
             tokenValue != CL_QUEUE_SIZE &&
             tokenValue != CL_QUEUE_PRIORITY_KHR &&
             tokenValue != CL_QUEUE_THROTTLE_KHR &&
+            tokenValue != CL_QUEUE_WAIT_STRATEGY_INTEL &&
             !processExtraTokens(pDevice, propertiesAddress)) {
             err.set(CL_INVALID_VALUE);
             return commandQueue;
@@ -3930,6 +3936,13 @@ cl_command_queue CL_API_CALL clCreateCommandQueueWithProperties(cl_context conte
         }
     }
 
+    auto clWaitStrategy = getCmdQueueProperties<cl_queue_properties>(properties, CL_QUEUE_WAIT_STRATEGY_INTEL);
+    if (clWaitStrategy && ((commandQueueProperties & static_cast<cl_command_queue_properties>(CL_QUEUE_ON_DEVICE)) ||
+                           !WaitStrategyHelper::isValidClWaitStrategy(clWaitStrategy))) {
+        err.set(CL_INVALID_QUEUE_PROPERTIES);
+        return commandQueue;
+    }
+
     auto maskedFlags = commandQueueProperties & minimumCreateDeviceQueueFlags;
 
     if (maskedFlags == minimumCreateDeviceQueueFlags) {
@@ -23,6 +23,7 @@
 #include "CL/cl.h"
 #include "CL/cl_gl.h"
 #include "runtime/api/dispatch.h"
+#include "public/cl_ext_private.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -871,6 +872,12 @@ clSetPerformanceConfigurationINTEL(
     cl_uint *offsets,
     cl_uint *values);
 
+extern CL_API_ENTRY cl_int CL_API_CALL
+clSetKernelArgsINTEL(
+    cl_kernel kernel,
+    cl_uint numArgs,
+    const cl_kernel_arg_desc_intel *argDescs);
+
 extern CL_API_ENTRY cl_event CL_API_CALL
 clCreateEventFromGLsyncKHR(
     cl_context context,
@@ -43,6 +43,7 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/helpers/string.h"
 #include "CL/cl_ext.h"
+#include "public/cl_ext_private.h"
 #include "runtime/utilities/api_intercept.h"
 #include "runtime/utilities/tag_allocator.h"
 #include "runtime/helpers/convert_color.h"
@@ -90,6 +91,7 @@ CommandQueue::CommandQueue(Context *context,
     }
 
     commandQueueProperties = getCmdQueueProperties<cl_command_queue_properties>(properties);
+    waitStrategy = WaitStrategyHelper::getWaitStrategy(getCmdQueueProperties<cl_queue_properties>(properties, CL_QUEUE_WAIT_STRATEGY_INTEL));
     flushStamp.reset(new FlushStampTracker(true));
 }
 
@@ -114,6 +116,17 @@ CommandQueue::~CommandQueue() {
         }
         delete commandStream;
 
+        if (recordingCommandStream) {
+            alignedFree(recordingCommandStream->getCpuBase());
+            delete recordingCommandStream;
+        }
+        for (auto &heap : recordingHeaps) {
+            if (heap && heap->getGraphicsAllocation()) {
+                memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(heap->getGraphicsAllocation()), REUSABLE_ALLOCATION);
+            }
+            delete heap;
+        }
+
         if (perfConfigurationData) {
             delete perfConfigurationData;
         }
@@ -156,7 +169,7 @@ void CommandQueue::waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushS
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Waiting for taskCount:", taskCountToWait);
     DBG_LOG(LogTaskCounts, __FUNCTION__, "Line: ", __LINE__, "Current taskCount:", getHwTag());
 
-    device->getCommandStreamReceiver().waitForTaskCountWithKmdNotifyFallback(taskCountToWait, flushStampToWait, useQuickKmdSleep);
+    device->getCommandStreamReceiver().waitForTaskCountWithKmdNotifyFallback(taskCountToWait, flushStampToWait, useQuickKmdSleep, waitStrategy);
 
     DEBUG_BREAK_IF(getHwTag() < taskCountToWait);
     latestTaskCountWaited = taskCountToWait;
@@ -600,6 +613,62 @@ void CommandQueue::releaseIndirectHeap(IndirectHeap::Type heapType) {
     this->getDevice().getCommandStreamReceiver().releaseIndirectHeap(heapType);
 }
 
+LinearStream &CommandQueue::getRecordingCS(size_t minRequiredSize) {
+    if (!recordingCommandStream) {
+        recordingCommandStream = new LinearStream(nullptr, 0);
+    }
+
+    if (recordingCommandStream->getAvailableSpace() < minRequiredSize) {
+        auto usedSize = recordingCommandStream->getUsed();
+        auto requiredSize = alignUp(usedSize + minRequiredSize, MemoryConstants::pageSize);
+        auto buffer = alignedMalloc(requiredSize, MemoryConstants::pageSize);
+
+        auto oldBuffer = recordingCommandStream->getCpuBase();
+        if (oldBuffer) {
+            memcpy_s(buffer, requiredSize, oldBuffer, usedSize);
+            alignedFree(oldBuffer);
+        }
+        recordingCommandStream->replaceBuffer(buffer, requiredSize);
+        recordingCommandStream->getSpace(usedSize);
+    }
+
+    return *recordingCommandStream;
+}
+
+IndirectHeap &CommandQueue::getRecordingHeap(IndirectHeap::Type heapType, size_t minRequiredSize) {
+    DEBUG_BREAK_IF(static_cast<uint32_t>(heapType) >= arrayCount(recordingHeaps));
+    auto &heap = recordingHeaps[heapType];
+    GraphicsAllocation *heapMemory = nullptr;
+
+    if (heap)
+        heapMemory = heap->getGraphicsAllocation();
+
+    if (heap && heap->getAvailableSpace() < minRequiredSize && heapMemory) {
+        device->getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
+        heapMemory = nullptr;
+    }
+
+    if (!heapMemory) {
+        allocateHeapMemory(heapType, minRequiredSize, heap);
+    }
+
+    return *heap;
+}
+
+LinearStream &CommandQueue::spliceRecordedCommands(size_t &commandStreamStart) {
+    auto &recordedCommands = getRecordingCS(0);
+    auto commandsSize = recordedCommands.getUsed();
+
+    auto &queueCommandStream = getCS(commandsSize);
+    commandStreamStart = queueCommandStream.getUsed();
+    void *pDst = queueCommandStream.getSpace(commandsSize);
+    //transfer the recorded commands to commandStream of the queue
+    memcpy_s(pDst, commandsSize, recordedCommands.getCpuBase(), commandsSize);
+
+    recordedCommands.replaceBuffer(recordedCommands.getCpuBase(), recordedCommands.getMaxAvailableSpace());
+    return queueCommandStream;
+}
+
 void CommandQueue::dispatchAuxTranslation(MultiDispatchInfo &multiDispatchInfo, BuffersForAuxTranslation &buffersForAuxTranslation,
                                           AuxTranslationDirection auxTranslationDirection) {
     auto &builder = getDevice().getExecutionEnvironment()->getBuiltIns()->getBuiltinDispatchInfoBuilder(EBuiltInOps::AuxTranslation, getContext(), getDevice());
@@ -24,11 +24,13 @@
 #include "runtime/api/cl_types.h"
 #include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/helpers/base_object.h"
+#include "runtime/command_stream/wait_strategy.h"
 #include "runtime/helpers/properties_helper.h"
 #include "runtime/event/user_event.h"
 #include "runtime/os_interface/performance_counters.h"
 #include <atomic>
 #include <cstdint>
+#include <mutex>
 
 namespace OCLRT {
 class Buffer;
@@ -341,6 +343,17 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
 
     MOCKABLE_VIRTUAL void releaseIndirectHeap(IndirectHeap::Type heapType);
 
+    // Queue owned command stream and heaps used when commands are recorded outside of
+    // the command stream receiver lock (EnableQueueLocalRecording)
+    LinearStream &getRecordingCS(size_t minRequiredSize);
+    IndirectHeap &getRecordingHeap(IndirectHeap::Type heapType,
+                                   size_t minRequiredSize);
+    LinearStream &spliceRecordedCommands(size_t &commandStreamStart);
+
+    bool isRecordingLocally() const {
+        return recordingLocally;
+    }
+
     cl_command_queue_properties getCommandQueueProperties() const {
         return commandQueueProperties;
     }
@@ -383,6 +396,10 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
         return throttle;
     }
 
+    WaitStrategy getWaitStrategy() const {
+        return waitStrategy;
+    }
+
     void enqueueBlockedMapUnmapOperation(const cl_event *eventWaitList,
                                          size_t numEventsInWaitlist,
                                          MapOperationType opType,
@@ -428,6 +445,7 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
 
     QueuePriority priority;
     QueueThrottle throttle;
+    WaitStrategy waitStrategy = WaitStrategy::Yield;
 
     bool perfCountersEnabled;
     cl_uint perfCountersConfig;
@@ -438,6 +456,12 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
 
     LinearStream *commandStream;
 
+    // serializes enqueues of this queue when commands are recorded without the command stream receiver lock
+    std::mutex recordingMutex;
+    LinearStream *recordingCommandStream = nullptr;
+    IndirectHeap *recordingHeaps[IndirectHeap::NUM_TYPES] = {};
+    bool recordingLocally = false;
+
     bool mapDcFlushRequired = false;
     bool isSpecialCommandQueue = false;
 
@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/csr_dependencies.h"
 #include "runtime/command_queue/command_queue.h"
 #include "runtime/mem_obj/mem_obj.h"
 #include "runtime/memory_manager/graphics_allocation.h"
@@ -29,6 +30,7 @@
 #include "runtime/helpers/dispatch_info.h"
 #include "runtime/command_stream/preemption.h"
 #include "runtime/helpers/queue_helpers.h"
+#include "runtime/helpers/memory_access_set.h"
 #include <memory>
 
 namespace OCLRT {
@@ -348,8 +350,10 @@ class CommandQueueHw : public CommandQueue {
     size_t calculateHostPtrSizeForImage(size_t *region, size_t rowPitch, size_t slicePitch, Image *image);
 
   private:
-    bool isTaskLevelUpdateRequired(const uint32_t &taskLevel, const cl_event *eventWaitList, const cl_uint &numEventsInWaitList, unsigned int commandType);
+    bool isTaskLevelUpdateRequired(const uint32_t &taskLevel, const cl_event *eventWaitList, const cl_uint &numEventsInWaitList, unsigned int commandType, MemoryAccessSet *accessSet);
+    bool isDependencyHazardPresent(MemoryAccessSet &accessSet, cl_uint numEventsInWaitList, const cl_event *eventWaitList);
     void obtainTaskLevelAndBlockedStatus(unsigned int &taskLevel, cl_uint &numEventsInWaitList, const cl_event *&eventWaitList, bool &blockQueue, unsigned int commandType) override;
+    void obtainTaskLevelAndBlockedStatus(unsigned int &taskLevel, cl_uint &numEventsInWaitList, const cl_event *&eventWaitList, bool &blockQueue, unsigned int commandType, MemoryAccessSet *accessSet, CsrDependencies *csrDependencies);
     void forceDispatchScheduler(OCLRT::MultiDispatchInfo &multiDispatchInfo);
     static void computeOffsetsValueForRectCommands(size_t *bufferOffset,
                                                    size_t *hostOffset,
@@ -58,7 +58,7 @@ void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferPropertie
     }
 
     if (eventsRequest.outEvent) {
-        eventBuilder.create<Event>(this, transferProperties.cmdType, Event::eventNotReady, Event::eventNotReady);
+        eventBuilder.createPooledEvent(this, transferProperties.cmdType, Event::eventNotReady, Event::eventNotReady);
         outEventObj = eventBuilder.getEvent();
         outEventObj->setQueueTimeStamp();
         outEventObj->setCPUProfilingPath(true);
@@ -31,6 +31,7 @@
 #include "runtime/event/event_builder.h"
 #include "runtime/gtpin/gtpin_notify.h"
 #include "runtime/helpers/array_count.h"
+#include "runtime/helpers/dispatch_geometry_cache.h"
 #include "runtime/helpers/dispatch_info_builder.h"
 #include "runtime/helpers/kernel_commands.h"
 #include "runtime/helpers/options.h"
@@ -42,7 +43,9 @@
 #include "runtime/program/printf_handler.h"
 #include "runtime/program/block_kernel_manager.h"
 #include "runtime/utilities/range.h"
+#include "runtime/utilities/stackvec.h"
 #include "runtime/utilities/tag_allocator.h"
+#include <algorithm>
 #include <memory>
 #include <new>
 
@@ -94,10 +97,15 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface *(&surfaces)[surfaceCount
             }
 
             if (kernel->getKernelInfo().builtinDispatchBuilder == nullptr) {
-                DispatchInfoBuilder<SplitDispatch::Dim::d3D, SplitDispatch::SplitMode::WalkerSplit> builder;
-                builder.setDispatchGeometry(workDim, workItems, localWorkSizesIn, globalOffsets);
-                builder.setKernel(kernel);
-                builder.bake(multiDispatchInfo);
+                auto &geometryCache = kernel->getDispatchGeometryCache();
+                if (!geometryCache.restore(*kernel, workDim, workItems, localWorkSizesIn, globalOffsets, multiDispatchInfo)) {
+                    auto firstDispatch = multiDispatchInfo.size();
+                    DispatchInfoBuilder<SplitDispatch::Dim::d3D, SplitDispatch::SplitMode::WalkerSplit> builder;
+                    builder.setDispatchGeometry(workDim, workItems, localWorkSizesIn, globalOffsets);
+                    builder.setKernel(kernel);
+                    builder.bake(multiDispatchInfo);
+                    geometryCache.store(*kernel, workDim, workItems, localWorkSizesIn, globalOffsets, multiDispatchInfo, firstDispatch);
+                }
             } else {
                 auto builder = kernel->getKernelInfo().builtinDispatchBuilder;
                 builder->buildDispatchInfos(multiDispatchInfo, kernel, workDim, workItems, localWorkSizesIn, globalOffsets);
@@ -171,6 +179,19 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
     HwTimeStamps *hwTimeStamps = nullptr;
     auto &commandStreamReceiver = device->getCommandStreamReceiver();
+
+    auto queueLocalRecording = DebugManager.flags.EnableQueueLocalRecording.get();
+    std::unique_lock<std::mutex> recordingLock(recordingMutex, std::defer_lock);
+    if (queueLocalRecording) {
+        // all enqueues of this queue are serialized here, so queue owned storage may be recorded without the csr lock
+        recordingLock.lock();
+        queueLocalRecording = !parentKernel &&
+                              !isCommandWithoutKernel(commandType) &&
+                              !DebugManager.flags.AUBDumpSubCaptureMode.get() &&
+                              !DebugManager.flags.AddPatchInfoCommentsForAUBDump.get() &&
+                              !multiDispatchInfo.peekMainKernel()->getProgram()->isKernelDebugEnabled();
+    }
+
     auto commandStreamRecieverOwnership = commandStreamReceiver.obtainUniqueOwnership();
 
     TimeStampData queueTimeStamp;
@@ -180,7 +201,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
     EventBuilder eventBuilder;
     if (event) {
-        eventBuilder.create<Event>(this, commandType, Event::eventNotReady, 0);
+        eventBuilder.createPooledEvent(this, commandType, Event::eventNotReady, 0);
         *event = eventBuilder.getEvent();
         if (eventBuilder.getEvent()->isProfilingEnabled()) {
             eventBuilder.getEvent()->setQueueTimeStamp(&queueTimeStamp);
@@ -202,12 +223,57 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
     auto preemption = PreemptionHelper::taskPreemptionMode(*device, multiDispatchInfo);
     TakeOwnershipWrapper<CommandQueueHw<GfxFamily>> queueOwnership(*this);
 
+    std::unique_ptr<MemoryAccessSet> accessSet;
+    if (DebugManager.flags.EnableOOQHazardTracking.get() && isOOQEnabled() && !isCommandWithoutKernel(commandType)) {
+        accessSet = std::make_unique<MemoryAccessSet>();
+        Kernel *kernel = nullptr;
+        for (auto &dispatchInfo : multiDispatchInfo) {
+            if (kernel != dispatchInfo.getKernel()) {
+                kernel = dispatchInfo.getKernel();
+                kernel->getMemoryAccessSet(*accessSet);
+            }
+        }
+    }
+
     auto blockQueue = false;
     auto taskLevel = 0u;
-    obtainTaskLevelAndBlockedStatus(taskLevel, numEventsInWaitList, eventWaitList, blockQueue, commandType);
+    CsrDependencies csrDependencies;
+    auto trackCsrDependencies = DebugManager.flags.EnableCsrDependencyTracking.get();
+    obtainTaskLevelAndBlockedStatus(taskLevel, numEventsInWaitList, eventWaitList, blockQueue, commandType, accessSet.get(), trackCsrDependencies ? &csrDependencies : nullptr);
 
-    auto &commandStream = getCommandStream<GfxFamily, commandType>(*this, profilingRequired, perfCountersRequired, multiDispatchInfo);
-    auto commandStreamStart = commandStream.getUsed();
+    if (accessSet && eventBuilder.getEvent()) {
+        eventBuilder.getEvent()->setMemoryAccessSet(std::move(accessSet));
+    }
+    if (trackCsrDependencies && eventBuilder.getEvent()) {
+        eventBuilder.getEvent()->setCsrDependencies(csrDependencies);
+    }
+
+    LinearStream *commandStream = nullptr;
+    size_t commandStreamStart = 0;
+    StackVec<Kernel *, 4> recordedKernels;
+    if (queueLocalRecording && !blockQueue) {
+        // task level is already assigned, locks are taken again only to splice the recorded commands and flush the task
+        commandStream = &getRecordingCS(getCommandStreamSize<GfxFamily, commandType>(*this, profilingRequired, perfCountersRequired, multiDispatchInfo));
+        recordingLocally = true;
+        queueOwnership.unlock();
+        commandStreamRecieverOwnership.unlock();
+
+        // cross thread data is patched in place, so other queues must not record the same kernels meanwhile;
+        // taken in address order and only after the csr lock is released to keep the lock order deadlock free
+        for (auto &dispatchInfo : multiDispatchInfo) {
+            auto kernel = dispatchInfo.getKernel();
+            if (kernel && std::find(recordedKernels.begin(), recordedKernels.end(), kernel) == recordedKernels.end()) {
+                recordedKernels.push_back(kernel);
+            }
+        }
+        std::sort(recordedKernels.begin(), recordedKernels.end());
+        for (auto kernel : recordedKernels) {
+            kernel->takeOwnership(true);
+        }
+    } else {
+        commandStream = &getCommandStream<GfxFamily, commandType>(*this, profilingRequired, perfCountersRequired, multiDispatchInfo);
+        commandStreamStart = commandStream->getUsed();
+    }
 
     DBG_LOG(EventsDebugEnable, "blockQueue", blockQueue, "virtualEvent", virtualEvent, "taskLevel", taskLevel);
 
@@ -284,6 +350,16 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             blockQueue,
             commandType);
 
+        if (recordingLocally) {
+            for (auto kernel : recordedKernels) {
+                kernel->releaseOwnership();
+            }
+            recordedKernels.clear();
+            commandStreamRecieverOwnership.lock();
+            queueOwnership.lock();
+            commandStream = &spliceRecordedCommands(commandStreamStart);
+        }
+
         if (DebugManager.flags.AddPatchInfoCommentsForAUBDump.get()) {
             for (auto &dispatchInfo : multiDispatchInfo) {
                 for (auto &patchInfoData : dispatchInfo.getKernel()->getPatchInfoDataList()) {
@@ -348,7 +424,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             completionStamp = enqueueNonBlocked<commandType>(
                 surfacesForResidency,
                 numSurfaceForResidency,
-                commandStream,
+                *commandStream,
                 commandStreamStart,
                 blocking,
                 multiDispatchInfo,
@@ -356,6 +432,7 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
                 taskLevel,
                 slmUsed,
                 printfHandler.get());
+            recordingLocally = false;
 
             if (eventBuilder.getEvent()) {
                 eventBuilder.getEvent()->flushStamp->replaceStampObject(this->flushStamp->getStampReference());
@@ -437,6 +514,9 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
     queueOwnership.unlock();
     commandStreamRecieverOwnership.unlock();
+    if (recordingLock.owns_lock()) {
+        recordingLock.unlock();
+    }
 
     if (blocking) {
         if (blockQueue) {
@@ -455,11 +535,35 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
 
 template <typename GfxFamily>
 void CommandQueueHw<GfxFamily>::obtainTaskLevelAndBlockedStatus(unsigned int &taskLevel, cl_uint &numEventsInWaitList, const cl_event *&eventWaitList, bool &blockQueue, unsigned int commandType) {
+    obtainTaskLevelAndBlockedStatus(taskLevel, numEventsInWaitList, eventWaitList, blockQueue, commandType, nullptr, nullptr);
+}
+
+template <typename GfxFamily>
+void CommandQueueHw<GfxFamily>::obtainTaskLevelAndBlockedStatus(unsigned int &taskLevel, cl_uint &numEventsInWaitList, const cl_event *&eventWaitList, bool &blockQueue, unsigned int commandType, MemoryAccessSet *accessSet, CsrDependencies *csrDependencies) {
     auto isQueueBlockedStatus = isQueueBlocked();
     taskLevel = getTaskLevelFromWaitList(this->taskLevel, numEventsInWaitList, eventWaitList);
     blockQueue = (taskLevel == Event::eventNotReady) || isQueueBlockedStatus;
 
-    auto updateTaskLevel = isTaskLevelUpdateRequired(taskLevel, eventWaitList, numEventsInWaitList, commandType);
+    auto numPendingEvents = numEventsInWaitList;
+    auto pendingEventWaitList = eventWaitList;
+    StackVec<cl_event, 16> pendingEvents;
+    if (csrDependencies && !blockQueue) {
+        //events already completed on their csr impose no ordering, their task levels are not inherited
+        for (auto eventId = 0u; eventId < numEventsInWaitList; eventId++) {
+            auto event = castToObjectOrAbort<Event>(eventWaitList[eventId]);
+            event->collectCsrDependencies(*csrDependencies);
+            if (!event->isCompletedOnCsr()) {
+                pendingEvents.push_back(eventWaitList[eventId]);
+            }
+        }
+        csrDependencies->removeSatisfied();
+
+        numPendingEvents = static_cast<cl_uint>(pendingEvents.size());
+        pendingEventWaitList = (numPendingEvents > 0) ? &pendingEvents[0] : nullptr;
+        taskLevel = getTaskLevelFromWaitList(this->taskLevel, numPendingEvents, pendingEventWaitList);
+    }
+
+    auto updateTaskLevel = isTaskLevelUpdateRequired(taskLevel, pendingEventWaitList, numPendingEvents, commandType, accessSet);
     if (updateTaskLevel) {
         taskLevel++;
         this->taskLevel = taskLevel;
@@ -467,7 +571,7 @@ void CommandQueueHw<GfxFamily>::obtainTaskLevelAndBlockedStatus(unsigned int &ta
 }
 
 template <typename GfxFamily>
-bool CommandQueueHw<GfxFamily>::isTaskLevelUpdateRequired(const uint32_t &taskLevel, const cl_event *eventWaitList, const cl_uint &numEventsInWaitList, unsigned int commandType) {
+bool CommandQueueHw<GfxFamily>::isTaskLevelUpdateRequired(const uint32_t &taskLevel, const cl_event *eventWaitList, const cl_uint &numEventsInWaitList, unsigned int commandType, MemoryAccessSet *accessSet) {
     bool updateTaskLevel = true;
     //if we are blocked by user event then no update
     if (taskLevel == Event::eventNotReady) {
@@ -490,12 +594,46 @@ bool CommandQueueHw<GfxFamily>::isTaskLevelUpdateRequired(const uint32_t &taskLe
             taskLevelFromEvents++;
             if (taskLevelFromEvents <= this->taskLevel) {
                 updateTaskLevel = false;
+            } else if (updateTaskLevel && accessSet && !isDependencyHazardPresent(*accessSet, numEventsInWaitList, eventWaitList)) {
+                //dependencies do not touch memory of this enqueue, walkers may overlap without a stall
+                updateTaskLevel = false;
             }
         }
     }
     return updateTaskLevel;
 }
 
+template <typename GfxFamily>
+bool CommandQueueHw<GfxFamily>::isDependencyHazardPresent(MemoryAccessSet &accessSet, cl_uint numEventsInWaitList, const cl_event *eventWaitList) {
+    auto completedTaskCount = *device->getCommandStreamReceiver().getTagAddress();
+    std::vector<const MemoryAccessSet *> runningDependencies;
+
+    for (auto eventId = 0u; eventId < numEventsInWaitList; eventId++) {
+        auto event = castToObjectOrAbort<Event>(eventWaitList[eventId]);
+        //user events left in wait list are already complete, otherwise the queue is blocked
+        if (event->isUserEvent()) {
+            continue;
+        }
+        auto dependencyAccessSet = event->peekMemoryAccessSet();
+        if (event->getCommandQueue() != this || dependencyAccessSet == nullptr) {
+            return true;
+        }
+        if (event->peekTaskCount() <= completedTaskCount) {
+            continue;
+        }
+        if (accessSet.conflictsWith(*dependencyAccessSet)) {
+            return true;
+        }
+        runningDependencies.push_back(dependencyAccessSet);
+    }
+
+    //successors of this enqueue have to observe accesses of dependencies it does not wait for
+    for (auto dependencyAccessSet : runningDependencies) {
+        accessSet.merge(*dependencyAccessSet);
+    }
+    return false;
+}
+
 template <typename GfxFamily>
 template <uint32_t commandType>
 CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
@@ -566,10 +704,14 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
         // In ExecutionModel IOH is the same as DSH to eliminate StateBaseAddress reprogramming for scheduler kernel and blocks.
         ioh = dsh;
         implicitFlush = true;
+    } else if (recordingLocally) {
+        dsh = &getRecordingHeap(IndirectHeap::DYNAMIC_STATE, 0u);
+        ioh = &getRecordingHeap(IndirectHeap::INDIRECT_OBJECT, 0u);
     } else {
         dsh = &getIndirectHeap(IndirectHeap::DYNAMIC_STATE, 0u);
         ioh = &getIndirectHeap(IndirectHeap::INDIRECT_OBJECT, 0u);
     }
+    IndirectHeap *ssh = recordingLocally ? &getRecordingHeap(IndirectHeap::SURFACE_STATE, 0u) : &getIndirectHeap(IndirectHeap::SURFACE_STATE, 0u);
 
     commandStreamReceiver.requestThreadArbitrationPolicy(multiDispatchInfo.peekMainKernel()->getThreadArbitrationPolicy<GfxFamily>());
 
@@ -585,7 +727,8 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
     dispatchFlags.implicitFlush = implicitFlush;
     dispatchFlags.flushStampReference = this->flushStamp->getStampReference();
     dispatchFlags.preemptionMode = PreemptionHelper::taskPreemptionMode(*device, multiDispatchInfo);
-    dispatchFlags.outOfOrderExecutionAllowed = !eventBuilder.getEvent() || commandStreamReceiver.isNTo1SubmissionModelEnabled();
+    dispatchFlags.outOfOrderExecutionAllowed = !eventBuilder.getEvent() || commandStreamReceiver.isNTo1SubmissionModelEnabled() ||
+                                               (isOOQEnabled() && DebugManager.flags.EnableOOQHazardTracking.get());
 
     DEBUG_BREAK_IF(taskLevel >= Event::eventNotReady);
 
@@ -598,7 +741,7 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
         commandStreamStart,
         *dsh,
         *ioh,
-        getIndirectHeap(IndirectHeap::SURFACE_STATE, 0u),
+        *ssh,
         taskLevel,
         dispatchFlags,
         *device);
@@ -26,6 +26,8 @@
 #include "runtime/command_queue/command_queue_hw.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/command_queue/gpgpu_walker.h"
+#include "runtime/command_queue/lws_autotuner.h"
+#include "runtime/event/event.h"
 #include "runtime/helpers/kernel_commands.h"
 #include "runtime/helpers/task_information.h"
 #include "runtime/mem_obj/buffer.h"
@@ -135,6 +137,24 @@ cl_int CommandQueueHw<GfxFamily>::enqueueKernel(
         return CL_INVALID_WORK_GROUP_SIZE;
     }
 
+    auto lwsAutotuner = device->getLwsAutotuner();
+    LwsAutotuner::Key tuningKey = {0, 0, {0, 0, 0}};
+    uint32_t tuningCandidate = LwsAutotuner::noCandidate;
+    cl_event tuningEvent = nullptr;
+    if (lwsAutotuner && localWkgSizeToPass == nullptr && !kernel.isParentKernel && kernelInfo.builtinDispatchBuilder == nullptr) {
+        // samples are timed with event profiling data, an internal event needs the async handler to complete it
+        bool canMeasure = isProfilingEnabled() && (event != nullptr || DebugManager.flags.EnableAsyncEventsHandler.get());
+        tuningKey = {kernel.getIsaHash(), workDim, Vec3<size_t>(region)};
+        DispatchInfo dispatchInfo(&kernel, workDim, Vec3<size_t>(region), Vec3<size_t>(0, 0, 0), Vec3<size_t>(globalWorkOffset));
+        Vec3<size_t> tunedWorkGroupSize = {0, 0, 0};
+        if (lwsAutotuner->selectWorkgroupSize(tuningKey, dispatchInfo, canMeasure, tunedWorkGroupSize, tuningCandidate)) {
+            workGroupSize[0] = tunedWorkGroupSize.x;
+            workGroupSize[1] = tunedWorkGroupSize.y;
+            workGroupSize[2] = tunedWorkGroupSize.z;
+            localWkgSizeToPass = workGroupSize;
+        }
+    }
+
     enqueueHandler<CL_COMMAND_NDRANGE_KERNEL>(
         surfaces,
         false,
@@ -145,7 +165,15 @@ cl_int CommandQueueHw<GfxFamily>::enqueueKernel(
         localWkgSizeToPass,
         numEventsInWaitList,
         eventWaitList,
-        event);
+        (tuningCandidate != LwsAutotuner::noCandidate && event == nullptr) ? &tuningEvent : event);
+
+    if (tuningCandidate != LwsAutotuner::noCandidate) {
+        auto sampledEvent = castToObjectOrAbort<Event>(event ? *event : tuningEvent);
+        lwsAutotuner->trackSample(*device, *sampledEvent, tuningKey, tuningCandidate);
+        if (tuningEvent) {
+            sampledEvent->release();
+        }
+    }
 
     return CL_SUCCESS;
 }
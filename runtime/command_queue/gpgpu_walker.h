@@ -240,7 +240,7 @@ LinearStream &getCommandStream(CommandQueue &commandQueue, bool reserveProfiling
 }
 
 template <typename GfxFamily, uint32_t eventType>
-LinearStream &getCommandStream(CommandQueue &commandQueue, bool reserveProfilingCmdsSpace, bool reservePerfCounterCmdsSpace, const MultiDispatchInfo &multiDispatchInfo) {
+size_t getCommandStreamSize(CommandQueue &commandQueue, bool reserveProfilingCmdsSpace, bool reservePerfCounterCmdsSpace, const MultiDispatchInfo &multiDispatchInfo) {
     size_t expectedSizeCS = 0;
     Kernel *parentKernel = multiDispatchInfo.peekParentKernel();
     for (auto &dispatchInfo : multiDispatchInfo) {
@@ -253,6 +253,12 @@ LinearStream &getCommandStream(CommandQueue &commandQueue, bool reserveProfiling
     if (DebugManager.flags.EnableTimestampPacket.get()) {
         expectedSizeCS += 2 * sizeof(typename GfxFamily::PIPE_CONTROL);
     }
+    return expectedSizeCS;
+}
+
+template <typename GfxFamily, uint32_t eventType>
+LinearStream &getCommandStream(CommandQueue &commandQueue, bool reserveProfilingCmdsSpace, bool reservePerfCounterCmdsSpace, const MultiDispatchInfo &multiDispatchInfo) {
+    auto expectedSizeCS = getCommandStreamSize<GfxFamily, eventType>(commandQueue, reserveProfilingCmdsSpace, reservePerfCounterCmdsSpace, multiDispatchInfo);
     return commandQueue.getCS(expectedSizeCS);
 }
 
@@ -481,6 +481,13 @@ void GpgpuWalkerHelper<GfxFamily>::dispatchWalker(
         if (parentKernel) {
             (*blockedCommandsData)->doNotFreeISH = true;
         }
+    } else if (commandQueue.isRecordingLocally()) {
+        using KCH = KernelCommandsHelper<GfxFamily>;
+        DEBUG_BREAK_IF(parentKernel != nullptr);
+        commandStream = &commandQueue.getRecordingCS(0);
+        dsh = &commandQueue.getRecordingHeap(IndirectHeap::DYNAMIC_STATE, KCH::getTotalSizeRequiredDSH(multiDispatchInfo));
+        ioh = &commandQueue.getRecordingHeap(IndirectHeap::INDIRECT_OBJECT, KCH::getTotalSizeRequiredIOH(multiDispatchInfo));
+        ssh = &commandQueue.getRecordingHeap(IndirectHeap::SURFACE_STATE, KCH::getTotalSizeRequiredSSH(multiDispatchInfo));
     } else {
         commandStream = &commandQueue.getCS(0);
         if (parentKernel && (commandQueue.getIndirectHeap(IndirectHeap::SURFACE_STATE, 0).getUsed() > 0)) {
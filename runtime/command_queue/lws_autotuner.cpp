@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/lws_autotuner.h"
+#include "runtime/command_queue/gpgpu_walker.h"
+#include "runtime/device/device.h"
+#include "runtime/event/event.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/dispatch_info.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/program/kernel_info.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <tuple>
+
+namespace OCLRT {
+const char *const LwsAutotuner::resultsFileExtension = ".lws_cache";
+std::mutex LwsAutotuner::fileAccessMtx;
+
+namespace {
+struct TrackedSample {
+    Device *device;
+    LwsAutotuner *autotuner;
+    LwsAutotuner::Key key;
+    uint32_t candidate;
+};
+
+size_t largestDivisor(size_t value, size_t limit) {
+    for (size_t divisor = std::min(value, limit); divisor > 1; divisor--) {
+        if (value % divisor == 0) {
+            return divisor;
+        }
+    }
+    return 1;
+}
+} // namespace
+
+bool LwsAutotuner::Key::operator<(const Key &other) const {
+    return std::tie(kernelHash, workDim, gws.x, gws.y, gws.z) <
+           std::tie(other.kernelHash, other.workDim, other.gws.x, other.gws.y, other.gws.z);
+}
+
+LwsAutotuner::LwsAutotuner(const std::string &resultsFileName, uint32_t maxCandidates, uint32_t samplesPerCandidate)
+    : resultsFileName(resultsFileName), maxCandidates(std::max(maxCandidates, 1u)), samplesPerCandidate(std::max(samplesPerCandidate, 1u)) {
+}
+
+bool LwsAutotuner::isValidWorkgroupSize(const Vec3<size_t> &lws, const Vec3<size_t> &gws, uint32_t workDim,
+                                        size_t maxWorkGroupSize, bool allowNonUniform) {
+    const size_t workGroupSize[3] = {lws.x, lws.y, lws.z};
+    const size_t globalWorkSize[3] = {gws.x, gws.y, gws.z};
+    size_t totalWorkItems = 1;
+    for (uint32_t i = 0; i < 3; i++) {
+        if (workGroupSize[i] == 0) {
+            return false;
+        }
+        if (i >= workDim) {
+            if (workGroupSize[i] != 1) {
+                return false;
+            }
+            continue;
+        }
+        if (workGroupSize[i] > globalWorkSize[i] || (!allowNonUniform && globalWorkSize[i] % workGroupSize[i] != 0)) {
+            return false;
+        }
+        if (workGroupSize[i] > maxWorkGroupSize / totalWorkItems) {
+            return false;
+        }
+        totalWorkItems *= workGroupSize[i];
+    }
+    return true;
+}
+
+std::vector<Vec3<size_t>> LwsAutotuner::generateCandidates(const Vec3<size_t> &heuristicLws, const Vec3<size_t> &gws, uint32_t workDim,
+                                                            const WorkSizeInfo &wsInfo, uint32_t maxCandidates) {
+    std::vector<Vec3<size_t>> candidates;
+    auto addCandidate = [&](const Vec3<size_t> &lws) {
+        if (candidates.size() < maxCandidates && std::find(candidates.begin(), candidates.end(), lws) == candidates.end()) {
+            candidates.push_back(lws);
+        }
+    };
+    addCandidate(heuristicLws);
+
+    // power of two sizes along x, the rest of the work group budget goes to y and z
+    for (size_t x = Math::prevPowerOfTwo(wsInfo.maxWorkGroupSize); x >= 1; x /= 2) {
+        if (gws.x % x != 0) {
+            continue;
+        }
+        Vec3<size_t> lws(x, 1, 1);
+        if (workDim > 1) {
+            lws.y = largestDivisor(gws.y, wsInfo.maxWorkGroupSize / lws.x);
+        }
+        if (workDim > 2) {
+            lws.z = largestDivisor(gws.z, wsInfo.maxWorkGroupSize / (lws.x * lws.y));
+        }
+        auto totalSize = lws.x * lws.y * lws.z;
+        if (totalSize < wsInfo.simdSize || totalSize < wsInfo.minWorkGroupSize) {
+            continue;
+        }
+        addCandidate(lws);
+    }
+    return candidates;
+}
+
+bool LwsAutotuner::selectWorkgroupSize(const Key &key, const DispatchInfo &dispatchInfo, bool canMeasure, Vec3<size_t> &lws, uint32_t &candidate) {
+    candidate = noCandidate;
+
+    // the enqueue has already checked the work sizes, so whatever is returned must pass the same checks
+    auto kernel = dispatchInfo.getKernel();
+    WorkSizeInfo wsInfo(dispatchInfo);
+    size_t maxWorkGroupSize = kernel->getMaxKernelWorkGroupSize();
+    if (wsInfo.numThreadsPerSubSlice > 0) {
+        maxWorkGroupSize = std::min(maxWorkGroupSize, static_cast<size_t>(wsInfo.numThreadsPerSubSlice) * wsInfo.simdSize);
+    }
+    wsInfo.maxWorkGroupSize = static_cast<uint32_t>(std::min(maxWorkGroupSize, static_cast<size_t>(wsInfo.maxWorkGroupSize)));
+    bool allowNonUniform = kernel->getAllowNonUniform();
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        if (!canMeasure) {
+            return false;
+        }
+        Entry entry;
+        auto heuristicLws = canonizeWorkgroup(computeWorkgroupSize(dispatchInfo));
+        for (auto &candidateLws : generateCandidates(heuristicLws, key.gws, key.workDim, wsInfo, maxCandidates)) {
+            if (isValidWorkgroupSize(candidateLws, key.gws, key.workDim, wsInfo.maxWorkGroupSize, allowNonUniform)) {
+                entry.candidates.push_back({candidateLws, 0u, 0u, 0u});
+            }
+        }
+        it = entries.emplace(key, std::move(entry)).first;
+    }
+
+    auto &entry = it->second;
+    if (entry.decided) {
+        if (!isValidWorkgroupSize(entry.selectedLws, key.gws, key.workDim, wsInfo.maxWorkGroupSize, allowNonUniform)) {
+            // loaded from a results file written for other limits, fall back to the heuristic and tune again
+            entries.erase(it);
+            return false;
+        }
+        lws = entry.selectedLws;
+        return true;
+    }
+    if (!canMeasure) {
+        return false;
+    }
+
+    // spread samples evenly across candidates; once all are in flight keep using the heuristic
+    auto next = std::min_element(entry.candidates.begin(), entry.candidates.end(),
+                                 [](const Candidate &lhs, const Candidate &rhs) { return lhs.issued < rhs.issued; });
+    if (next == entry.candidates.end() || next->issued >= samplesPerCandidate) {
+        return false;
+    }
+    next->issued++;
+    candidate = static_cast<uint32_t>(next - entry.candidates.begin());
+    lws = next->lws;
+    return true;
+}
+
+void LwsAutotuner::trackSample(Device &device, Event &event, const Key &key, uint32_t candidate) {
+    device.incRefInternal();
+    event.addCallback(&LwsAutotuner::onSampleCompleted, CL_COMPLETE, new TrackedSample{&device, this, key, candidate});
+}
+
+void CL_CALLBACK LwsAutotuner::onSampleCompleted(cl_event event, cl_int status, void *data) {
+    std::unique_ptr<TrackedSample> sample(static_cast<TrackedSample *>(data));
+    auto pEvent = castToObjectOrAbort<Event>(event);
+
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    bool completed = (status == CL_COMPLETE) &&
+                     (pEvent->getEventProfilingInfo(CL_PROFILING_COMMAND_START, sizeof(start), &start, nullptr) == CL_SUCCESS) &&
+                     (pEvent->getEventProfilingInfo(CL_PROFILING_COMMAND_END, sizeof(end), &end, nullptr) == CL_SUCCESS) &&
+                     (end >= start);
+
+    sample->autotuner->reportSample(sample->key, sample->candidate, completed, end - start);
+    sample->device->decRefInternal();
+}
+
+void LwsAutotuner::reportSample(const Key &key, uint32_t candidate, bool completed, uint64_t duration) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second.decided || candidate >= it->second.candidates.size()) {
+        return;
+    }
+    auto &entry = it->second;
+    auto &sampled = entry.candidates[candidate];
+    if (!completed) {
+        // not measurable, let a later enqueue retry this candidate
+        DEBUG_BREAK_IF(sampled.issued == 0);
+        sampled.issued--;
+        return;
+    }
+    sampled.bestDuration = (sampled.completed == 0) ? duration : std::min(sampled.bestDuration, duration);
+    sampled.completed++;
+
+    for (auto &other : entry.candidates) {
+        if (other.completed < samplesPerCandidate) {
+            return;
+        }
+    }
+    auto fastest = std::min_element(entry.candidates.begin(), entry.candidates.end(),
+                                    [](const Candidate &lhs, const Candidate &rhs) { return lhs.bestDuration < rhs.bestDuration; });
+    entry.selectedLws = fastest->lws;
+    entry.decided = true;
+    entry.candidates.clear();
+    DBG_LOG(PrintLWSSizes, "Autotuned LWS for GWS", key.gws.x, key.gws.y, key.gws.z,
+            ":", entry.selectedLws.x, entry.selectedLws.y, entry.selectedLws.z);
+
+    writeResults();
+}
+
+bool LwsAutotuner::loadResults() {
+    if (resultsFileName.empty()) {
+        return false;
+    }
+    void *pData = nullptr;
+    size_t dataSize = 0;
+    {
+        std::lock_guard<std::mutex> lock(fileAccessMtx);
+        dataSize = loadDataFromFile(resultsFileName.c_str(), pData);
+    }
+    if (pData == nullptr || dataSize == 0) {
+        deleteDataReadFromFile(pData);
+        return false;
+    }
+    std::istringstream results(std::string(static_cast<const char *>(pData), dataSize));
+    deleteDataReadFromFile(pData);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    Key key = {0, 0, {0, 0, 0}};
+    Vec3<size_t> lws = {0, 0, 0};
+    while (results >> std::hex >> key.kernelHash >> std::dec >> key.workDim >> key.gws.x >> key.gws.y >> key.gws.z >> lws.x >> lws.y >> lws.z) {
+        // device limits are unknown here, entries exceeding them are dropped when selected
+        if (key.workDim == 0 || key.workDim > 3 ||
+            !isValidWorkgroupSize(lws, key.gws, key.workDim, std::numeric_limits<size_t>::max(), true)) {
+            continue;
+        }
+        auto &entry = entries[key];
+        entry.candidates.clear();
+        entry.selectedLws = lws;
+        entry.decided = true;
+    }
+    return true;
+}
+
+bool LwsAutotuner::saveResults() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return writeResults();
+}
+
+bool LwsAutotuner::writeResults() {
+    if (resultsFileName.empty()) {
+        return false;
+    }
+    std::ostringstream results;
+    for (auto &entry : entries) {
+        if (!entry.second.decided) {
+            continue;
+        }
+        auto &key = entry.first;
+        auto &lws = entry.second.selectedLws;
+        results << std::hex << key.kernelHash << std::dec << " " << key.workDim << " "
+                << key.gws.x << " " << key.gws.y << " " << key.gws.z << " "
+                << lws.x << " " << lws.y << " " << lws.z << "\n";
+    }
+    auto data = results.str();
+
+    std::lock_guard<std::mutex> lock(fileAccessMtx);
+    return writeDataToFile(resultsFileName.c_str(), data.c_str(), data.size()) == data.size();
+}
+} // namespace OCLRT
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/api/cl_types.h"
+#include "runtime/utilities/vec.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+class Device;
+class Event;
+class DispatchInfo;
+struct WorkSizeInfo;
+
+// Picks local work sizes for NULL-LWS enqueues by timing a few candidates and keeping the fastest
+class LwsAutotuner {
+  public:
+    static constexpr uint32_t noCandidate = static_cast<uint32_t>(-1);
+    static const char *const resultsFileExtension;
+
+    struct Key {
+        uint64_t kernelHash;
+        uint32_t workDim;
+        Vec3<size_t> gws;
+        bool operator<(const Key &other) const;
+    };
+
+    LwsAutotuner(const std::string &resultsFileName, uint32_t maxCandidates, uint32_t samplesPerCandidate);
+
+    bool selectWorkgroupSize(const Key &key, const DispatchInfo &dispatchInfo, bool canMeasure, Vec3<size_t> &lws, uint32_t &candidate);
+    void trackSample(Device &device, Event &event, const Key &key, uint32_t candidate);
+    void reportSample(const Key &key, uint32_t candidate, bool completed, uint64_t duration);
+
+    bool loadResults();
+    bool saveResults();
+
+    static bool isValidWorkgroupSize(const Vec3<size_t> &lws, const Vec3<size_t> &gws, uint32_t workDim,
+                                     size_t maxWorkGroupSize, bool allowNonUniform);
+    static std::vector<Vec3<size_t>> generateCandidates(const Vec3<size_t> &heuristicLws, const Vec3<size_t> &gws, uint32_t workDim,
+                                                         const WorkSizeInfo &wsInfo, uint32_t maxCandidates);
+
+  protected:
+    struct Candidate {
+        Vec3<size_t> lws;
+        uint32_t issued;
+        uint32_t completed;
+        uint64_t bestDuration;
+    };
+
+    struct Entry {
+        Entry() : selectedLws(0, 0, 0), decided(false) {}
+        std::vector<Candidate> candidates;
+        Vec3<size_t> selectedLws;
+        bool decided;
+    };
+
+    static void CL_CALLBACK onSampleCompleted(cl_event event, cl_int status, void *data);
+    bool writeResults();
+
+    std::string resultsFileName;
+    uint32_t maxCandidates;
+    uint32_t samplesPerCandidate;
+    std::map<Key, Entry> entries;
+    std::mutex mtx;
+    static std::mutex fileAccessMtx;
+};
+} // namespace OCLRT
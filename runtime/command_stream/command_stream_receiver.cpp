@@ -61,6 +61,7 @@ CommandStreamReceiver::~CommandStreamReceiver() {
         }
     }
     cleanupResources();
+    waitHistogram.print();
 }
 
 void CommandStreamReceiver::makeResident(GraphicsAllocation &gfxAllocation) {
@@ -212,9 +213,10 @@ void CommandStreamReceiver::cleanupResources() {
     }
 }
 
-bool CommandStreamReceiver::waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMicroseconds, uint32_t taskCountToWait) {
+bool CommandStreamReceiver::waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMicroseconds, uint32_t taskCountToWait, WaitStrategy waitStrategy) {
     std::chrono::high_resolution_clock::time_point time1, time2;
     int64_t timeDiff = 0;
+    uint32_t iteration = 0;
 
     uint32_t latestSentTaskCount = this->latestFlushedTaskCount;
     if (latestSentTaskCount < taskCountToWait) {
@@ -223,12 +225,16 @@ bool CommandStreamReceiver::waitForCompletionWithTimeout(bool enableTimeout, int
 
     time1 = std::chrono::high_resolution_clock::now();
     while (*getTagAddress() < taskCountToWait && timeDiff <= timeoutMicroseconds) {
-        std::this_thread::yield();
+        WaitStrategyHelper::waitStep(waitStrategy, iteration++);
         if (enableTimeout) {
             time2 = std::chrono::high_resolution_clock::now();
             timeDiff = std::chrono::duration_cast<std::chrono::microseconds>(time2 - time1).count();
         }
     }
+    if (iteration > 0) {
+        time2 = std::chrono::high_resolution_clock::now();
+        waitHistogram.record(waitStrategy, std::chrono::duration_cast<std::chrono::microseconds>(time2 - time1).count());
+    }
     if (*getTagAddress() >= taskCountToWait) {
         if (gtpinIsGTPinInitialized()) {
             gtpinNotifyTaskCompletion(taskCountToWait);
@@ -25,6 +25,7 @@
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/command_stream/submissions_aggregator.h"
 #include "runtime/command_stream/thread_arbitration_policy.h"
+#include "runtime/command_stream/wait_strategy.h"
 #include "runtime/helpers/address_patch.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/completion_stamp.h"
@@ -129,8 +130,9 @@ class CommandStreamReceiver {
 
     void requestThreadArbitrationPolicy(uint32_t requiredPolicy) { this->requiredThreadArbitrationPolicy = requiredPolicy; }
 
-    virtual void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool useQuickKmdSleep) = 0;
-    MOCKABLE_VIRTUAL bool waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMicroseconds, uint32_t taskCountToWait);
+    virtual void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool useQuickKmdSleep, WaitStrategy waitStrategy) = 0;
+    MOCKABLE_VIRTUAL bool waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMicroseconds, uint32_t taskCountToWait, WaitStrategy waitStrategy);
+    const WaitHistogram &getWaitHistogram() const { return waitHistogram; }
 
     void setSamplerCacheFlushRequired(SamplerCacheFlushState value) { this->samplerCacheFlushRequired = value; }
 
@@ -209,6 +211,7 @@ class CommandStreamReceiver {
     std::unique_ptr<ExperimentalCommandBuffer> experimentalCmdBuffer;
     MutexType ownershipMutex;
     std::unique_ptr<KmdNotifyHelper> kmdNotifyHelper;
+    WaitHistogram waitHistogram;
     ExecutionEnvironment &executionEnvironment;
 };
 
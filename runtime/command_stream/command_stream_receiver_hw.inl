@@ -45,6 +45,7 @@ CommandStreamReceiverHw<GfxFamily>::CommandStreamReceiverHw(const HardwareInfo &
     : CommandStreamReceiver(executionEnvironment, defaultHeapSize), hwInfo(hwInfoIn) {
     requiredThreadArbitrationPolicy = PreambleHelper<GfxFamily>::getDefaultThreadArbitrationPolicy();
     resetKmdNotifyHelper(new KmdNotifyHelper(&(hwInfoIn.capabilityTable.kmdNotifyProperties)));
+    kmdNotifyHelper->setAdaptiveTimeoutPercentile(DebugManager.flags.AdaptiveKmdNotifyTimeoutPercentile.get());
     flatBatchBufferHelper.reset(new FlatBatchBufferHelperHw<GfxFamily>(this->memoryManager));
 }
 
@@ -436,11 +437,14 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
         if (this->dispatchMode == DispatchMode::ImmediateDispatch) {
             flushStamp->setStamp(this->flush(batchBuffer, engineType, nullptr));
             this->latestFlushedTaskCount = this->taskCount + 1;
+            kmdNotifyHelper->notifyFlush(this->taskCount + 1);
             this->makeSurfacePackNonResident(nullptr);
         } else {
-            auto commandBuffer = new CommandBuffer(device);
+            auto commandBuffer = this->submissionAggregator->obtainCommandBuffer(device);
             commandBuffer->batchBuffer = batchBuffer;
-            commandBuffer->surfaces.swap(getMemoryManager()->getResidencyAllocations());
+            auto &residencyAllocations = getMemoryManager()->getResidencyAllocations();
+            commandBuffer->surfaces.assign(residencyAllocations.begin(), residencyAllocations.end());
+            residencyAllocations.clear();
             commandBuffer->batchBufferEndLocation = bbEndLocation;
             commandBuffer->taskCount = this->taskCount + 1;
             commandBuffer->flushStamp->replaceStampObject(dispatchFlags.flushStampReference);
@@ -513,6 +517,8 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
 
             FlushStampUpdateHelper flushStampUpdateHelper;
             flushStampUpdateHelper.insert(primaryCmdBuffer->flushStamp->getStampReference());
+            //merged buffers keep their flush stamps referenced until the stamps are updated
+            CommandBufferList mergedCmdBuffers;
 
             currentPipeControlForNooping = primaryCmdBuffer->pipeControlThatMayBeErasedLocation;
             epiloguePipeControlLocation = primaryCmdBuffer->epiloguePipeControlLocation;
@@ -544,7 +550,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
                 currentBBendLocation = nextCommandBuffer->batchBufferEndLocation;
                 lastTaskCount = nextCommandBuffer->taskCount;
                 nextCommandBuffer = nextCommandBuffer->next;
-                commandBufferList.removeFrontOne();
+                mergedCmdBuffers.pushTailOne(*commandBufferList.removeFrontOne().release());
             }
             surfacesForSubmit.reserve(resourcePackage.size() + 1);
             for (auto &surface : resourcePackage) {
@@ -563,9 +569,14 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
             flushStampUpdateHelper.updateAll(flushStamp);
 
             this->latestFlushedTaskCount = lastTaskCount;
+            kmdNotifyHelper->notifyFlush(lastTaskCount);
             this->flushStamp->setStamp(flushStamp);
             this->makeSurfacePackNonResident(&surfacesForSubmit);
             resourcePackage.clear();
+            this->submissionAggregator->recycleCommandBuffer(std::move(primaryCmdBuffer));
+            while (!mergedCmdBuffers.peekIsEmpty()) {
+                this->submissionAggregator->recycleCommandBuffer(mergedCmdBuffers.removeFrontOne());
+            }
         }
         this->totalMemoryUsed = 0;
     }
@@ -656,17 +667,19 @@ inline void CommandStreamReceiverHw<GfxFamily>::emitNoop(LinearStream &commandSt
 }
 
 template <typename GfxFamily>
-inline void CommandStreamReceiverHw<GfxFamily>::waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool useQuickKmdSleep) {
+inline void CommandStreamReceiverHw<GfxFamily>::waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool useQuickKmdSleep, WaitStrategy waitStrategy) {
     int64_t waitTimeout = 0;
-    bool enableTimeout = kmdNotifyHelper->obtainTimeoutParams(waitTimeout, useQuickKmdSleep, *getTagAddress(), taskCountToWait, flushStampToWait);
+    uint32_t taskCountAtWaitStart = *getTagAddress();
+    bool enableTimeout = kmdNotifyHelper->obtainTimeoutParams(waitTimeout, useQuickKmdSleep, taskCountAtWaitStart, taskCountToWait, flushStampToWait);
 
-    auto status = waitForCompletionWithTimeout(enableTimeout, waitTimeout, taskCountToWait);
+    auto status = waitForCompletionWithTimeout(enableTimeout, waitTimeout, taskCountToWait, waitStrategy);
     if (!status) {
         waitForFlushStamp(flushStampToWait);
         //now call blocking wait, this is to ensure that task count is reached
-        waitForCompletionWithTimeout(false, 0, taskCountToWait);
+        waitForCompletionWithTimeout(false, 0, taskCountToWait, waitStrategy);
     }
     UNRECOVERABLE_IF(*getTagAddress() < taskCountToWait);
+    kmdNotifyHelper->notifyCompletion(*getTagAddress(), taskCountAtWaitStart);
 
     if (kmdNotifyHelper->quickKmdSleepForSporadicWaitsEnabled()) {
         kmdNotifyHelper->updateLastWaitForCompletionTimestamp();
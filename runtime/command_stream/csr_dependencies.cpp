@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/csr_dependencies.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+
+void CsrDependencies::add(CommandStreamReceiver &csr, uint32_t taskCount) {
+    for (auto &entry : taskCounts) {
+        if (entry.csr == &csr) {
+            entry.taskCount = std::max(entry.taskCount, taskCount);
+            return;
+        }
+    }
+    taskCounts.push_back({&csr, taskCount});
+}
+
+void CsrDependencies::merge(const CsrDependencies &dependencies) {
+    for (auto &entry : dependencies) {
+        add(*entry.csr, entry.taskCount);
+    }
+}
+
+void CsrDependencies::removeSatisfied() {
+    size_t numPending = 0;
+    for (size_t i = 0; i < taskCounts.size(); i++) {
+        if (!isSatisfied(*taskCounts[i].csr, taskCounts[i].taskCount)) {
+            taskCounts[numPending++] = taskCounts[i];
+        }
+    }
+    taskCounts.resize(numPending);
+}
+
+uint32_t CsrDependencies::peekTaskCount(const CommandStreamReceiver &csr) const {
+    for (auto &entry : taskCounts) {
+        if (entry.csr == &csr) {
+            return entry.taskCount;
+        }
+    }
+    return 0;
+}
+
+bool CsrDependencies::isSatisfied(const CommandStreamReceiver &csr, uint32_t taskCount) {
+    return taskCount <= *csr.getTagAddress();
+}
+} // namespace OCLRT
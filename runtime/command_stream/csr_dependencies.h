@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/stackvec.h"
+#include <cstdint>
+
+namespace OCLRT {
+class CommandStreamReceiver;
+
+struct CsrTaskCount {
+    CommandStreamReceiver *csr;
+    uint32_t taskCount;
+};
+
+// vector clock of a command: highest task count it has to wait for on each command stream receiver
+class CsrDependencies {
+  public:
+    using Container = StackVec<CsrTaskCount, 4>;
+
+    void add(CommandStreamReceiver &csr, uint32_t taskCount);
+    void merge(const CsrDependencies &dependencies);
+    // drops entries whose task count is already reached by tag of their csr
+    void removeSatisfied();
+
+    // 0 when there is no dependency on given csr
+    uint32_t peekTaskCount(const CommandStreamReceiver &csr) const;
+    bool isCovering(const CommandStreamReceiver &csr, uint32_t taskCount) const {
+        return taskCount <= peekTaskCount(csr);
+    }
+
+    static bool isSatisfied(const CommandStreamReceiver &csr, uint32_t taskCount);
+
+    size_t size() const { return taskCounts.size(); }
+    bool empty() const { return taskCounts.size() == 0; }
+    Container::const_iterator begin() const { return taskCounts.begin(); }
+    Container::const_iterator end() const { return taskCounts.end(); }
+
+  protected:
+    Container taskCounts;
+};
+} // namespace OCLRT
@@ -107,6 +107,35 @@ void OCLRT::SubmissionAggregator::aggregateCommandBuffers(ResourcePackage &resou
     }
 }
 
+OCLRT::CommandBuffer *OCLRT::SubmissionAggregator::obtainCommandBuffer(Device &device) {
+    auto commandBuffer = this->freeCmdBuffers.removeFrontOne();
+    if (commandBuffer) {
+        this->numFreeCmdBuffers--;
+    }
+    if (commandBuffer && &commandBuffer->device == &device) {
+        return commandBuffer.release();
+    }
+    return new CommandBuffer(device);
+}
+
+void OCLRT::SubmissionAggregator::recycleCommandBuffer(std::unique_ptr<CommandBuffer> commandBuffer) {
+    // buffers beyond the bound are only needed by occasional large batches, do not keep them for the whole csr lifetime
+    if (this->numFreeCmdBuffers >= maxFreeCmdBuffers) {
+        return;
+    }
+    // surfaces keeps its capacity, so a reused buffer records residency without allocating
+    commandBuffer->surfaces.clear();
+    commandBuffer->batchBuffer = BatchBuffer();
+    commandBuffer->batchBufferEndLocation = nullptr;
+    commandBuffer->inspectionId = 0;
+    commandBuffer->taskCount = 0;
+    commandBuffer->pipeControlThatMayBeErasedLocation = nullptr;
+    commandBuffer->epiloguePipeControlLocation = nullptr;
+    commandBuffer->flushStamp->releaseStampObject();
+    this->freeCmdBuffers.pushTailOne(*commandBuffer.release());
+    this->numFreeCmdBuffers++;
+}
+
 OCLRT::BatchBuffer::BatchBuffer(GraphicsAllocation *commandBufferAllocation, size_t startOffset, size_t chainedBatchBufferStartOffset, GraphicsAllocation *chainedBatchBuffer, bool requiresCoherency, bool lowPriority, QueueThrottle throttle, size_t usedSize, LinearStream *stream) : commandBufferAllocation(commandBufferAllocation), startOffset(startOffset), chainedBatchBufferStartOffset(chainedBatchBufferStartOffset), chainedBatchBuffer(chainedBatchBuffer), requiresCoherency(requiresCoherency), low_priority(lowPriority), throttle(throttle), usedSize(usedSize), stream(stream) {
 }
 
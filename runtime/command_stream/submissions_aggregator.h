@@ -25,6 +25,7 @@
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/helpers/properties_helper.h"
 #include "runtime/memory_manager/residency_container.h"
+#include <memory>
 #include <vector>
 namespace OCLRT {
 class Device;
@@ -75,12 +76,20 @@ using ResourcePackage = StackVec<GraphicsAllocation *, 128>;
 
 class SubmissionAggregator {
   public:
+    static const size_t maxFreeCmdBuffers = 16;
+
     void recordCommandBuffer(CommandBuffer *commandBuffer);
     void aggregateCommandBuffers(ResourcePackage &resourcePackage, size_t &totalUsedSize, size_t totalMemoryBudget);
     CommandBufferList &peekCmdBufferList() { return cmdBuffers; }
 
+    CommandBuffer *obtainCommandBuffer(Device &device);
+    void recycleCommandBuffer(std::unique_ptr<CommandBuffer> commandBuffer);
+    CommandBufferList &peekFreeCmdBufferList() { return freeCmdBuffers; }
+
   protected:
     CommandBufferList cmdBuffers;
+    CommandBufferList freeCmdBuffers;
+    size_t numFreeCmdBuffers = 0;
     uint32_t inspectionId = 1;
 };
 } // namespace OCLRT
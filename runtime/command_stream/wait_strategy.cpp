@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/api/cl_types.h"
+#include "public/cl_ext_private.h"
+#include "runtime/command_stream/wait_strategy.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include <chrono>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define OCLRT_CPU_PAUSE() _mm_pause()
+#else
+#define OCLRT_CPU_PAUSE() std::this_thread::yield()
+#endif
+
+namespace OCLRT {
+namespace WaitStrategyHelper {
+
+WaitStrategy getDefaultWaitStrategy() {
+    auto overrideWaitStrategy = DebugManager.flags.OverrideWaitStrategy.get();
+    if ((overrideWaitStrategy >= 0) && (overrideWaitStrategy < static_cast<int32_t>(WaitStrategy::Count))) {
+        return static_cast<WaitStrategy>(overrideWaitStrategy);
+    }
+    return WaitStrategy::Yield;
+}
+
+bool isValidClWaitStrategy(uint64_t clWaitStrategy) {
+    return (clWaitStrategy >= CL_QUEUE_WAIT_STRATEGY_YIELD_INTEL) && (clWaitStrategy <= CL_QUEUE_WAIT_STRATEGY_ADAPTIVE_INTEL);
+}
+
+WaitStrategy getWaitStrategy(uint64_t clWaitStrategy) {
+    if ((DebugManager.flags.OverrideWaitStrategy.get() != -1) || !isValidClWaitStrategy(clWaitStrategy)) {
+        return getDefaultWaitStrategy();
+    }
+    return static_cast<WaitStrategy>(clWaitStrategy - CL_QUEUE_WAIT_STRATEGY_YIELD_INTEL);
+}
+
+void waitStep(WaitStrategy waitStrategy, uint32_t iteration) {
+    switch (waitStrategy) {
+    case WaitStrategy::Spin:
+        OCLRT_CPU_PAUSE();
+        break;
+    case WaitStrategy::Backoff:
+        if (iteration < backoffSpinIterations) {
+            for (uint32_t i = 0; i < (1u << iteration); i++) {
+                OCLRT_CPU_PAUSE();
+            }
+        } else {
+            std::this_thread::yield();
+        }
+        break;
+    case WaitStrategy::Sleep:
+        std::this_thread::sleep_for(std::chrono::microseconds(sleepMicroseconds));
+        break;
+    case WaitStrategy::Adaptive:
+        if (iteration < adaptiveSpinIterations) {
+            OCLRT_CPU_PAUSE();
+        } else if (iteration < adaptiveYieldIterations) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(sleepMicroseconds));
+        }
+        break;
+    default:
+        std::this_thread::yield();
+        break;
+    }
+}
+} // namespace WaitStrategyHelper
+
+WaitHistogram::WaitHistogram() {
+    for (auto &strategyCounts : counts) {
+        for (auto &count : strategyCounts) {
+            count.store(0);
+        }
+    }
+}
+
+uint32_t WaitHistogram::getBucket(int64_t waitMicroseconds) {
+    uint32_t bucket = 0;
+    while ((bucket < numBuckets - 1) && (waitMicroseconds >= (1ll << bucket))) {
+        bucket++;
+    }
+    return bucket;
+}
+
+void WaitHistogram::record(WaitStrategy waitStrategy, int64_t waitMicroseconds) {
+    counts[static_cast<uint32_t>(waitStrategy)][getBucket(waitMicroseconds)]++;
+}
+
+uint64_t WaitHistogram::getCount(WaitStrategy waitStrategy, uint32_t bucket) const {
+    return counts[static_cast<uint32_t>(waitStrategy)][bucket].load();
+}
+
+uint64_t WaitHistogram::getTotalCount(WaitStrategy waitStrategy) const {
+    uint64_t totalCount = 0;
+    for (uint32_t bucket = 0; bucket < numBuckets; bucket++) {
+        totalCount += getCount(waitStrategy, bucket);
+    }
+    return totalCount;
+}
+
+void WaitHistogram::print() const {
+    for (uint32_t strategy = 0; strategy < numStrategies; strategy++) {
+        if (getTotalCount(static_cast<WaitStrategy>(strategy)) == 0) {
+            continue;
+        }
+        printDebugString(DebugManager.flags.PrintDebugMessages.get(), stdout, "Wait strategy %u durations:", strategy);
+        for (uint32_t bucket = 0; bucket < numBuckets; bucket++) {
+            printDebugString(DebugManager.flags.PrintDebugMessages.get(), stdout, " <%lluus: %llu",
+                             static_cast<unsigned long long>(1ull << bucket),
+                             static_cast<unsigned long long>(getCount(static_cast<WaitStrategy>(strategy), bucket)));
+        }
+        printDebugString(DebugManager.flags.PrintDebugMessages.get(), stdout, "\n");
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace OCLRT {
+
+enum class WaitStrategy : int32_t {
+    Yield = 0, // yield the thread between tag reads
+    Spin,      // cpu pause between tag reads, never gives the core away
+    Backoff,   // exponentially growing pause runs, then yield
+    Sleep,     // sleep between tag reads
+    Adaptive,  // spin first, then yield, then sleep as the wait gets longer
+    Count
+};
+
+namespace WaitStrategyHelper {
+constexpr uint32_t backoffSpinIterations = 7; // pause runs grow from 1 to 64 pauses
+constexpr uint32_t adaptiveSpinIterations = 1000;
+constexpr uint32_t adaptiveYieldIterations = 2000;
+constexpr int64_t sleepMicroseconds = 50;
+
+WaitStrategy getDefaultWaitStrategy();
+WaitStrategy getWaitStrategy(uint64_t clWaitStrategy);
+bool isValidClWaitStrategy(uint64_t clWaitStrategy);
+// waits a single step before the next tag read, iteration counts previous steps of the same wait
+void waitStep(WaitStrategy waitStrategy, uint32_t iteration);
+} // namespace WaitStrategyHelper
+
+// bucket n counts waits that took less than 2^n microseconds, the last bucket counts all longer waits
+class WaitHistogram {
+  public:
+    static const uint32_t numBuckets = 24;
+    static const uint32_t numStrategies = static_cast<uint32_t>(WaitStrategy::Count);
+
+    WaitHistogram();
+
+    void record(WaitStrategy waitStrategy, int64_t waitMicroseconds);
+    uint64_t getCount(WaitStrategy waitStrategy, uint32_t bucket) const;
+    uint64_t getTotalCount(WaitStrategy waitStrategy) const;
+    void print() const;
+
+    static uint32_t getBucket(int64_t waitMicroseconds);
+
+  protected:
+    std::atomic<uint64_t> counts[numStrategies][numBuckets];
+};
+} // namespace OCLRT
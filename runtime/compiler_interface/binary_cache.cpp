@@ -25,47 +25,16 @@
 #include <runtime/compiler_interface/binary_cache.h>
 #include <runtime/helpers/aligned_memory.h>
 #include <runtime/helpers/file_io.h>
-#include <runtime/helpers/hash.h>
-#include <runtime/helpers/hw_info.h>
 #include <runtime/os_interface/os_inc_base.h>
 #include <runtime/program/program.h>
 
 #include <cstring>
 #include <string>
-#include <sstream>
-#include <iomanip>
 #include <mutex>
 
 namespace OCLRT {
 std::mutex BinaryCache::cacheAccessMtx;
 
-const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, const ArrayRef<const char> input,
-                                                 const ArrayRef<const char> options, const ArrayRef<const char> internalOptions) {
-    Hash hash;
-
-    hash.update("----", 4);
-    hash.update(&*input.begin(), input.size());
-    hash.update("----", 4);
-    hash.update(&*options.begin(), options.size());
-    hash.update("----", 4);
-    hash.update(&*internalOptions.begin(), internalOptions.size());
-
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pPlatform), sizeof(*hwInfo.pPlatform));
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pSkuTable), sizeof(*hwInfo.pSkuTable));
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pWaTable), sizeof(*hwInfo.pWaTable));
-
-    auto res = hash.finish();
-    std::stringstream stream;
-    stream << std::setfill('0')
-           << std::setw(sizeof(res) * 2)
-           << std::hex
-           << res;
-    return stream.str();
-}
-
 bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) {
     if (pBinary == nullptr || binarySize == 0) {
         return false;
@@ -73,7 +42,7 @@ bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBin
 
     std::string hashFilePath = CL_CACHE_LOCATION;
     hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+    hashFilePath.append(kernelFileHash + cacheFileExtension);
 
     std::lock_guard<std::mutex> lock(cacheAccessMtx);
     if (writeDataToFile(
@@ -92,7 +61,7 @@ bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &pr
 
     std::string hashFilePath = CL_CACHE_LOCATION;
     hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+    hashFilePath.append(kernelFileHash + cacheFileExtension);
 
     {
         std::lock_guard<std::mutex> lock(cacheAccessMtx);
@@ -34,6 +34,8 @@ struct HardwareInfo;
 class Program;
 class BinaryCache {
   public:
+    static const char *const cacheFileExtension;
+
     static const std::string getCachedFileName(const HardwareInfo &hwInfo, ArrayRef<const char> input,
                                                ArrayRef<const char> options, ArrayRef<const char> internalOptions);
 
@@ -21,9 +21,48 @@
  */
 
 #include "runtime/compiler_interface/compiler_options.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 
 namespace OCLRT {
 
 const char *CompilerOptions::debugKernelEnable = " -cl-kernel-debug-enable";
+const char *CompilerOptions::preserveVec3Type = "-fpreserve-vec3-type ";
+
+std::string CompilerOptions::getDeviceInternalOptions(uint32_t clVersion, bool force32BitAddressing, bool statelessToStatefulWithOffsetSupported) {
+    std::string internalOptions;
+
+    switch (clVersion) {
+    case 21:
+        internalOptions = "-ocl-version=210 ";
+        break;
+    case 20:
+        internalOptions = "-ocl-version=200 ";
+        break;
+    case 12:
+        internalOptions = "-ocl-version=120 ";
+        break;
+    default:
+        break;
+    }
+
+    if (force32BitAddressing) {
+        internalOptions += "-m32 ";
+    }
+
+    if (DebugManager.flags.DisableStatelessToStatefulOptimization.get()) {
+        internalOptions += "-cl-intel-greater-than-4GB-buffer-required ";
+    }
+
+    auto enableStatelessToStatefullWithOffset = statelessToStatefulWithOffsetSupported;
+    if (DebugManager.flags.EnableStatelessToStatefulBufferOffsetOpt.get() != -1) {
+        enableStatelessToStatefullWithOffset = DebugManager.flags.EnableStatelessToStatefulBufferOffsetOpt.get() != 0;
+    }
+
+    if (enableStatelessToStatefullWithOffset) {
+        internalOptions += "-cl-intel-has-buffer-offset-arg ";
+    }
+
+    return internalOptions;
+}
 
 } // namespace OCLRT
@@ -21,10 +21,15 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <string>
 
 namespace OCLRT {
 struct CompilerOptions {
     static const char *debugKernelEnable;
+    static const char *preserveVec3Type;
+
+    // internal options passed to the compiler for every program built for a device
+    static std::string getDeviceInternalOptions(uint32_t clVersion, bool force32BitAddressing, bool statelessToStatefulWithOffsetSupported);
 };
 } // namespace OCLRT
@@ -24,6 +24,7 @@
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/device/device.h"
 #include "runtime/device_queue/device_queue.h"
+#include "runtime/event/event_pool.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/gtpin/gtpin_notify.h"
 #include "runtime/helpers/get_info.h"
@@ -58,6 +59,9 @@ Context::Context(
     defaultDeviceQueue = nullptr;
     driverDiagnostics = nullptr;
     sharingFunctions.resize(SharingType::MAX_SHARING_VALUE);
+    if (DebugManager.flags.EventStoragePoolSize.get() > 0) {
+        eventPool = std::make_shared<EventPool>(static_cast<size_t>(DebugManager.flags.EventStoragePoolSize.get()));
+    }
 }
 
 Context::~Context() {
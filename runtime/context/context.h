@@ -24,12 +24,14 @@
 #include "runtime/device/device_vector.h"
 #include "runtime/event/event.h"
 #include "runtime/context/driver_diagnostics.h"
+#include <memory>
 #include <vector>
 
 namespace OCLRT {
 
 class Device;
 class DeviceQueue;
+class EventPool;
 class MemoryManager;
 class SharingFunctions;
 class SVMAllocsManager;
@@ -87,6 +89,10 @@ class Context : public BaseObject<_cl_context> {
         return svmAllocsManager;
     }
 
+    const std::shared_ptr<EventPool> &getEventPool() const {
+        return eventPool;
+    }
+
     DeviceQueue *getDefaultDeviceQueue();
     void setDefaultDeviceQueue(DeviceQueue *queue);
 
@@ -138,6 +144,7 @@ class Context : public BaseObject<_cl_context> {
     DeviceVector devices;
     MemoryManager *memoryManager;
     SVMAllocsManager *svmAllocsManager = nullptr;
+    std::shared_ptr<EventPool> eventPool;
     CommandQueue *specialQueue;
     DeviceQueue *defaultDeviceQueue;
     std::vector<std::unique_ptr<SharingFunctions>> sharingFunctions;
@@ -20,10 +20,12 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "config.h"
 #include "runtime/device/device.h"
 #include "hw_cmds.h"
 #include "runtime/built_ins/built_ins.h"
 #include "runtime/built_ins/sip.h"
+#include "runtime/command_queue/lws_autotuner.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/command_stream/device_command_stream.h"
 #include "runtime/command_stream/experimental_command_buffer.h"
@@ -36,6 +38,7 @@
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/options.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/os_inc_base.h"
 #include "runtime/os_interface/os_interface.h"
 #include "runtime/os_interface/os_time.h"
 #include "runtime/source_level_debugger/source_level_debugger.h"
@@ -184,6 +187,16 @@ bool Device::createDeviceImpl(const HardwareInfo *pHwInfo, Device &outDevice) {
             std::unique_ptr<ExperimentalCommandBuffer>(new ExperimentalCommandBuffer(commandStreamReceiver, pDevice->getDeviceInfo().profilingTimerResolution)));
     }
 
+    if (DebugManager.flags.EnableLwsAutotuning.get()) {
+        std::string resultsFileName = CL_CACHE_LOCATION;
+        resultsFileName.append(Os::fileSeparator);
+        resultsFileName.append(std::to_string(pHwInfo->pPlatform->usDeviceID) + "_" + std::to_string(pHwInfo->pPlatform->usRevId) + LwsAutotuner::resultsFileExtension);
+        pDevice->lwsAutotuner.reset(new LwsAutotuner(resultsFileName,
+                                                     static_cast<uint32_t>(DebugManager.flags.LwsAutotuningCandidates.get()),
+                                                     static_cast<uint32_t>(DebugManager.flags.LwsAutotuningSamplesPerCandidate.get())));
+        pDevice->lwsAutotuner->loadResults();
+    }
+
     return true;
 }
 
@@ -37,6 +37,7 @@ class GraphicsAllocation;
 class MemoryManager;
 class OSTime;
 class DriverInfo;
+class LwsAutotuner;
 struct HardwareInfo;
 class SourceLevelDebugger;
 
@@ -131,6 +132,7 @@ class Device : public BaseObject<_cl_device_id> {
     SourceLevelDebugger *getSourceLevelDebugger() { return executionEnvironment->sourceLevelDebugger.get(); }
     ExecutionEnvironment *getExecutionEnvironment() const { return executionEnvironment; }
     const HardwareCapabilities &getHardwareCapabilities() { return hardwareCapabilities; }
+    LwsAutotuner *getLwsAutotuner() const { return lwsAutotuner.get(); }
 
   protected:
     Device() = delete;
@@ -162,6 +164,7 @@ class Device : public BaseObject<_cl_device_id> {
     std::unique_ptr<OSTime> osTime;
     std::unique_ptr<DriverInfo> driverInfo;
     std::unique_ptr<PerformanceCounters> performanceCounters;
+    std::unique_ptr<LwsAutotuner> lwsAutotuner;
 
     void *slmWindowStartAddress;
 
@@ -69,10 +69,6 @@ bool Device::getEnabled64kbPages() {
 
 void Device::setupFp64Flags() {
     if (DebugManager.flags.OverrideDefaultFP64Settings.get() == -1) {
-        if (hwInfo.capabilityTable.ftrSupportsFP64) {
-            deviceExtensions += "cl_khr_fp64 ";
-        }
-
         deviceInfo.singleFpConfig = static_cast<cl_device_fp_config>(
             hwInfo.capabilityTable.ftrSupports64BitMath
                 ? CL_FP_CORRECTLY_ROUNDED_DIVIDE_SQRT
@@ -83,7 +79,6 @@ void Device::setupFp64Flags() {
                                         : 0;
     } else {
         if (DebugManager.flags.OverrideDefaultFP64Settings.get() == 1) {
-            deviceExtensions += "cl_khr_fp64 ";
             deviceInfo.singleFpConfig = static_cast<cl_device_fp_config>(CL_FP_CORRECTLY_ROUNDED_DIVIDE_SQRT);
             deviceInfo.doubleFpConfig = defaultFpFlags;
         }
@@ -91,8 +86,6 @@ void Device::setupFp64Flags() {
 }
 
 void Device::initializeCaps() {
-    deviceExtensions.clear();
-    deviceExtensions.append(deviceExtensionsList);
     // Add our graphics family name to the device name
     auto addressing32bitAllowed = is32BitOsAllocatorAvailable;
     if (is32bit) {
@@ -146,34 +139,19 @@ void Device::initializeCaps() {
     deviceInfo.cpuCopyAllowed = true;
     deviceInfo.spirVersions = spirVersions.c_str();
 
-    if (enabledClVersion >= 21) {
-        deviceInfo.independentForwardProgress = true;
-        deviceExtensions += "cl_khr_subgroups ";
-        deviceExtensions += "cl_khr_il_program ";
-    } else {
-        deviceInfo.independentForwardProgress = false;
-    }
-
-    if (enabledClVersion >= 20) {
-        deviceExtensions += "cl_khr_mipmap_image cl_khr_mipmap_image_writes ";
-    }
+    deviceInfo.independentForwardProgress = (enabledClVersion >= 21);
 
     if (DebugManager.flags.EnableNV12.get()) {
-        deviceExtensions += "cl_intel_planar_yuv ";
         deviceInfo.nv12Extension = true;
     }
     if (DebugManager.flags.EnablePackedYuv.get()) {
-        deviceExtensions += "cl_intel_packed_yuv ";
         deviceInfo.packedYuvExtension = true;
     }
     if (DebugManager.flags.EnableIntelVme.get()) {
-        deviceExtensions += "cl_intel_motion_estimation ";
         deviceInfo.vmeExtension = true;
     }
-    if (DebugManager.flags.EnableIntelAdvancedVme.get()) {
-        deviceExtensions += "cl_intel_advanced_motion_estimation ";
-    }
 
+    deviceExtensions = getDeviceExtensions(hwInfo, enabledClVersion);
     deviceExtensions += sharingFactory.getExtensions();
 
     simultaneousInterops = {0};
@@ -330,10 +330,7 @@ void DeviceQueueHw<GfxFamily>::setupIndirectState(IndirectHeap &surfaceStateHeap
     for (uint32_t i = 0; i < blockCount; i++) {
         const KernelInfo *pBlockInfo = blockManager->getBlockKernelInfo(i);
 
-        auto blockAllocation = pBlockInfo->getGraphicsAllocation();
-        DEBUG_BREAK_IF(!blockAllocation);
-
-        auto gpuAddress = blockAllocation ? blockAllocation->getGpuAddressToPatch() : 0llu;
+        auto gpuAddress = pBlockInfo->getKernelIsaGpuAddressToPatch();
 
         auto bindingTableCount = pBlockInfo->patchInfo.bindingTableState->Count;
         maxBindingTableCount = std::max(maxBindingTableCount, bindingTableCount);
@@ -20,6 +20,7 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "runtime/command_queue/command_queue.h"
 #include "runtime/event/async_events_handler.h"
 #include "runtime/event/event.h"
 #include "runtime/os_interface/os_thread.h"
@@ -31,6 +32,7 @@ AsyncEventsHandler::AsyncEventsHandler() {
     registerList.reserve(64);
     list.reserve(64);
     pendingList.reserve(64);
+    completedEvents.reserve(64);
 }
 
 AsyncEventsHandler::~AsyncEventsHandler() {
@@ -47,6 +49,11 @@ void AsyncEventsHandler::registerEvent(Event *event) {
     asyncCond.notify_one();
 }
 
+bool AsyncEventsHandler::isTrackedByTaskCount(Event *event) {
+    return !event->isExternallySynchronized() && (event->getCommandQueue() != nullptr) &&
+           (event->peekExecutionStatus() == CL_SUBMITTED) && (event->peekTaskCount() != Event::eventNotReady);
+}
+
 Event *AsyncEventsHandler::processList() {
     uint32_t lowestTaskCount = Event::eventNotReady;
     Event *sleepCandidate = nullptr;
@@ -55,6 +62,10 @@ Event *AsyncEventsHandler::processList() {
     for (auto event : list) {
         event->updateExecutionStatus();
         if (event->peekHasCallbacks() || (event->isExternallySynchronized() && (event->peekExecutionStatus() > CL_COMPLETE))) {
+            if (isTrackedByTaskCount(event)) {
+                trackedEvents[event->getCommandQueue()->getHwTagAddress()].push({event->peekTaskCount(), event});
+                continue;
+            }
             pendingList.push_back(event);
             if (event->peekTaskCount() < lowestTaskCount) {
                 sleepCandidate = event;
@@ -66,6 +77,37 @@ Event *AsyncEventsHandler::processList() {
     }
 
     list.swap(pendingList);
+
+    // read each tag once and complete only the events whose task count it reached
+    for (auto tracked = trackedEvents.begin(); tracked != trackedEvents.end();) {
+        auto &heap = tracked->second;
+        auto tag = *tracked->first;
+        completedEvents.clear();
+        while (!heap.empty() && (heap.top().taskCount <= tag)) {
+            completedEvents.push_back(heap.top().event);
+            heap.pop();
+        }
+        if (!completedEvents.empty()) {
+            Event::calcProfilingDataBatch(completedEvents);
+        }
+        for (auto event : completedEvents) {
+            event->updateExecutionStatus();
+            if (event->peekHasCallbacks()) {
+                list.push_back(event);
+            } else {
+                event->decRefInternal();
+            }
+        }
+        if (heap.empty()) {
+            tracked = trackedEvents.erase(tracked);
+            continue;
+        }
+        if (heap.top().taskCount < lowestTaskCount) {
+            sleepCandidate = heap.top().event;
+            lowestTaskCount = heap.top().taskCount;
+        }
+        ++tracked;
+    }
     return sleepCandidate;
 }
 
@@ -82,7 +124,7 @@ void *AsyncEventsHandler::asyncProcess(void *arg) {
             self->releaseEvents();
             break;
         }
-        if (self->list.empty()) {
+        if (self->list.empty() && self->trackedEvents.empty()) {
             self->asyncCond.wait(lock);
         }
         lock.unlock();
@@ -125,6 +167,14 @@ void AsyncEventsHandler::releaseEvents() {
         event->decRefInternal();
     }
     list.clear();
+    for (auto &tracked : trackedEvents) {
+        auto &heap = tracked.second;
+        while (!heap.empty()) {
+            heap.top().event->decRefInternal();
+            heap.pop();
+        }
+    }
+    trackedEvents.clear();
     UNRECOVERABLE_IF(!registerList.empty()) // transferred before release
 }
 } // namespace OCLRT
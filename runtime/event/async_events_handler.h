@@ -22,9 +22,11 @@
 
 #pragma once
 #include <vector>
+#include <map>
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <queue>
 #include <condition_variable>
 
 namespace OCLRT {
@@ -39,7 +41,17 @@ class AsyncEventsHandler {
     void closeThread();
 
   protected:
+    struct TrackedEvent {
+        uint32_t taskCount;
+        Event *event;
+    };
+    struct LaterTaskCount {
+        bool operator()(const TrackedEvent &lhs, const TrackedEvent &rhs) const { return lhs.taskCount > rhs.taskCount; }
+    };
+    using TaskCountHeap = std::priority_queue<TrackedEvent, std::vector<TrackedEvent>, LaterTaskCount>;
+
     Event *processList();
+    static bool isTrackedByTaskCount(Event *event);
     static void *asyncProcess(void *arg);
     void releaseEvents();
     MOCKABLE_VIRTUAL void openThread();
@@ -47,6 +59,9 @@ class AsyncEventsHandler {
     std::vector<Event *> registerList;
     std::vector<Event *> list;
     std::vector<Event *> pendingList;
+    std::vector<Event *> completedEvents;
+    // submitted events waiting only for their task count, ordered per command stream receiver tag
+    std::map<volatile uint32_t *, TaskCountHeap> trackedEvents;
 
     std::unique_ptr<Thread> thread;
     std::mutex asyncMtx;
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/event/callback_executor.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/os_interface/os_thread.h"
+#include <algorithm>
+#include <functional>
+
+namespace OCLRT {
+
+CallbackExecutor::CallbackExecutor(uint32_t numWorkers) {
+    for (uint32_t i = 0; i < numWorkers; i++) {
+        workers.push_back(std::unique_ptr<Worker>(new Worker));
+        workers.back()->executor = this;
+    }
+}
+
+CallbackExecutor::~CallbackExecutor() {
+    closeThreads();
+    auto stats = getStatistics();
+    if (stats.executedCallbacks > 0) {
+        printDebugString(DebugManager.flags.PrintDebugMessages.get(), stdout,
+                         "Event callbacks executed: %llu, avg queue latency: %llu ns, max queue latency: %llu ns, avg execution time: %llu ns, max execution time: %llu ns\n",
+                         static_cast<unsigned long long>(stats.executedCallbacks),
+                         static_cast<unsigned long long>(stats.totalQueueLatencyNs / stats.executedCallbacks),
+                         static_cast<unsigned long long>(stats.maxQueueLatencyNs),
+                         static_cast<unsigned long long>(stats.totalExecutionTimeNs / stats.executedCallbacks),
+                         static_cast<unsigned long long>(stats.maxExecutionTimeNs));
+    }
+}
+
+bool CallbackExecutor::submit(Event *event, std::vector<Event::Callback *> &callbacks) {
+    if (workers.empty()) {
+        return false;
+    }
+    auto &worker = *workers[std::hash<Event *>()(event) % workers.size()];
+    std::unique_lock<std::mutex> lock(worker.mtx);
+    if (!worker.allowProcessing) {
+        return false;
+    }
+    if (!worker.thread) {
+        openThread(worker);
+    }
+    worker.tasks.push_back({event, std::move(callbacks), std::chrono::steady_clock::now()});
+    callbacks.clear();
+    worker.cond.notify_one();
+    return true;
+}
+
+void CallbackExecutor::openThread(Worker &worker) {
+    worker.thread = Thread::create(workerProcess, reinterpret_cast<void *>(&worker));
+}
+
+void *CallbackExecutor::workerProcess(void *arg) {
+    auto worker = reinterpret_cast<Worker *>(arg);
+    std::unique_lock<std::mutex> lock(worker->mtx);
+
+    while (true) {
+        if (worker->tasks.empty()) {
+            if (!worker->allowProcessing) {
+                break;
+            }
+            worker->cond.wait(lock);
+            continue;
+        }
+        auto task = std::move(worker->tasks.front());
+        worker->tasks.pop_front();
+        lock.unlock();
+        worker->executor->runTask(task);
+        lock.lock();
+    }
+    return nullptr;
+}
+
+void CallbackExecutor::runTask(Task &task) {
+    auto startTime = std::chrono::steady_clock::now();
+    auto numCallbacks = task.callbacks.size();
+    task.event->runCallbacks(task.callbacks);
+    auto endTime = std::chrono::steady_clock::now();
+
+    auto queueLatency = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(startTime - task.submitTime).count());
+    auto executionTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+
+    std::unique_lock<std::mutex> lock(statisticsMtx);
+    statistics.executedCallbacks += numCallbacks;
+    statistics.totalQueueLatencyNs += queueLatency;
+    statistics.maxQueueLatencyNs = std::max(statistics.maxQueueLatencyNs, queueLatency);
+    statistics.totalExecutionTimeNs += executionTime;
+    statistics.maxExecutionTimeNs = std::max(statistics.maxExecutionTimeNs, executionTime);
+}
+
+void CallbackExecutor::closeThreads() {
+    for (auto &worker : workers) {
+        {
+            std::unique_lock<std::mutex> lock(worker->mtx);
+            worker->allowProcessing = false;
+            worker->cond.notify_one();
+        }
+        if (worker->thread) {
+            worker->thread->join();
+            worker->thread.reset(nullptr);
+        }
+        // callbacks must be called before their events are destroyed
+        for (auto &task : worker->tasks) {
+            runTask(task);
+        }
+        worker->tasks.clear();
+    }
+}
+
+CallbackExecutor::Statistics CallbackExecutor::getStatistics() {
+    std::unique_lock<std::mutex> lock(statisticsMtx);
+    return statistics;
+}
+} // namespace OCLRT
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/event/event.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+class Thread;
+
+// Runs event callbacks on worker threads so that status updates do not wait for user code.
+// All callbacks of a given event are executed by the same worker, in submission order.
+class CallbackExecutor {
+  public:
+    struct Statistics {
+        uint64_t executedCallbacks = 0;
+        uint64_t totalQueueLatencyNs = 0;
+        uint64_t maxQueueLatencyNs = 0;
+        uint64_t totalExecutionTimeNs = 0;
+        uint64_t maxExecutionTimeNs = 0;
+    };
+
+    CallbackExecutor(uint32_t numWorkers);
+    virtual ~CallbackExecutor();
+
+    // returns false when there are no workers and callbacks have to be executed by the caller
+    bool submit(Event *event, std::vector<Event::Callback *> &callbacks);
+    void closeThreads();
+
+    uint32_t getNumWorkers() const { return static_cast<uint32_t>(workers.size()); }
+    Statistics getStatistics();
+
+  protected:
+    struct Task {
+        Event *event;
+        std::vector<Event::Callback *> callbacks;
+        std::chrono::steady_clock::time_point submitTime;
+    };
+
+    struct Worker {
+        CallbackExecutor *executor = nullptr;
+        std::deque<Task> tasks;
+        std::mutex mtx;
+        std::condition_variable cond;
+        std::unique_ptr<Thread> thread;
+        bool allowProcessing = true;
+    };
+
+    static void *workerProcess(void *arg);
+    void runTask(Task &task);
+    MOCKABLE_VIRTUAL void openThread(Worker &worker);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex statisticsMtx;
+    Statistics statistics;
+};
+} // namespace OCLRT
@@ -27,6 +27,7 @@
 #include "runtime/context/context.h"
 #include "runtime/device/device.h"
 #include "runtime/event/event.h"
+#include "runtime/event/event_pool.h"
 #include "runtime/event/event_tracker.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/get_info.h"
@@ -38,6 +39,10 @@
 #include "runtime/utilities/tag_allocator.h"
 #include "runtime/platform/platform.h"
 #include "runtime/event/async_events_handler.h"
+#include "runtime/event/callback_executor.h"
+
+#include <algorithm>
+#include <thread>
 
 namespace OCLRT {
 
@@ -125,7 +130,9 @@ Event::~Event() {
     //    "All callbacks registered for an event object must be called.
     //     All enqueued callbacks shall be called before the event object is destroyed."
     if (peekHasCallbacks()) {
-        executeCallbacks(lastStatus);
+        std::vector<Callback *> detachedCallbacks;
+        detachCallbacks(lastStatus, detachedCallbacks);
+        runCallbacks(detachedCallbacks);
     }
 
     {
@@ -160,6 +167,13 @@ Event::~Event() {
     unblockEventsBlockedByThis(executionStatus);
 }
 
+void Event::releaseToStoragePool(Event *event) {
+    // pool has to outlive the event, whose destruction may release the last context reference
+    auto pool = std::move(event->storagePool);
+    event->~Event();
+    pool->releaseStorage(event);
+}
+
 cl_int Event::getEventProfilingInfo(cl_profiling_info paramName,
                                     size_t paramValueSize,
                                     void *paramValue,
@@ -242,8 +256,24 @@ void Event::updateCompletionStamp(uint32_t taskCount, uint32_t tasklevel, FlushS
     this->flushStamp->setStamp(flushStamp);
 }
 
-cl_ulong Event::getDelta(cl_ulong startTime,
-                         cl_ulong endTime) {
+void Event::collectCsrDependencies(CsrDependencies &dependencies) const {
+    dependencies.merge(csrDependencies);
+    uint32_t taskCount = peekTaskCount();
+    if ((cmdQueue != nullptr) && !isUserEvent() && (taskCount != Event::eventNotReady)) {
+        dependencies.add(cmdQueue->getDevice().getCommandStreamReceiver(), taskCount);
+    }
+}
+
+bool Event::isCompletedOnCsr() const {
+    uint32_t taskCount = peekTaskCount();
+    if ((cmdQueue == nullptr) || isUserEvent() || (taskCount == Event::eventNotReady)) {
+        return false;
+    }
+    return CsrDependencies::isSatisfied(cmdQueue->getDevice().getCommandStreamReceiver(), taskCount);
+}
+
+static inline cl_ulong getTimestampDelta(cl_ulong startTime,
+                                         cl_ulong endTime) {
     cl_ulong Max = (1ULL << OCLRT_NUM_TIMESTAMP_BITS) - 1;
     cl_ulong Delta = 0;
 
@@ -260,6 +290,11 @@ cl_ulong Event::getDelta(cl_ulong startTime,
     return Delta;
 }
 
+cl_ulong Event::getDelta(cl_ulong startTime,
+                         cl_ulong endTime) {
+    return getTimestampDelta(startTime, endTime);
+}
+
 bool Event::calcProfilingData() {
     uint64_t gpuDuration = 0;
     uint64_t cpuDuration = 0;
@@ -298,6 +333,67 @@ bool Event::calcProfilingData() {
     return dataCalculated;
 }
 
+void Event::calcProfilingDataBatch(ArrayRef<Event *> completedEvents) {
+    constexpr size_t chunkSize = 64;
+    Event *events[chunkSize];
+    uint64_t globalStartTS[chunkSize];
+    uint64_t contextStartTS[chunkSize];
+    uint64_t contextEndTS[chunkSize];
+    uint64_t contextCompleteTS[chunkSize];
+    int64_t c0[chunkSize];
+    size_t numEvents = 0;
+    const Device *device = nullptr;
+    double frequency = 0.0;
+
+    // same equations as calcProfilingData, in plain loops over gathered values
+    auto convertChunk = [&]() {
+        uint64_t start[chunkSize];
+        uint64_t cpuDuration[chunkSize];
+        uint64_t cpuCompleteDuration[chunkSize];
+        for (size_t i = 0; i < numEvents; i++) {
+            start[i] = static_cast<uint64_t>(globalStartTS[i] * frequency) + c0[i];
+            cpuDuration[i] = static_cast<uint64_t>(getTimestampDelta(contextStartTS[i], contextEndTS[i]) * frequency);
+            cpuCompleteDuration[i] = static_cast<uint64_t>(getTimestampDelta(contextStartTS[i], contextCompleteTS[i]) * frequency);
+        }
+        for (size_t i = 0; i < numEvents; i++) {
+            events[i]->startTimeStamp = start[i];
+            events[i]->endTimeStamp = start[i] + cpuDuration[i];
+            events[i]->completeTimeStamp = start[i] + cpuCompleteDuration[i];
+            events[i]->dataCalculated = true;
+        }
+        numEvents = 0;
+    };
+
+    for (auto event : completedEvents) {
+        if (event->dataCalculated || !event->profilingEnabled || event->profilingCpuPath ||
+            (event->timeStampNode == nullptr) || (event->cmdQueue == nullptr)) {
+            continue;
+        }
+        auto &eventDevice = event->cmdQueue->getDevice();
+        if (&eventDevice != device) {
+            convertChunk();
+            device = &eventDevice;
+            frequency = eventDevice.getDeviceInfo().profilingTimerResolution;
+        }
+
+        auto timestamps = event->timeStampNode->tag;
+        //If device enqueue has not updated complete timestamp, assign end timestamp
+        if (timestamps->ContextCompleteTS == 0) {
+            timestamps->ContextCompleteTS = timestamps->ContextEndTS;
+        }
+        events[numEvents] = event;
+        globalStartTS[numEvents] = timestamps->GlobalStartTS;
+        contextStartTS[numEvents] = timestamps->ContextStartTS;
+        contextEndTS[numEvents] = timestamps->ContextEndTS;
+        contextCompleteTS[numEvents] = timestamps->ContextCompleteTS;
+        c0[numEvents] = event->queueTimeStamp.CPUTimeinNS - static_cast<uint64_t>(event->queueTimeStamp.GPUTimeStamp * frequency);
+        if (++numEvents == chunkSize) {
+            convertChunk();
+        }
+    }
+    convertChunk();
+}
+
 inline bool Event::wait(bool blocking, bool useQuickKmdSleep) {
     while (this->taskCount == Event::eventNotReady) {
         if (blocking == false) {
@@ -491,14 +587,54 @@ cl_int Event::waitForEvents(cl_uint numEvents,
         return CL_SUCCESS;
     }
 
-    //flush all command queues
+    struct CsrWait {
+        CommandStreamReceiver *csr;
+        uint32_t taskCount;
+        FlushStamp flushStamp;
+        WaitStrategy waitStrategy;
+    };
+    StackVec<CommandQueue *, 8> flushedQueues;
+    StackVec<CsrWait, 4> csrWaits;
+    StackVec<Event *, 16> profiledEvents;
+
+    //flush each command queue once and find the highest task count to wait for on each csr
     for (const cl_event *it = eventList, *end = eventList + numEvents; it != end; ++it) {
         Event *event = castToObjectOrAbort<Event>(*it);
-        if (event->cmdQueue) {
-            if (event->taskLevel != Event::eventNotReady) {
-                event->cmdQueue->flush();
-            }
+        if ((event->cmdQueue == nullptr) || (event->taskLevel == Event::eventNotReady)) {
+            continue;
+        }
+        if (std::find(flushedQueues.begin(), flushedQueues.end(), event->cmdQueue) == flushedQueues.end()) {
+            event->cmdQueue->flush();
+            flushedQueues.push_back(event->cmdQueue);
+        }
+
+        uint32_t taskCount = event->taskCount;
+        if (event->isUserEvent() || (taskCount == Event::eventNotReady) || (event->peekExecutionStatus() < 0)) {
+            continue;
+        }
+        if (event->isProfilingEnabled()) {
+            profiledEvents.push_back(event);
+        }
+        auto csr = &event->cmdQueue->getDevice().getCommandStreamReceiver();
+        auto csrWait = std::find_if(csrWaits.begin(), csrWaits.end(), [csr](const CsrWait &wait) { return wait.csr == csr; });
+        if (csrWait == csrWaits.end()) {
+            csrWaits.push_back({csr, taskCount, event->flushStamp->peekStamp(), event->cmdQueue->getWaitStrategy()});
+        } else if (taskCount > csrWait->taskCount) {
+            csrWait->taskCount = taskCount;
+            csrWait->flushStamp = event->flushStamp->peekStamp();
+            csrWait->waitStrategy = event->cmdQueue->getWaitStrategy();
+        }
+    }
+
+    // one blocking wait per csr, events below are then already completed
+    for (auto &csrWait : csrWaits) {
+        if (DebugManager.flags.EnableCsrDependencyTracking.get() && CsrDependencies::isSatisfied(*csrWait.csr, csrWait.taskCount)) {
+            continue;
         }
+        csrWait.csr->waitForTaskCountWithKmdNotifyFallback(csrWait.taskCount, csrWait.flushStamp, false, csrWait.waitStrategy);
+    }
+    if (profiledEvents.size() > 0) {
+        calcProfilingDataBatch(profiledEvents);
     }
 
     using WorkerListT = StackVec<cl_event, 64>;
@@ -524,6 +660,10 @@ cl_int Event::waitForEvents(cl_uint numEvents,
 
         std::swap(currentlyPendingEvents, pendingEventsLeft);
         pendingEventsLeft->clear();
+        if (currentlyPendingEvents->size() > 0) {
+            // only events blocked on user events are left, don't starve the threads that unblock them
+            std::this_thread::yield();
+        }
     }
 
     return CL_SUCCESS;
@@ -601,6 +741,19 @@ void Event::addCallback(Callback::ClbFuncT fn, cl_int type, void *data) {
 }
 
 void Event::executeCallbacks(int32_t executionStatusIn) {
+    std::vector<Callback *> detachedCallbacks;
+    detachCallbacks(executionStatusIn, detachedCallbacks);
+    if (detachedCallbacks.empty()) {
+        return;
+    }
+
+    auto callbackExecutor = (platform() != nullptr) ? platform()->getCallbackExecutor() : nullptr;
+    if ((callbackExecutor == nullptr) || !callbackExecutor->submit(this, detachedCallbacks)) {
+        runCallbacks(detachedCallbacks);
+    }
+}
+
+void Event::detachCallbacks(int32_t executionStatusIn, std::vector<Callback *> &detachedCallbacks) {
     int32_t execStatus = executionStatusIn;
     bool terminated = isStatusCompletedByTermination(&execStatus);
     ECallbackTarget target;
@@ -614,24 +767,29 @@ void Event::executeCallbacks(int32_t executionStatusIn) {
         }
     }
 
-    // run through all needed callback targets and execute callbacks
+    // collect all needed callback targets in execution order
     for (uint32_t i = 0; i <= (uint32_t)target; ++i) {
-        auto cb = callbacks[i].detachNodes();
-        auto curr = cb;
+        auto curr = callbacks[i].detachNodes();
         while (curr != nullptr) {
-            auto next = curr->next;
             if (terminated) {
                 curr->overrideCallbackExecutionStatusTarget(execStatus);
             }
-            DBG_LOG(EventsDebugEnable, "event", this, "executing callback", "ECallbackTarget", (uint32_t)target);
-            curr->execute();
-            decRefInternal();
-            delete curr;
-            curr = next;
+            detachedCallbacks.push_back(curr);
+            curr = curr->next;
         }
     }
 }
 
+void Event::runCallbacks(std::vector<Callback *> &detachedCallbacks) {
+    for (auto callback : detachedCallbacks) {
+        DBG_LOG(EventsDebugEnable, "event", this, "executing callback", "status", callback->getCallbackExecutionStatusTarget());
+        callback->execute();
+        decRefInternal();
+        delete callback;
+    }
+    detachedCallbacks.clear();
+}
+
 void Event::tryFlushEvent() {
     //only if event is not completed, completed event has already been flushed
     if (cmdQueue && (updateStatusAndCheckCompletion() == false)) {
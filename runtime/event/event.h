@@ -25,6 +25,7 @@
 #include "runtime/helpers/base_object.h"
 #include <cstdint>
 #include <atomic>
+#include <memory>
 #include <vector>
 #include "runtime/helpers/task_information.h"
 #include "runtime/utilities/idlist.h"
@@ -33,6 +34,8 @@
 #include "runtime/os_interface/os_time.h"
 #include "runtime/os_interface/performance_counters.h"
 #include "runtime/helpers/flush_stamp.h"
+#include "runtime/helpers/memory_access_set.h"
+#include "runtime/command_stream/csr_dependencies.h"
 #include "runtime/utilities/arrayref.h"
 
 #define OCLRT_NUM_TIMESTAMP_BITS (32)
@@ -43,6 +46,7 @@ struct TagNode;
 class CommandQueue;
 class Context;
 class Device;
+class EventPool;
 class TimestampPacket;
 
 template <>
@@ -104,11 +108,24 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
 
     ~Event() override;
 
+    // events placed in pooled storage hand it back to their pool instead of freeing it
+    DeleterFuncType getCustomDeleter() const {
+        return storagePool ? &Event::releaseToStoragePool : nullptr;
+    }
+    void setStoragePool(std::shared_ptr<EventPool> pool) {
+        storagePool = std::move(pool);
+    }
+
+    // executes and releases callbacks already detached from this event
+    void runCallbacks(std::vector<Callback *> &detachedCallbacks);
+
     uint32_t getCompletionStamp(void) const;
     void updateCompletionStamp(uint32_t taskCount, uint32_t tasklevel, FlushStamp flushStamp);
     cl_ulong getDelta(cl_ulong startTime,
                       cl_ulong endTime);
     bool calcProfilingData();
+    // converts timestamps of already completed events in one pass, so later profiling queries only read results
+    static void calcProfilingDataBatch(ArrayRef<Event *> completedEvents);
     void setCPUProfilingPath(bool isCPUPath) { this->profilingCpuPath = isCPUPath; }
     bool isCPUProfilingPath() {
         return profilingCpuPath;
@@ -242,6 +259,23 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
         return cmdQueue;
     }
 
+    void setMemoryAccessSet(std::unique_ptr<MemoryAccessSet> accessSet) {
+        memoryAccessSet = std::move(accessSet);
+    }
+
+    const MemoryAccessSet *peekMemoryAccessSet() const {
+        return memoryAccessSet.get();
+    }
+
+    void setCsrDependencies(const CsrDependencies &dependencies) {
+        csrDependencies = dependencies;
+    }
+
+    // adds task counts this event waits for on each csr, including its own one
+    void collectCsrDependencies(CsrDependencies &dependencies) const;
+    // true when tag of the csr executing this event already reached its task count
+    bool isCompletedOnCsr() const;
+
     cl_command_type getCommandType() {
         return cmdType;
     }
@@ -337,8 +371,11 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
         }
     }
 
+    static void releaseToStoragePool(Event *event);
+
     // executes all callbacks associated with this event
     void executeCallbacks(int32_t executionStatus);
+    void detachCallbacks(int32_t executionStatus, std::vector<Callback *> &detachedCallbacks);
 
     // transitions event to new execution state
     // guarantees that newStatus <= oldStatus
@@ -368,7 +405,7 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     // Timestamps
     bool profilingEnabled;
     bool profilingCpuPath;
-    bool dataCalculated;
+    std::atomic<bool> dataCalculated;
     TimeStampData queueTimeStamp;
     TimeStampData submitTimeStamp;
     uint64_t startTimeStamp;
@@ -383,6 +420,11 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     std::atomic<int> parentCount;
     //event parents
     std::vector<Event *> parentEvents;
+    //allocations accessed by the enqueue that produced this event, used for out of order hazard tracking
+    std::unique_ptr<MemoryAccessSet> memoryAccessSet;
+    //still running dependencies of the enqueue that produced this event, used for cross queue dependency tracking
+    CsrDependencies csrDependencies;
+    std::shared_ptr<EventPool> storagePool;
 
   private:
     // can be accessed only with updateTaskCount
@@ -21,17 +21,33 @@
  */
 
 #include "runtime/api/cl_types.h"
+#include "runtime/command_queue/command_queue.h"
 #include "runtime/context/context.h"
 #include "runtime/event/event_builder.h"
+#include "runtime/event/event_pool.h"
 #include "runtime/event/user_event.h"
 #include "runtime/helpers/debug_helpers.h"
 
+#include <new>
+
 namespace OCLRT {
 EventBuilder::~EventBuilder() {
     UNRECOVERABLE_IF((this->event == nullptr) && ((parentEvents.size() != 0U)));
     finalize();
 }
 
+void EventBuilder::createPooledEvent(CommandQueue *cmdQueue, cl_command_type cmdType, uint32_t taskLevel, uint32_t taskCount) {
+    auto context = cmdQueue->getContextPtr();
+    if ((context == nullptr) || (context->getEventPool() == nullptr)) {
+        create<Event>(cmdQueue, cmdType, taskLevel, taskCount);
+        return;
+    }
+
+    auto eventPool = context->getEventPool();
+    event = ::new (eventPool->obtainStorage()) Event(cmdQueue, cmdType, taskLevel, taskCount);
+    event->setStoragePool(std::move(eventPool));
+}
+
 void EventBuilder::addParentEvent(Event &newParentEvent) {
     bool duplicate = false;
     for (Event *parent : parentEvents) {
@@ -28,6 +28,7 @@
 
 namespace OCLRT {
 
+class CommandQueue;
 class Event;
 
 class EventBuilder {
@@ -37,6 +38,9 @@ class EventBuilder {
         event = new EventType(std::forward<ArgsT>(args)...);
     }
 
+    // creates base Event reusing storage from the event pool of queue's context
+    void createPooledEvent(CommandQueue *cmdQueue, cl_command_type cmdType, uint32_t taskLevel, uint32_t taskCount);
+
     EventBuilder() = default;
     EventBuilder(const EventBuilder &) = delete;
     EventBuilder &operator=(const EventBuilder &) = delete;
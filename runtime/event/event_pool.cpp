@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/event/event.h"
+#include "runtime/event/event_pool.h"
+
+namespace OCLRT {
+EventPool::~EventPool() {
+    for (auto storage : cachedStorage) {
+        ::operator delete(storage);
+    }
+}
+
+void *EventPool::obtainStorage() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (!cachedStorage.empty()) {
+            auto storage = cachedStorage.back();
+            cachedStorage.pop_back();
+            return storage;
+        }
+    }
+    return ::operator new(sizeof(Event));
+}
+
+void EventPool::releaseStorage(void *storage) {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (cachedStorage.size() < maxCachedEvents) {
+            cachedStorage.push_back(storage);
+            return;
+        }
+    }
+    ::operator delete(storage);
+}
+
+size_t EventPool::peekNumCachedEvents() {
+    std::unique_lock<std::mutex> lock(mtx);
+    return cachedStorage.size();
+}
+} // namespace OCLRT
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+
+// Recycles storage of Event objects created for enqueues to avoid heap traffic
+// in pipelines requesting an event per enqueue
+class EventPool {
+  public:
+    EventPool(size_t maxCachedEvents) : maxCachedEvents(maxCachedEvents) {}
+    ~EventPool();
+
+    EventPool(const EventPool &) = delete;
+    EventPool &operator=(const EventPool &) = delete;
+
+    void *obtainStorage();
+    void releaseStorage(void *storage);
+
+    size_t peekNumCachedEvents();
+    size_t peekMaxCachedEvents() const {
+        return maxCachedEvents;
+    }
+
+  protected:
+    std::mutex mtx;
+    std::vector<void *> cachedStorage;
+    size_t maxCachedEvents;
+};
+} // namespace OCLRT
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/dispatch_geometry_cache.h"
+#include "runtime/kernel/kernel.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+namespace OCLRT {
+
+DispatchGeometryCache::Key::Key(const Kernel &kernel, uint32_t workDim, const size_t *gws, const size_t *elws, const size_t *offset)
+    : workDim(workDim), gws(gws), elws(elws), offset(offset), slmTotalSize(kernel.slmTotalSize) {
+    workSizeAlgorithm = (DebugManager.flags.EnableComputeWorkSizeND.get() ? 1u : 0u) |
+                        (DebugManager.flags.EnableComputeWorkSizeSquared.get() ? 2u : 0u);
+}
+
+bool DispatchGeometryCache::Key::operator==(const Key &other) const {
+    return workDim == other.workDim && gws == other.gws && elws == other.elws && offset == other.offset &&
+           slmTotalSize == other.slmTotalSize && workSizeAlgorithm == other.workSizeAlgorithm;
+}
+
+bool DispatchGeometryCache::restore(const Kernel &kernel, uint32_t workDim, const size_t *gws, const size_t *elws, const size_t *offset, MultiDispatchInfo &target) {
+    Key key(kernel, workDim, gws, elws, offset);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto &entry : entries) {
+        if (entry.key == key) {
+            for (auto &dispatchInfo : entry.dispatchInfos) {
+                target.push(dispatchInfo);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void DispatchGeometryCache::store(const Kernel &kernel, uint32_t workDim, const size_t *gws, const size_t *elws, const size_t *offset,
+                                  const MultiDispatchInfo &source, size_t firstDispatch) {
+    Entry entry = {Key(kernel, workDim, gws, elws, offset), std::vector<DispatchInfo>(source.begin() + firstDispatch, source.end())};
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (entries.size() < maxEntries) {
+        entries.push_back(std::move(entry));
+        return;
+    }
+    entries[nextVictim] = std::move(entry);
+    nextVictim = (nextVictim + 1) % maxEntries;
+}
+} // namespace OCLRT
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/helpers/dispatch_info.h"
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+class Kernel;
+
+// Baked dispatch infos (LWS, number of work groups and walker split) of the most recent geometries a kernel was
+// enqueued with, so repeated enqueues of the same geometry skip work size computation
+class DispatchGeometryCache {
+  public:
+    static const size_t maxEntries = 4;
+
+    bool restore(const Kernel &kernel, uint32_t workDim, const size_t *gws, const size_t *elws, const size_t *offset, MultiDispatchInfo &target);
+    void store(const Kernel &kernel, uint32_t workDim, const size_t *gws, const size_t *elws, const size_t *offset,
+               const MultiDispatchInfo &source, size_t firstDispatch);
+
+    size_t peekNumEntries() const { return entries.size(); }
+
+  protected:
+    struct Key {
+        Key(const Kernel &kernel, uint32_t workDim, const size_t *gws, const size_t *elws, const size_t *offset);
+        bool operator==(const Key &other) const;
+
+        uint32_t workDim;
+        Vec3<size_t> gws;
+        Vec3<size_t> elws;
+        Vec3<size_t> offset;
+        // kernel and debug state the computed work size depends on
+        uint32_t slmTotalSize;
+        uint32_t workSizeAlgorithm;
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<DispatchInfo> dispatchInfos;
+    };
+
+    std::vector<Entry> entries;
+    size_t nextVictim = 0;
+    std::mutex mtx;
+};
+} // namespace OCLRT
@@ -61,6 +61,13 @@ void FlushStampTracker::replaceStampObject(FlushStampTrackingObj *stampObj) {
     }
 }
 
+void FlushStampTracker::releaseStampObject() {
+    if (flushStampSharedHandle) {
+        flushStampSharedHandle->decRefInternal();
+        flushStampSharedHandle = nullptr;
+    }
+}
+
 void FlushStampUpdateHelper::insert(FlushStampTrackingObj *stampObj) {
     if (stampObj) {
         flushStampsToUpdate.push_back(stampObj);
@@ -40,6 +40,7 @@ class FlushStampTracker {
     FlushStamp peekStamp() const;
     void setStamp(FlushStamp stamp);
     void replaceStampObject(FlushStampTrackingObj *stampObj);
+    void releaseStampObject();
 
     // Temporary. Method will be removed
     FlushStampTrackingObj *getStampReference() {
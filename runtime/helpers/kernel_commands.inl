@@ -315,13 +315,8 @@ size_t KernelCommandsHelper<GfxFamily>::sendIndirectState(
     DEBUG_BREAK_IF(simd != 8 && simd != 16 && simd != 32);
 
     // Copy the kernel over to the ISH
-    auto kernelStartOffset = 0llu;
     const auto &kernelInfo = kernel.getKernelInfo();
-    auto kernelAllocation = kernelInfo.getGraphicsAllocation();
-    DEBUG_BREAK_IF(!kernelAllocation);
-    if (kernelAllocation) {
-        kernelStartOffset = kernelInfo.getGraphicsAllocation()->getGpuAddressToPatch();
-    }
+    auto kernelStartOffset = kernelInfo.getKernelIsaGpuAddressToPatch();
     kernelStartOffset += kernel.getStartOffset();
     const auto &patchInfo = kernelInfo.patchInfo;
 
@@ -20,6 +20,7 @@
 * OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <cstdint>
 #include "runtime/helpers/kmd_notify_properties.h"
 
@@ -45,6 +46,10 @@ bool KmdNotifyHelper::obtainTimeoutParams(int64_t &timeoutValueOutput,
         timeoutValueOutput = properties->delayQuickKmdSleepMicroseconds;
     } else {
         timeoutValueOutput = getBaseTimeout(multiplier);
+        auto adaptiveTimeout = getAdaptiveTimeout();
+        if (adaptiveTimeout > 0) {
+            timeoutValueOutput = adaptiveTimeout;
+        }
     }
 
     return flushStampToWait != 0 && (properties->enableKmdNotify || !acLineConnected);
@@ -80,3 +85,59 @@ void KmdNotifyHelper::overrideFromDebugVariable(int32_t debugVariableValue, bool
         destination = !!(debugVariableValue);
     }
 }
+
+void KmdNotifyHelper::notifyFlush(uint32_t flushedTaskCount) {
+    if (adaptiveTimeoutPercentile <= 0) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(latencyMtx);
+    trackedFlushes[nextTrackedFlush] = {flushedTaskCount, getMicrosecondsSinceEpoch()};
+    nextTrackedFlush = (nextTrackedFlush + 1) % KmdNotifyConstants::trackedFlushes;
+}
+
+void KmdNotifyHelper::notifyCompletion(uint32_t completedTaskCount, uint32_t taskCountAtWaitStart) {
+    if (adaptiveTimeoutPercentile <= 0) {
+        return;
+    }
+    auto now = getMicrosecondsSinceEpoch();
+    std::unique_lock<std::mutex> lock(latencyMtx);
+    for (auto &flush : trackedFlushes) {
+        if ((flush.timestampUs != 0) && (flush.taskCount <= completedTaskCount)) {
+            if (flush.taskCount > taskCountAtWaitStart) {
+                completionLatencies[numCompletionLatencies % KmdNotifyConstants::completionLatencySamples] = now - flush.timestampUs;
+                numCompletionLatencies++;
+                adaptiveTimeoutOutdated = true;
+            }
+            flush.timestampUs = 0;
+        }
+    }
+}
+
+int64_t KmdNotifyHelper::getAdaptiveTimeout() {
+    if (adaptiveTimeoutPercentile <= 0) {
+        return 0;
+    }
+    if (!adaptiveTimeoutOutdated) {
+        return adaptiveTimeout;
+    }
+
+    std::unique_lock<std::mutex> lock(latencyMtx);
+    adaptiveTimeoutOutdated = false;
+    if (numCompletionLatencies < KmdNotifyConstants::minimumCompletionLatencySamples) {
+        adaptiveTimeout = 0;
+        return 0;
+    }
+    auto latencies = completionLatencies;
+    auto numSamples = std::min(numCompletionLatencies, KmdNotifyConstants::completionLatencySamples);
+    auto percentile = std::min(adaptiveTimeoutPercentile, 100);
+    auto position = latencies.begin() + ((numSamples - 1) * percentile) / 100;
+    std::nth_element(latencies.begin(), position, latencies.begin() + numSamples);
+
+    // completions too slow to be caught by spinning go to kernel wait right away
+    int64_t timeout = std::max(*position, static_cast<int64_t>(1));
+    if (*position > KmdNotifyConstants::maxAdaptiveTimeoutMicroseconds) {
+        timeout = KmdNotifyConstants::adaptiveTimeoutForLongCompletionsMicroseconds;
+    }
+    adaptiveTimeout = timeout;
+    return timeout;
+}
@@ -23,9 +23,11 @@
 #pragma once
 #include "runtime/helpers/completion_stamp.h"
 
+#include <array>
 #include <cstdint>
 #include <chrono>
 #include <atomic>
+#include <mutex>
 
 namespace OCLRT {
 struct KmdNotifyProperties {
@@ -43,6 +45,11 @@ struct KmdNotifyProperties {
 namespace KmdNotifyConstants {
 constexpr int64_t timeoutInMicrosecondsForDisconnectedAcLine = 10000;
 constexpr uint32_t minimumTaskCountDiffToCheckAcLine = 10;
+constexpr uint32_t trackedFlushes = 16;
+constexpr uint32_t completionLatencySamples = 64;
+constexpr uint32_t minimumCompletionLatencySamples = 16;
+constexpr int64_t maxAdaptiveTimeoutMicroseconds = 5000;
+constexpr int64_t adaptiveTimeoutForLongCompletionsMicroseconds = 1;
 } // namespace KmdNotifyConstants
 
 class KmdNotifyHelper {
@@ -68,14 +75,35 @@ class KmdNotifyHelper {
         maxPowerSavingMode = true;
     }
 
+    // learns flush to completion latencies and uses the given percentile of them as timeout, 0 disables learning
+    void setAdaptiveTimeoutPercentile(int32_t percentile) { adaptiveTimeoutPercentile = percentile; }
+    void notifyFlush(uint32_t flushedTaskCount);
+    // only flushes still running when the wait started are sampled, earlier ones would measure time the app did not wait
+    void notifyCompletion(uint32_t completedTaskCount, uint32_t taskCountAtWaitStart);
+    int64_t getAdaptiveTimeout();
+
   protected:
     bool applyQuickKmdSleepForSporadicWait() const;
     int64_t getBaseTimeout(const int64_t &multiplier) const;
-    int64_t getMicrosecondsSinceEpoch() const;
+    MOCKABLE_VIRTUAL int64_t getMicrosecondsSinceEpoch() const;
 
     const KmdNotifyProperties *properties = nullptr;
     std::atomic<int64_t> lastWaitForCompletionTimestampUs{0};
     std::atomic<bool> acLineConnected{true};
     bool maxPowerSavingMode = false;
+
+    struct TrackedFlush {
+        uint32_t taskCount;
+        int64_t timestampUs;
+    };
+    int32_t adaptiveTimeoutPercentile = 0;
+    std::mutex latencyMtx;
+    std::array<TrackedFlush, KmdNotifyConstants::trackedFlushes> trackedFlushes = {};
+    uint32_t nextTrackedFlush = 0;
+    std::array<int64_t, KmdNotifyConstants::completionLatencySamples> completionLatencies = {};
+    uint32_t numCompletionLatencies = 0;
+    // percentile is recomputed only after new samples were learned
+    std::atomic<bool> adaptiveTimeoutOutdated{false};
+    std::atomic<int64_t> adaptiveTimeout{0};
 };
 } // namespace OCLRT
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/memory_access_set.h"
+#include <algorithm>
+
+namespace OCLRT {
+
+namespace {
+bool contains(const std::vector<GraphicsAllocation *> &allocations, GraphicsAllocation *allocation) {
+    return std::find(allocations.begin(), allocations.end(), allocation) != allocations.end();
+}
+
+bool intersects(const std::vector<GraphicsAllocation *> &first, const std::vector<GraphicsAllocation *> &second) {
+    for (auto allocation : first) {
+        if (contains(second, allocation)) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+void MemoryAccessSet::addRead(GraphicsAllocation *allocation) {
+    if (!contains(reads, allocation) && !contains(writes, allocation)) {
+        reads.push_back(allocation);
+    }
+}
+
+void MemoryAccessSet::addWrite(GraphicsAllocation *allocation) {
+    auto readEntry = std::find(reads.begin(), reads.end(), allocation);
+    if (readEntry != reads.end()) {
+        reads.erase(readEntry);
+    }
+    if (!contains(writes, allocation)) {
+        writes.push_back(allocation);
+    }
+}
+
+void MemoryAccessSet::merge(const MemoryAccessSet &other) {
+    untracked |= other.untracked;
+    for (auto allocation : other.writes) {
+        addWrite(allocation);
+    }
+    for (auto allocation : other.reads) {
+        addRead(allocation);
+    }
+}
+
+bool MemoryAccessSet::conflictsWith(const MemoryAccessSet &other) const {
+    if (untracked || other.untracked) {
+        return true;
+    }
+    // read after write, write after read and write after write, concurrent reads are not a hazard
+    return intersects(writes, other.writes) ||
+           intersects(writes, other.reads) ||
+           intersects(reads, other.writes);
+}
+} // namespace OCLRT
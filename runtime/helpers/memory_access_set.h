@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <vector>
+
+namespace OCLRT {
+class GraphicsAllocation;
+
+// Allocations read and written by an enqueue, used to detect true hazards between dependent enqueues
+class MemoryAccessSet {
+  public:
+    void addRead(GraphicsAllocation *allocation);
+    void addWrite(GraphicsAllocation *allocation);
+    void markUntracked() { untracked = true; }
+    void merge(const MemoryAccessSet &other);
+    bool conflictsWith(const MemoryAccessSet &other) const;
+
+    bool isUntracked() const { return untracked; }
+    const std::vector<GraphicsAllocation *> &peekReads() const { return reads; }
+    const std::vector<GraphicsAllocation *> &peekWrites() const { return writes; }
+
+  protected:
+    std::vector<GraphicsAllocation *> reads;
+    std::vector<GraphicsAllocation *> writes;
+    // memory is accessed in a way not visible through the tracked allocations
+    bool untracked = false;
+};
+} // namespace OCLRT
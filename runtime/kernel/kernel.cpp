@@ -33,8 +33,11 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/debug_helpers.h"
+#include "runtime/helpers/dispatch_geometry_cache.h"
 #include "runtime/helpers/get_info.h"
+#include "runtime/helpers/hash.h"
 #include "runtime/helpers/hw_helper.h"
+#include "runtime/helpers/memory_access_set.h"
 #include "runtime/helpers/per_thread_data.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/sampler_helpers.h"
@@ -45,6 +48,7 @@
 #include "runtime/mem_obj/pipe.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/memory_manager/surface.h"
+#include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/program/kernel_info.h"
 #include "runtime/program/printf_handler.h"
@@ -107,6 +111,7 @@ Kernel::Kernel(Program *programArg, const KernelInfo &kernelInfoArg, const Devic
       usingSharedObjArgs(false) {
     program->retain();
     imageTransformer.reset(new ImageTransformer);
+    dispatchGeometryCache.reset(new DispatchGeometryCache);
 }
 
 Kernel::~Kernel() {
@@ -201,12 +206,6 @@ cl_int Kernel::initialize() {
         if (crossThreadDataSize) {
             crossThreadData = new char[crossThreadDataSize];
 
-            if (kernelInfo.crossThreadData) {
-                memcpy_s(crossThreadData, crossThreadDataSize, kernelInfo.crossThreadData, crossThreadDataSize);
-            } else {
-                memset(crossThreadData, 0x00, crossThreadDataSize);
-            }
-
             auto crossThread = reinterpret_cast<uint32_t *>(crossThreadData);
             globalWorkOffsetX = workloadInfo.globalWorkOffsetOffsets[0] != WorkloadInfo::undefinedOffset ? ptrOffset(crossThread, workloadInfo.globalWorkOffsetOffsets[0]) : globalWorkOffsetX;
             globalWorkOffsetY = workloadInfo.globalWorkOffsetOffsets[1] != WorkloadInfo::undefinedOffset ? ptrOffset(crossThread, workloadInfo.globalWorkOffsetOffsets[1]) : globalWorkOffsetY;
@@ -237,11 +236,6 @@ cl_int Kernel::initialize() {
             dataParameterSimdSize = workloadInfo.simdSizeOffset != WorkloadInfo::undefinedOffset ? ptrOffset(crossThread, workloadInfo.simdSizeOffset) : dataParameterSimdSize;
             parentEventOffset = workloadInfo.parentEventOffset != WorkloadInfo::undefinedOffset ? ptrOffset(crossThread, workloadInfo.parentEventOffset) : parentEventOffset;
             prefferedWkgMultipleOffset = workloadInfo.prefferedWkgMultipleOffset != WorkloadInfo::undefinedOffset ? ptrOffset(crossThread, workloadInfo.prefferedWkgMultipleOffset) : prefferedWkgMultipleOffset;
-
-            *maxWorkGroupSize = static_cast<uint32_t>(device.getDeviceInfo().maxWorkGroupSize);
-            *dataParameterSimdSize = getKernelInfo().getMaxSimdSize();
-            *prefferedWkgMultipleOffset = getKernelInfo().getMaxSimdSize();
-            *parentEventOffset = WorkloadInfo::invalidParentEvent;
         }
 
         // allocate our own SSH, if necessary
@@ -251,13 +245,21 @@ cl_int Kernel::initialize() {
 
         if (sshLocalSize) {
             pSshLocal = std::make_unique<char[]>(sshLocalSize);
-
-            // copy the ssh into our local copy
-            memcpy_s(pSshLocal.get(), sshLocalSize, heapInfo.pSsh, sshLocalSize);
         }
         numberOfBindingTableStates = (patchInfo.bindingTableState != nullptr) ? patchInfo.bindingTableState->Count : 0;
         localBindingTableOffset = (patchInfo.bindingTableState != nullptr) ? patchInfo.bindingTableState->Offset : 0;
 
+        // state depending only on kernel info is computed by the first kernel and copied by the following ones
+        auto instanceTemplate = isInstanceTemplateAllowed() ? std::atomic_load(&kernelInfo.instanceTemplate) : nullptr;
+        if (instanceTemplate) {
+            applyInstanceTemplate(*instanceTemplate);
+        } else {
+            initializeFromKernelInfo();
+            if (isInstanceTemplateAllowed()) {
+                std::atomic_store(&kernelInfo.instanceTemplate, createInstanceTemplate());
+            }
+        }
+
         // patch crossthread data and ssh with inline surfaces, if necessary
         privateSurfaceSize = patchInfo.pAllocateStatelessPrivateSurface
                                  ? patchInfo.pAllocateStatelessPrivateSurface->PerThreadPrivateMemorySize
@@ -279,101 +281,164 @@ cl_int Kernel::initialize() {
             patchWithImplicitSurface(reinterpret_cast<void *>(privateSurface->getGpuAddressToPatch()), *privateSurface, *patch);
         }
 
-        if (patchInfo.pAllocateStatelessConstantMemorySurfaceWithInitialization) {
-            DEBUG_BREAK_IF(program->getConstantSurface() == nullptr);
-            uintptr_t constMemory = isBuiltIn ? (uintptr_t)program->getConstantSurface()->getUnderlyingBuffer() : (uintptr_t)program->getConstantSurface()->getGpuAddressToPatch();
+        patchBlocksSimdSize();
+
+        provideInitializationHints();
 
-            const auto &patch = patchInfo.pAllocateStatelessConstantMemorySurfaceWithInitialization;
-            patchWithImplicitSurface(reinterpret_cast<void *>(constMemory), *program->getConstantSurface(), *patch);
+        if (isParentKernel) {
+            program->allocateBlockPrivateSurfaces();
         }
 
-        if (patchInfo.pAllocateStatelessGlobalMemorySurfaceWithInitialization) {
-            DEBUG_BREAK_IF(program->getGlobalSurface() == nullptr);
-            uintptr_t globalMemory = isBuiltIn ? (uintptr_t)program->getGlobalSurface()->getUnderlyingBuffer() : (uintptr_t)program->getGlobalSurface()->getGpuAddressToPatch();
+        retVal = CL_SUCCESS;
 
-            const auto &patch = patchInfo.pAllocateStatelessGlobalMemorySurfaceWithInitialization;
-            patchWithImplicitSurface(reinterpret_cast<void *>(globalMemory), *program->getGlobalSurface(), *patch);
-        }
+    } while (false);
 
-        if (patchInfo.pAllocateStatelessEventPoolSurface) {
-            if (requiresSshForBuffers()) {
-                auto surfaceState = ptrOffset(reinterpret_cast<uintptr_t *>(getSurfaceStateHeap()),
-                                              patchInfo.pAllocateStatelessEventPoolSurface->SurfaceStateHeapOffset);
-                Buffer::setSurfaceState(&getDevice(), surfaceState, 0, nullptr);
-            }
-        }
+    return retVal;
+}
 
-        if (patchInfo.pAllocateStatelessDefaultDeviceQueueSurface) {
+void Kernel::initializeFromKernelInfo() {
+    const auto &patchInfo = kernelInfo.patchInfo;
 
-            if (requiresSshForBuffers()) {
-                auto surfaceState = ptrOffset(reinterpret_cast<uintptr_t *>(getSurfaceStateHeap()),
-                                              patchInfo.pAllocateStatelessDefaultDeviceQueueSurface->SurfaceStateHeapOffset);
-                Buffer::setSurfaceState(&getDevice(), surfaceState, 0, nullptr);
-            }
+    if (crossThreadDataSize) {
+        if (kernelInfo.crossThreadData) {
+            memcpy_s(crossThreadData, crossThreadDataSize, kernelInfo.crossThreadData, crossThreadDataSize);
+        } else {
+            memset(crossThreadData, 0x00, crossThreadDataSize);
         }
 
-        patchBlocksSimdSize();
+        *maxWorkGroupSize = static_cast<uint32_t>(device.getDeviceInfo().maxWorkGroupSize);
+        *dataParameterSimdSize = getKernelInfo().getMaxSimdSize();
+        *prefferedWkgMultipleOffset = getKernelInfo().getMaxSimdSize();
+        *parentEventOffset = WorkloadInfo::invalidParentEvent;
+    }
 
-        provideInitializationHints();
-        // resolve the new kernel info to account for kernel handlers
-        // I think by this time we have decoded the binary and know the number of args etc.
-        // double check this assumption
-        bool usingBuffers = false;
-        bool usingImages = false;
-        auto numArgs = kernelInfo.kernelArgInfo.size();
-        kernelArguments.resize(numArgs);
-        slmSizes.resize(numArgs);
-        kernelArgHandlers.resize(numArgs);
-
-        for (uint32_t i = 0; i < numArgs; ++i) {
-            storeKernelArg(i, NONE_OBJ, nullptr, nullptr, 0);
-            slmSizes[i] = 0;
-
-            // set the argument handler
-            auto &argInfo = kernelInfo.kernelArgInfo[i];
-            if (argInfo.addressQualifier == CL_KERNEL_ARG_ADDRESS_LOCAL) {
-                kernelArgHandlers[i] = &Kernel::setArgLocal;
-            } else if (argInfo.isAccelerator) {
-                kernelArgHandlers[i] = &Kernel::setArgAccelerator;
-            } else if (argInfo.typeQualifierStr.find("pipe") != std::string::npos) {
-                kernelArgHandlers[i] = &Kernel::setArgPipe;
-                kernelArguments[i].type = PIPE_OBJ;
-            } else if ((argInfo.typeStr.find("*") != std::string::npos) || argInfo.isBuffer) {
-                kernelArgHandlers[i] = &Kernel::setArgBuffer;
-                kernelArguments[i].type = BUFFER_OBJ;
-                usingBuffers = true;
-                this->auxTranslationRequired |= !kernelInfo.kernelArgInfo[i].pureStatefulBufferAccess &&
-                                                getDevice().getHardwareInfo().capabilityTable.ftrRenderCompressedBuffers;
-            } else if (argInfo.isImage) {
-                kernelArgHandlers[i] = &Kernel::setArgImage;
-                kernelArguments[i].type = IMAGE_OBJ;
-                usingImages = true;
-                DEBUG_BREAK_IF(argInfo.typeStr.find("image") == std::string::npos);
-            } else if (argInfo.isSampler) {
-                kernelArgHandlers[i] = &Kernel::setArgSampler;
-                kernelArguments[i].type = SAMPLER_OBJ;
-                DEBUG_BREAK_IF(!(*argInfo.typeStr.c_str() == '\0' || argInfo.typeStr.find("sampler") != std::string::npos));
-            } else if (argInfo.isDeviceQueue) {
-                kernelArgHandlers[i] = &Kernel::setArgDevQueue;
-                kernelArguments[i].type = DEVICE_QUEUE_OBJ;
-            } else {
-                kernelArgHandlers[i] = &Kernel::setArgImmediate;
-            }
+    if (sshLocalSize) {
+        // copy the ssh into our local copy
+        memcpy_s(pSshLocal.get(), sshLocalSize, kernelInfo.heapInfo.pSsh, sshLocalSize);
+    }
+
+    if (patchInfo.pAllocateStatelessConstantMemorySurfaceWithInitialization) {
+        DEBUG_BREAK_IF(program->getConstantSurface() == nullptr);
+        uintptr_t constMemory = isBuiltIn ? (uintptr_t)program->getConstantSurface()->getUnderlyingBuffer() : (uintptr_t)program->getConstantSurface()->getGpuAddressToPatch();
+
+        const auto &patch = patchInfo.pAllocateStatelessConstantMemorySurfaceWithInitialization;
+        patchWithImplicitSurface(reinterpret_cast<void *>(constMemory), *program->getConstantSurface(), *patch);
+    }
+
+    if (patchInfo.pAllocateStatelessGlobalMemorySurfaceWithInitialization) {
+        DEBUG_BREAK_IF(program->getGlobalSurface() == nullptr);
+        uintptr_t globalMemory = isBuiltIn ? (uintptr_t)program->getGlobalSurface()->getUnderlyingBuffer() : (uintptr_t)program->getGlobalSurface()->getGpuAddressToPatch();
+
+        const auto &patch = patchInfo.pAllocateStatelessGlobalMemorySurfaceWithInitialization;
+        patchWithImplicitSurface(reinterpret_cast<void *>(globalMemory), *program->getGlobalSurface(), *patch);
+    }
+
+    if (patchInfo.pAllocateStatelessEventPoolSurface) {
+        if (requiresSshForBuffers()) {
+            auto surfaceState = ptrOffset(reinterpret_cast<uintptr_t *>(getSurfaceStateHeap()),
+                                          patchInfo.pAllocateStatelessEventPoolSurface->SurfaceStateHeapOffset);
+            Buffer::setSurfaceState(&getDevice(), surfaceState, 0, nullptr);
         }
+    }
+
+    if (patchInfo.pAllocateStatelessDefaultDeviceQueueSurface) {
 
-        if (usingImages && !usingBuffers) {
-            usingImagesOnly = true;
+        if (requiresSshForBuffers()) {
+            auto surfaceState = ptrOffset(reinterpret_cast<uintptr_t *>(getSurfaceStateHeap()),
+                                          patchInfo.pAllocateStatelessDefaultDeviceQueueSurface->SurfaceStateHeapOffset);
+            Buffer::setSurfaceState(&getDevice(), surfaceState, 0, nullptr);
         }
+    }
 
-        if (isParentKernel) {
-            program->allocateBlockPrivateSurfaces();
+    // resolve the new kernel info to account for kernel handlers
+    // I think by this time we have decoded the binary and know the number of args etc.
+    // double check this assumption
+    bool usingBuffers = false;
+    bool usingImages = false;
+    auto numArgs = kernelInfo.kernelArgInfo.size();
+    kernelArguments.resize(numArgs);
+    argFingerprints.resize(numArgs);
+    slmSizes.resize(numArgs);
+    kernelArgHandlers.resize(numArgs);
+
+    for (uint32_t i = 0; i < numArgs; ++i) {
+        storeKernelArg(i, NONE_OBJ, nullptr, nullptr, 0);
+        slmSizes[i] = 0;
+
+        // set the argument handler
+        auto &argInfo = kernelInfo.kernelArgInfo[i];
+        if (argInfo.addressQualifier == CL_KERNEL_ARG_ADDRESS_LOCAL) {
+            kernelArgHandlers[i] = &Kernel::setArgLocal;
+        } else if (argInfo.isAccelerator) {
+            kernelArgHandlers[i] = &Kernel::setArgAccelerator;
+        } else if (argInfo.typeQualifierStr.find("pipe") != std::string::npos) {
+            kernelArgHandlers[i] = &Kernel::setArgPipe;
+            kernelArguments[i].type = PIPE_OBJ;
+        } else if ((argInfo.typeStr.find("*") != std::string::npos) || argInfo.isBuffer) {
+            kernelArgHandlers[i] = &Kernel::setArgBuffer;
+            kernelArguments[i].type = BUFFER_OBJ;
+            usingBuffers = true;
+            this->auxTranslationRequired |= !kernelInfo.kernelArgInfo[i].pureStatefulBufferAccess &&
+                                            getDevice().getHardwareInfo().capabilityTable.ftrRenderCompressedBuffers;
+        } else if (argInfo.isImage) {
+            kernelArgHandlers[i] = &Kernel::setArgImage;
+            kernelArguments[i].type = IMAGE_OBJ;
+            usingImages = true;
+            DEBUG_BREAK_IF(argInfo.typeStr.find("image") == std::string::npos);
+        } else if (argInfo.isSampler) {
+            kernelArgHandlers[i] = &Kernel::setArgSampler;
+            kernelArguments[i].type = SAMPLER_OBJ;
+            DEBUG_BREAK_IF(!(*argInfo.typeStr.c_str() == '\0' || argInfo.typeStr.find("sampler") != std::string::npos));
+        } else if (argInfo.isDeviceQueue) {
+            kernelArgHandlers[i] = &Kernel::setArgDevQueue;
+            kernelArguments[i].type = DEVICE_QUEUE_OBJ;
+        } else {
+            kernelArgHandlers[i] = &Kernel::setArgImmediate;
         }
+    }
 
-        retVal = CL_SUCCESS;
+    if (usingImages && !usingBuffers) {
+        usingImagesOnly = true;
+    }
+}
 
-    } while (false);
+bool Kernel::isInstanceTemplateAllowed() const {
+    // kernel infos decoded from a program binary do not change once the program is built
+    return kernelInfo.isValid && !isParentKernel && !isSchedulerKernel &&
+           !DebugManager.flags.DisableKernelInstanceTemplates.get();
+}
 
-    return retVal;
+std::shared_ptr<const KernelInstanceTemplate> Kernel::createInstanceTemplate() const {
+    auto instanceTemplate = std::make_shared<KernelInstanceTemplate>();
+    instanceTemplate->crossThreadData.assign(crossThreadData, crossThreadData + crossThreadDataSize);
+    if (sshLocalSize) {
+        instanceTemplate->ssh.assign(pSshLocal.get(), pSshLocal.get() + sshLocalSize);
+    }
+    instanceTemplate->kernelArguments = kernelArguments;
+    instanceTemplate->kernelArgHandlers = kernelArgHandlers;
+    instanceTemplate->usingImagesOnly = usingImagesOnly;
+    instanceTemplate->auxTranslationRequired = auxTranslationRequired;
+    return instanceTemplate;
+}
+
+void Kernel::applyInstanceTemplate(const KernelInstanceTemplate &instanceTemplate) {
+    DEBUG_BREAK_IF(instanceTemplate.crossThreadData.size() != crossThreadDataSize);
+    DEBUG_BREAK_IF(instanceTemplate.ssh.size() != sshLocalSize);
+
+    if (crossThreadDataSize) {
+        memcpy_s(crossThreadData, crossThreadDataSize, instanceTemplate.crossThreadData.data(), instanceTemplate.crossThreadData.size());
+    }
+    if (sshLocalSize) {
+        memcpy_s(pSshLocal.get(), sshLocalSize, instanceTemplate.ssh.data(), instanceTemplate.ssh.size());
+    }
+
+    auto numArgs = instanceTemplate.kernelArguments.size();
+    kernelArguments = instanceTemplate.kernelArguments;
+    argFingerprints.resize(numArgs);
+    slmSizes.resize(numArgs);
+    kernelArgHandlers = instanceTemplate.kernelArgHandlers;
+    usingImagesOnly = instanceTemplate.usingImagesOnly;
+    auxTranslationRequired = instanceTemplate.auxTranslationRequired;
 }
 
 cl_int Kernel::cloneKernel(Kernel *pSourceKernel) {
@@ -533,6 +598,15 @@ cl_int Kernel::getArgInfo(cl_uint argIndx, cl_kernel_arg_info paramName, size_t
     return retVal;
 }
 
+size_t Kernel::getMaxKernelWorkGroupSize() const {
+    size_t maxWorkgroupSize = this->device.getDeviceInfo().maxWorkGroupSize;
+    if (DebugManager.flags.UseMaxSimdSizeToDeduceMaxWorkgroupSize.get()) {
+        auto divisionSize = 32 / kernelInfo.patchInfo.executionEnvironment->LargestCompiledSIMDSize;
+        maxWorkgroupSize /= divisionSize;
+    }
+    return maxWorkgroupSize;
+}
+
 cl_int Kernel::getWorkGroupInfo(cl_device_id device, cl_kernel_work_group_info paramName,
                                 size_t paramValueSize, void *paramValue,
                                 size_t *paramValueSizeRet) const {
@@ -551,11 +625,7 @@ cl_int Kernel::getWorkGroupInfo(cl_device_id device, cl_kernel_work_group_info p
 
     switch (paramName) {
     case CL_KERNEL_WORK_GROUP_SIZE:
-        maxWorkgroupSize = this->device.getDeviceInfo().maxWorkGroupSize;
-        if (DebugManager.flags.UseMaxSimdSizeToDeduceMaxWorkgroupSize.get()) {
-            auto divisionSize = 32 / patchInfo.executionEnvironment->LargestCompiledSIMDSize;
-            maxWorkgroupSize /= divisionSize;
-        }
+        maxWorkgroupSize = getMaxKernelWorkGroupSize();
         retVal = info.set<size_t>(maxWorkgroupSize);
         break;
 
@@ -711,6 +781,13 @@ size_t Kernel::getKernelHeapSize() const {
     return kernelInfo.heapInfo.pKernelHeader->KernelHeapSize;
 }
 
+uint64_t Kernel::getIsaHash() {
+    if (isaHash == 0) {
+        isaHash = Hash::hash(reinterpret_cast<const char *>(getKernelHeap()), getKernelHeapSize());
+    }
+    return isaHash;
+}
+
 void Kernel::substituteKernelHeap(void *newKernelHeap, size_t newKernelHeapSize) {
     KernelInfo *pKernelInfo = const_cast<KernelInfo *>(&kernelInfo);
     void **pKernelHeap = const_cast<void **>(&pKernelInfo->heapInfo.pKernelHeap);
@@ -718,12 +795,20 @@ void Kernel::substituteKernelHeap(void *newKernelHeap, size_t newKernelHeapSize)
     SKernelBinaryHeaderCommon *pHeader = const_cast<SKernelBinaryHeaderCommon *>(pKernelInfo->heapInfo.pKernelHeader);
     pHeader->KernelHeapSize = static_cast<uint32_t>(newKernelHeapSize);
     pKernelInfo->isKernelHeapSubstituted = true;
+    isaHash = 0;
+
+    auto memoryManager = device.getMemoryManager();
+    if (pKernelInfo->isKernelAllocationShared) {
+        // ISA heap is shared with other kernels of the program, substituted kernel gets its own allocation
+        pKernelInfo->kernelAllocation = nullptr;
+        pKernelInfo->createKernelAllocation(memoryManager);
+        return;
+    }
 
     auto currentAllocationSize = pKernelInfo->kernelAllocation->getUnderlyingBufferSize();
     if (currentAllocationSize >= newKernelHeapSize) {
         memcpy_s(pKernelInfo->kernelAllocation->getUnderlyingBuffer(), newKernelHeapSize, newKernelHeap, newKernelHeapSize);
     } else {
-        auto memoryManager = device.getMemoryManager();
         memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(pKernelInfo->kernelAllocation);
         pKernelInfo->kernelAllocation = nullptr;
         pKernelInfo->createKernelAllocation(memoryManager);
@@ -796,8 +881,13 @@ uint32_t Kernel::getScratchSizeValueToProgramMediaVfeState(int scratchSize) {
 cl_int Kernel::setArg(uint32_t argIndex, size_t argSize, const void *argVal) {
     cl_int retVal = CL_SUCCESS;
     bool updateExposedKernel = true;
+    ArgFingerprint fingerprint;
     if (getKernelInfo().builtinDispatchBuilder != nullptr) {
         updateExposedKernel = getKernelInfo().builtinDispatchBuilder->setExplicitArg(argIndex, argSize, argVal, retVal);
+    } else if (argIndex < argFingerprints.size() && getArgFingerprint(argIndex, argSize, argVal, fingerprint)) {
+        if (kernelArguments[argIndex].isPatched && argFingerprints[argIndex] == fingerprint) {
+            return CL_SUCCESS;
+        }
     }
     if (updateExposedKernel) {
         if (argIndex >= kernelArgHandlers.size()) {
@@ -811,11 +901,58 @@ cl_int Kernel::setArg(uint32_t argIndex, size_t argSize, const void *argVal) {
             patchedArgumentsNum++;
             kernelArguments[argIndex].isPatched = true;
         }
+        if (argIndex < argFingerprints.size()) {
+            argFingerprints[argIndex] = fingerprint;
+        }
         resolveArgs();
+    } else if (argIndex < argFingerprints.size()) {
+        // a failing handler may have partially overwritten the arg, the same value has to be set again in full
+        argFingerprints[argIndex].isValid = false;
     }
     return retVal;
 }
 
+bool Kernel::getArgFingerprint(uint32_t argIndex, size_t argSize, const void *argVal, ArgFingerprint &fingerprint) const {
+    if (DebugManager.flags.DisableKernelArgValueTracking.get() || argSize > ArgFingerprint::maxValueSize) {
+        return false;
+    }
+
+    auto argHandler = kernelArgHandlers[argIndex];
+    bool isMemObjArg = argHandler == &Kernel::setArgBuffer || argHandler == &Kernel::setArgImage || argHandler == &Kernel::setArgPipe;
+    if (!isMemObjArg && argHandler != &Kernel::setArgImmediate && argHandler != &Kernel::setArgLocal) {
+        // samplers, accelerators and device queues may be recreated under the same handle
+        return false;
+    }
+
+    fingerprint.hasValue = argVal != nullptr;
+    fingerprint.size = argSize;
+    if (argVal) {
+        memcpy_s(fingerprint.value, sizeof(fingerprint.value), argVal, argSize);
+    }
+
+    if (isMemObjArg && argVal && argSize == sizeof(cl_mem)) {
+        auto memObj = castToObject<MemObj>(*static_cast<const cl_mem *>(argVal));
+        if (memObj) {
+            if (memObj->peekSharingHandler()) {
+                // shared objects are re-patched after every acquire
+                return false;
+            }
+            if (memObj->peekClMemObjType() == CL_MEM_OBJECT_IMAGE3D) {
+                // 3d image surface states are transformed again when args are resolved
+                return false;
+            }
+            // state stamp is unique per memory object, a new object reusing a released handle is not matched
+            auto allocation = memObj->getGraphicsAllocation();
+            fingerprint.allocation = allocation;
+            fingerprint.gpuAddress = allocation ? allocation->getGpuAddress() : 0u;
+            fingerprint.stateStamp = memObj->getSurfaceStateCache().getStateStamp();
+        }
+    }
+
+    fingerprint.isValid = true;
+    return true;
+}
+
 cl_int Kernel::setArg(uint32_t argIndex, uint32_t argVal) {
     return setArg(argIndex, sizeof(argVal), &argVal);
 }
@@ -900,6 +1037,59 @@ cl_int Kernel::setArgSvmAlloc(uint32_t argIndex, void *svmPtr, GraphicsAllocatio
     return CL_SUCCESS;
 }
 
+cl_int Kernel::setArgSvmPointer(uint32_t argIndex, const void *svmPtr) {
+    if (argIndex >= getKernelArgsNumber()) {
+        return CL_INVALID_ARG_INDEX;
+    }
+
+    auto kernelArgAddressQualifier = getKernelArgAddressQualifier(argIndex);
+    if ((kernelArgAddressQualifier != CL_KERNEL_ARG_ADDRESS_GLOBAL) &&
+        (kernelArgAddressQualifier != CL_KERNEL_ARG_ADDRESS_CONSTANT)) {
+        return CL_INVALID_ARG_VALUE;
+    }
+
+    GraphicsAllocation *svmAlloc = nullptr;
+    if (svmPtr != nullptr) {
+        svmAlloc = getContext().getSVMAllocsManager()->getSVMAlloc(svmPtr);
+        if (svmAlloc == nullptr) {
+            return CL_INVALID_ARG_VALUE;
+        }
+    }
+    return setArgSvmAlloc(argIndex, const_cast<void *>(svmPtr), svmAlloc);
+}
+
+cl_int Kernel::setArgs(cl_uint numArgs, const cl_kernel_arg_desc_intel *argDescs) {
+    for (cl_uint i = 0; i < numArgs; i++) {
+        const auto &argDesc = argDescs[i];
+        cl_int retVal = CL_SUCCESS;
+
+        switch (argDesc.argKind) {
+        case CL_KERNEL_ARG_VALUE_INTEL:
+            if (argDesc.argIndex >= getKernelArgsNumber()) {
+                return CL_INVALID_ARG_INDEX;
+            }
+            retVal = checkCorrectImageAccessQualifier(argDesc.argIndex, argDesc.argSize, argDesc.argValue);
+            if (retVal != CL_SUCCESS) {
+                unsetArg(argDesc.argIndex);
+                return retVal;
+            }
+            retVal = setArg(argDesc.argIndex, argDesc.argSize, argDesc.argValue);
+            break;
+        case CL_KERNEL_ARG_SVM_POINTER_INTEL:
+            retVal = setArgSvmPointer(argDesc.argIndex, argDesc.argValue);
+            break;
+        default:
+            retVal = CL_INVALID_VALUE;
+            break;
+        }
+
+        if (retVal != CL_SUCCESS) {
+            return retVal;
+        }
+    }
+    return CL_SUCCESS;
+}
+
 void Kernel::storeKernelArg(uint32_t argIndex, kernelArgType argType, void *argObject,
                             const void *argValue, size_t argSize,
                             GraphicsAllocation *argSvmAlloc, cl_mem_flags argSvmFlags) {
@@ -909,6 +1099,8 @@ void Kernel::storeKernelArg(uint32_t argIndex, kernelArgType argType, void *argO
     kernelArguments[argIndex].size = argSize;
     kernelArguments[argIndex].pSvmAlloc = argSvmAlloc;
     kernelArguments[argIndex].svmFlags = argSvmFlags;
+    argFingerprints[argIndex].isValid = false;
+    argumentsGeneration++;
 }
 
 const void *Kernel::getKernelArg(uint32_t argIndex) const {
@@ -927,31 +1119,108 @@ void Kernel::clearKernelExecInfo() {
     kernelSvmGfxAllocations.clear();
 }
 
-inline void Kernel::makeArgsResident(CommandStreamReceiver &commandStreamReceiver) {
+void Kernel::updateArgsResidency() {
+    argsResidency.clear();
+    argsRequireSamplerCacheFlush = false;
+
+    auto addAllocation = [this](GraphicsAllocation *allocation) {
+        if (std::find(argsResidency.begin(), argsResidency.end(), allocation) == argsResidency.end()) {
+            argsResidency.push_back(allocation);
+        }
+    };
 
     auto numArgs = kernelInfo.kernelArgInfo.size();
     for (decltype(numArgs) argIndex = 0; argIndex < numArgs; argIndex++) {
         if (kernelArguments[argIndex].object) {
             if (kernelArguments[argIndex].type == SVM_ALLOC_OBJ) {
                 auto pSVMAlloc = (GraphicsAllocation *)kernelArguments[argIndex].object;
-                commandStreamReceiver.makeResident(*pSVMAlloc);
+                addAllocation(pSVMAlloc);
             } else if (Kernel::isMemObj(kernelArguments[argIndex].type)) {
                 auto clMem = const_cast<cl_mem>(static_cast<const _cl_mem *>(kernelArguments[argIndex].object));
                 auto memObj = castToObjectOrAbort<MemObj>(clMem);
                 DEBUG_BREAK_IF(memObj == nullptr);
                 if (memObj->isImageFromImage()) {
-                    commandStreamReceiver.setSamplerCacheFlushRequired(CommandStreamReceiver::SamplerCacheFlushState::samplerCacheFlushBefore);
+                    argsRequireSamplerCacheFlush = true;
                 }
-                commandStreamReceiver.makeResident(*memObj->getGraphicsAllocation());
+                addAllocation(memObj->getGraphicsAllocation());
                 if (memObj->getMcsAllocation()) {
-                    commandStreamReceiver.makeResident(*memObj->getMcsAllocation());
+                    addAllocation(memObj->getMcsAllocation());
                 }
             }
         }
     }
+    argsResidencyGeneration = argumentsGeneration;
+}
+
+void Kernel::getMemoryAccessSet(MemoryAccessSet &accessSet) {
+    // SVM exec info and device side enqueue reach memory that is not passed through kernel arguments
+    if (!kernelSvmGfxAllocations.empty() || isParentKernel) {
+        accessSet.markUntracked();
+        return;
+    }
+
+    if (privateSurface) {
+        accessSet.addWrite(privateSurface);
+    }
+    if (program->getConstantSurface()) {
+        accessSet.addRead(program->getConstantSurface());
+    }
+    if (program->getGlobalSurface()) {
+        accessSet.addWrite(program->getGlobalSurface());
+    }
+
+    auto addAccess = [&accessSet](GraphicsAllocation *allocation, bool readOnly) {
+        if (readOnly) {
+            accessSet.addRead(allocation);
+        } else {
+            accessSet.addWrite(allocation);
+        }
+    };
+
+    auto numArgs = kernelInfo.kernelArgInfo.size();
+    for (decltype(numArgs) argIndex = 0; argIndex < numArgs; argIndex++) {
+        auto &argument = kernelArguments[argIndex];
+        if (argument.type == SVM_OBJ) {
+            if (argument.pSvmAlloc) {
+                addAccess(argument.pSvmAlloc, (argument.svmFlags & CL_MEM_READ_ONLY) != 0);
+            } else {
+                accessSet.markUntracked();
+            }
+        } else if (argument.type == SVM_ALLOC_OBJ && argument.object) {
+            addAccess((GraphicsAllocation *)argument.object, false);
+        } else if (Kernel::isMemObj(argument.type) && argument.object) {
+            auto clMem = const_cast<cl_mem>(static_cast<const _cl_mem *>(argument.object));
+            auto memObj = castToObjectOrAbort<MemObj>(clMem);
+            auto readOnly = (memObj->getFlags() & CL_MEM_READ_ONLY) != 0 ||
+                            kernelInfo.kernelArgInfo[argIndex].accessQualifier == CL_KERNEL_ARG_ACCESS_READ_ONLY;
+            addAccess(memObj->getGraphicsAllocation(), readOnly);
+            if (memObj->getMcsAllocation()) {
+                addAccess(memObj->getMcsAllocation(), readOnly);
+            }
+        }
+    }
+}
+
+inline void Kernel::makeArgsResident(CommandStreamReceiver &commandStreamReceiver) {
+    // shared objects may swap their allocations on acquire, so they are resolved on every enqueue
+    if (argsResidencyGeneration != argumentsGeneration || usingSharedObjArgs) {
+        updateArgsResidency();
+    }
+    if (argsRequireSamplerCacheFlush) {
+        commandStreamReceiver.setSamplerCacheFlushRequired(CommandStreamReceiver::SamplerCacheFlushState::samplerCacheFlushBefore);
+    }
+    for (auto allocation : argsResidency) {
+        commandStreamReceiver.makeResident(*allocation);
+    }
 }
 
 void Kernel::makeResident(CommandStreamReceiver &commandStreamReceiver) {
+    auto memoryManager = commandStreamReceiver.getMemoryManager();
+    if (memoryManager) {
+        // private, constant, global and ISA allocations on top of SVM exec info and arguments
+        memoryManager->reserveResidencyAllocations(4 + kernelSvmGfxAllocations.size() + kernelArguments.size());
+    }
+
     if (privateSurface) {
         commandStreamReceiver.makeResident(*privateSurface);
     }
@@ -1437,6 +1706,8 @@ void Kernel::unsetArg(uint32_t argIndex) {
         patchedArgumentsNum--;
         kernelArguments[argIndex].isPatched = false;
     }
+    argFingerprints[argIndex].isValid = false;
+    argumentsGeneration++;
 }
 
 void Kernel::createReflectionSurface() {
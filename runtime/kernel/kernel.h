@@ -31,13 +31,20 @@
 #include "runtime/program/program.h"
 #include "runtime/program/kernel_info.h"
 #include "runtime/os_interface/debug_settings_manager.h"
+#include "public/cl_ext_private.h"
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <vector>
 
 namespace OCLRT {
 struct CompletionStamp;
+struct KernelInstanceTemplate;
 class Buffer;
+class DispatchGeometryCache;
 class GraphicsAllocation;
 class ImageTransformer;
+class MemoryAccessSet;
 class Surface;
 class PrintfHandler;
 
@@ -118,6 +125,7 @@ class Kernel : public BaseObject<_cl_kernel> {
     }
 
     bool isAuxTranslationRequired() const { return auxTranslationRequired; }
+    DispatchGeometryCache &getDispatchGeometryCache() { return *dispatchGeometryCache; }
 
     char *getCrossThreadData() const {
         return crossThreadData;
@@ -138,6 +146,8 @@ class Kernel : public BaseObject<_cl_kernel> {
     cl_int setArg(uint32_t argIndex, size_t argSize, const void *argVal);
     cl_int setArgSvm(uint32_t argIndex, size_t svmAllocSize, void *svmPtr, GraphicsAllocation *svmAlloc = nullptr, cl_mem_flags svmFlags = 0);
     cl_int setArgSvmAlloc(uint32_t argIndex, void *svmPtr, GraphicsAllocation *svmAlloc);
+    cl_int setArgSvmPointer(uint32_t argIndex, const void *svmPtr);
+    cl_int setArgs(cl_uint numArgs, const cl_kernel_arg_desc_intel *argDescs);
 
     void setKernelExecInfo(GraphicsAllocation *argValue);
     void clearKernelExecInfo();
@@ -150,6 +160,7 @@ class Kernel : public BaseObject<_cl_kernel> {
 
     cl_int getWorkGroupInfo(cl_device_id device, cl_kernel_work_group_info paramName,
                             size_t paramValueSize, void *paramValue, size_t *paramValueSizeRet) const;
+    size_t getMaxKernelWorkGroupSize() const;
 
     cl_int getSubGroupInfo(cl_kernel_sub_group_info paramName,
                            size_t inputValueSize, const void *inputValue,
@@ -162,6 +173,7 @@ class Kernel : public BaseObject<_cl_kernel> {
     const void *getDynamicStateHeap() const;
 
     size_t getKernelHeapSize() const;
+    uint64_t getIsaHash();
     size_t getSurfaceStateHeapSize() const;
     size_t getDynamicStateHeapSize() const;
     size_t getNumberOfBindingTableStates() const;
@@ -182,6 +194,11 @@ class Kernel : public BaseObject<_cl_kernel> {
         return kernelArguments;
     }
 
+    // Incremented whenever any argument is modified, stays the same when nothing changed between enqueues
+    uint64_t getArgumentsGeneration() const {
+        return argumentsGeneration;
+    }
+
     const std::vector<GraphicsAllocation *> &getKernelSvmGfxAllocations() const {
         return kernelSvmGfxAllocations;
     }
@@ -297,6 +314,7 @@ class Kernel : public BaseObject<_cl_kernel> {
     //residency for kernel surfaces
     MOCKABLE_VIRTUAL void makeResident(CommandStreamReceiver &commandStreamReceiver);
     MOCKABLE_VIRTUAL void getResidency(std::vector<Surface *> &dst);
+    void getMemoryAccessSet(MemoryAccessSet &accessSet);
     bool requiresCoherency();
     void resetSharedObjectsPatchAddresses();
     bool isUsingSharedObjArgs() { return usingSharedObjArgs; }
@@ -457,7 +475,34 @@ class Kernel : public BaseObject<_cl_kernel> {
     };
 
   protected:
+    // Describes the value an argument was set with, setting the same value again is a no-op
+    struct ArgFingerprint {
+        static const size_t maxValueSize = 16;
+
+        bool isValid = false;
+        bool hasValue = false;
+        size_t size = 0;
+        uint8_t value[maxValueSize] = {};
+        const void *allocation = nullptr;
+        uint64_t gpuAddress = 0;
+        uint64_t stateStamp = 0;
+
+        bool operator==(const ArgFingerprint &other) const {
+            return isValid && other.isValid && hasValue == other.hasValue && size == other.size &&
+                   allocation == other.allocation && gpuAddress == other.gpuAddress && stateStamp == other.stateStamp &&
+                   (!hasValue || memcmp(value, other.value, size) == 0);
+        }
+    };
+
+    bool getArgFingerprint(uint32_t argIndex, size_t argSize, const void *argVal, ArgFingerprint &fingerprint) const;
+
+    void initializeFromKernelInfo();
+    bool isInstanceTemplateAllowed() const;
+    std::shared_ptr<const KernelInstanceTemplate> createInstanceTemplate() const;
+    void applyInstanceTemplate(const KernelInstanceTemplate &instanceTemplate);
+
     void makeArgsResident(CommandStreamReceiver &commandStreamReceiver);
+    void updateArgsResidency();
 
     void *patchBufferOffset(const KernelArgInfo &argInfo, void *svmPtr, GraphicsAllocation *svmAlloc);
 
@@ -479,6 +524,7 @@ class Kernel : public BaseObject<_cl_kernel> {
     const KernelInfo &kernelInfo;
 
     std::vector<SimpleKernelArgInfo> kernelArguments;
+    std::vector<ArgFingerprint> argFingerprints;
     std::vector<KernelArgHandler> kernelArgHandlers;
     std::vector<GraphicsAllocation *> kernelSvmGfxAllocations;
 
@@ -500,8 +546,30 @@ class Kernel : public BaseObject<_cl_kernel> {
     bool auxTranslationRequired = false;
     uint32_t patchedArgumentsNum = 0;
     uint32_t startOffset = 0;
+    uint64_t argumentsGeneration = 0;
+
+    // allocations backing current arguments, deduplicated; rebuilt when argumentsGeneration changes
+    std::vector<GraphicsAllocation *> argsResidency;
+    uint64_t argsResidencyGeneration = std::numeric_limits<uint64_t>::max();
+    bool argsRequireSamplerCacheFlush = false;
+
+    // hash of the kernel ISA, computed on first use
+    uint64_t isaHash = 0;
 
     std::vector<PatchInfoData> patchInfoDataList;
     std::unique_ptr<ImageTransformer> imageTransformer;
+    std::unique_ptr<DispatchGeometryCache> dispatchGeometryCache;
+};
+
+// Initial kernel state that depends only on the kernel info: cross-thread data and surface state heap with
+// program-scope surfaces patched, plus the argument handler table. Captured when the first kernel is created
+// from a kernel info and copied into later kernels instead of being recomputed.
+struct KernelInstanceTemplate {
+    std::vector<char> crossThreadData;
+    std::vector<char> ssh;
+    std::vector<Kernel::SimpleKernelArgInfo> kernelArguments;
+    std::vector<Kernel::KernelArgHandler> kernelArgHandlers;
+    bool usingImagesOnly = false;
+    bool auxTranslationRequired = false;
 };
 } // namespace OCLRT
@@ -451,6 +451,8 @@ void Buffer::setSurfaceState(const Device *device,
                              GraphicsAllocation *gfxAlloc,
                              cl_mem_flags flags) {
     auto buffer = Buffer::createBufferHwFromDevice(device, flags, svmSize, svmPtr, svmPtr, gfxAlloc, false, false, false);
+    // temporary buffer, nothing to reuse the encoding for
+    buffer->getSurfaceStateCache().setEnabled(false);
     buffer->setArgStateful(surfaceState, false);
     buffer->graphicsAllocation = nullptr;
     delete buffer;
@@ -159,6 +159,7 @@ class BufferHw : public Buffer {
                  zeroCopy, isHostPtrSVM, isObjectRedescribed) {}
 
     void setArgStateful(void *memory, bool forceNonAuxMode) override;
+    void encodeArgStateful(void *memory, bool forceNonAuxMode);
 
     static Buffer *create(Context *context,
                           cl_mem_flags flags,
@@ -42,6 +42,13 @@ union SURFACE_STATE_BUFFER_LENGTH {
 
 template <typename GfxFamily>
 void BufferHw<GfxFamily>::setArgStateful(void *memory, bool forceNonAuxMode) {
+    using RENDER_SURFACE_STATE = typename GfxFamily::RENDER_SURFACE_STATE;
+    surfaceStateCache.encode(reinterpret_cast<RENDER_SURFACE_STATE *>(memory), forceNonAuxMode ? 1u : 0u, getSurfaceStateAllocationState(),
+                             [&](RENDER_SURFACE_STATE *surfaceState) { encodeArgStateful(surfaceState, forceNonAuxMode); });
+}
+
+template <typename GfxFamily>
+void BufferHw<GfxFamily>::encodeArgStateful(void *memory, bool forceNonAuxMode) {
     using RENDER_SURFACE_STATE = typename GfxFamily::RENDER_SURFACE_STATE;
     using SURFACE_FORMAT = typename RENDER_SURFACE_STATE::SURFACE_FORMAT;
     using AUXILIARY_SURFACE_MODE = typename RENDER_SURFACE_STATE::AUXILIARY_SURFACE_MODE;
@@ -146,7 +146,10 @@ class Image : public MemObj {
     ImageCreatFunc createFunction;
 
     uint32_t getQPitch() { return qPitch; }
-    void setQPitch(uint32_t qPitch) { this->qPitch = qPitch; }
+    void setQPitch(uint32_t qPitch) {
+        this->qPitch = qPitch;
+        surfaceStateCache.invalidate();
+    }
     size_t getHostPtrRowPitch() const { return hostPtrRowPitch; }
     void setHostPtrRowPitch(size_t pitch) { this->hostPtrRowPitch = pitch; }
     size_t getHostPtrSlicePitch() const { return hostPtrSlicePitch; }
@@ -154,31 +157,47 @@ class Image : public MemObj {
     size_t getImageCount() const { return imageCount; }
     void setImageCount(size_t imageCount) { this->imageCount = imageCount; }
     bool allowTiling() const override { return this->isTiledImage; }
-    void setImageRowPitch(size_t rowPitch) { imageDesc.image_row_pitch = rowPitch; }
+    void setImageRowPitch(size_t rowPitch) {
+        imageDesc.image_row_pitch = rowPitch;
+        surfaceStateCache.invalidate();
+    }
     void setImageSlicePitch(size_t slicePitch) { imageDesc.image_slice_pitch = slicePitch; }
     void setSurfaceOffsets(uint64_t offset, uint32_t xOffset, uint32_t yOffset, uint32_t yOffsetForUVPlane) {
         surfaceOffsets.offset = offset;
         surfaceOffsets.xOffset = xOffset;
         surfaceOffsets.yOffset = yOffset;
         surfaceOffsets.yOffsetForUVplane = yOffsetForUVPlane;
+        surfaceStateCache.invalidate();
     }
     void getSurfaceOffsets(SurfaceOffsets &surfaceOffsetsOut) { surfaceOffsetsOut = this->surfaceOffsets; }
 
-    void setCubeFaceIndex(uint32_t index) { cubeFaceIndex = index; }
+    void setCubeFaceIndex(uint32_t index) {
+        cubeFaceIndex = index;
+        surfaceStateCache.invalidate();
+    }
     uint32_t getCubeFaceIndex() { return cubeFaceIndex; }
     void setMediaPlaneType(cl_uint type) { mediaPlaneType = type; }
     cl_uint getMediaPlaneType() const { return mediaPlaneType; }
     int peekBaseMipLevel() { return baseMipLevel; }
-    void setBaseMipLevel(int level) { this->baseMipLevel = level; }
+    void setBaseMipLevel(int level) {
+        this->baseMipLevel = level;
+        surfaceStateCache.invalidate();
+    }
 
     uint32_t peekMipCount() { return mipCount; }
-    void setMipCount(uint32_t mipCountNew) { this->mipCount = mipCountNew; }
+    void setMipCount(uint32_t mipCountNew) {
+        this->mipCount = mipCountNew;
+        surfaceStateCache.invalidate();
+    }
 
     static const SurfaceFormatInfo *getSurfaceFormatFromTable(cl_mem_flags flags, const cl_image_format *imageFormat);
     static cl_int validateRegionAndOrigin(const size_t *origin, const size_t *region, const cl_image_desc &imgDesc);
 
     cl_int writeNV12Planes(const void *hostPtr, size_t hostPtrRowPitch);
-    void setMcsSurfaceInfo(McsSurfaceInfo &info) { mcsSurfaceInfo = info; }
+    void setMcsSurfaceInfo(McsSurfaceInfo &info) {
+        mcsSurfaceInfo = info;
+        surfaceStateCache.invalidate();
+    }
     const McsSurfaceInfo &getMcsSurfaceInfo() { return mcsSurfaceInfo; }
     size_t calculateOffsetForMapping(const MemObjOffsetArray &origin) const override;
 
@@ -277,6 +296,7 @@ class ImageHw : public Image {
     size_t getHostPtrRowPitchForMap(uint32_t mipLevel) override;
     size_t getHostPtrSlicePitchForMap(uint32_t mipLevel) override;
     void setImageArg(void *memory, bool setAsMediaBlockImage, uint32_t mipLevel) override;
+    void encodeImageArg(RENDER_SURFACE_STATE *surfaceState, bool setAsMediaBlockImage, uint32_t mipLevel);
     void setAuxParamsForMultisamples(RENDER_SURFACE_STATE *surfaceState);
     void setAuxParamsForCCS(RENDER_SURFACE_STATE *surfaceState, Gmm *gmm);
     MOCKABLE_VIRTUAL void setClearColorParams(RENDER_SURFACE_STATE *surfaceState, const Gmm *gmm);
@@ -42,8 +42,14 @@ union SURFACE_STATE_BUFFER_LENGTH {
 
 template <typename GfxFamily>
 void ImageHw<GfxFamily>::setImageArg(void *memory, bool setAsMediaBlockImage, uint32_t mipLevel) {
+    uint64_t variant = (static_cast<uint64_t>(mipLevel) << 1) | (setAsMediaBlockImage ? 1u : 0u);
+    surfaceStateCache.encode(reinterpret_cast<RENDER_SURFACE_STATE *>(memory), variant, getSurfaceStateAllocationState(),
+                             [&](RENDER_SURFACE_STATE *surfaceState) { encodeImageArg(surfaceState, setAsMediaBlockImage, mipLevel); });
+}
+
+template <typename GfxFamily>
+void ImageHw<GfxFamily>::encodeImageArg(RENDER_SURFACE_STATE *surfaceState, bool setAsMediaBlockImage, uint32_t mipLevel) {
     using SURFACE_FORMAT = typename RENDER_SURFACE_STATE::SURFACE_FORMAT;
-    auto surfaceState = reinterpret_cast<RENDER_SURFACE_STATE *>(memory);
     auto gmm = getGraphicsAllocation()->gmm;
     auto gmmHelper = executionEnvironment->getGmmHelper();
 
@@ -244,6 +244,20 @@ void MemObj::resetGraphicsAllocation(GraphicsAllocation *newGraphicsAllocation)
     }
 
     graphicsAllocation = newGraphicsAllocation;
+    surfaceStateCache.invalidate();
+}
+
+SurfaceStateCache::AllocationState MemObj::getSurfaceStateAllocationState() const {
+    SurfaceStateCache::AllocationState allocationState = {};
+    allocationState.allocation = graphicsAllocation;
+    if (graphicsAllocation) {
+        allocationState.gpuAddress = graphicsAllocation->getGpuAddress();
+        allocationState.allocationType = static_cast<uint32_t>(graphicsAllocation->getAllocationType());
+        allocationState.renderCompressed = graphicsAllocation->gmm && graphicsAllocation->gmm->isRenderCompressed;
+    } else {
+        allocationState.gpuAddress = reinterpret_cast<uint64_t>(hostPtr);
+    }
+    return allocationState;
 }
 
 bool MemObj::readMemObjFlagsInvalid() {
@@ -303,7 +317,7 @@ void MemObj::releaseAllocatedMapPtr() {
 
 void MemObj::waitForCsrCompletion() {
     if (memoryManager->csr) {
-        memoryManager->csr->waitForCompletionWithTimeout(false, TimeoutControls::maxTimeout, graphicsAllocation->taskCount);
+        memoryManager->csr->waitForCompletionWithTimeout(false, TimeoutControls::maxTimeout, graphicsAllocation->taskCount, WaitStrategyHelper::getDefaultWaitStrategy());
     }
 }
 
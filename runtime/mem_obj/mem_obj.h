@@ -26,6 +26,7 @@
 #include "runtime/helpers/mipmap.h"
 #include "runtime/sharings/sharing.h"
 #include "runtime/mem_obj/map_operations_handler.h"
+#include "runtime/mem_obj/surface_state_cache.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include <atomic>
 #include <cstdint>
@@ -92,7 +93,10 @@ class MemObj : public BaseObject<_cl_mem> {
     GraphicsAllocation *getGraphicsAllocation();
     void resetGraphicsAllocation(GraphicsAllocation *newGraphicsAllocation);
     GraphicsAllocation *getMcsAllocation() { return mcsAllocation; }
-    void setMcsAllocation(GraphicsAllocation *alloc) { mcsAllocation = alloc; }
+    void setMcsAllocation(GraphicsAllocation *alloc) {
+        mcsAllocation = alloc;
+        surfaceStateCache.invalidate();
+    }
 
     bool readMemObjFlagsInvalid();
     bool writeMemObjFlagsInvalid();
@@ -121,8 +125,11 @@ class MemObj : public BaseObject<_cl_mem> {
     cl_mem_object_type peekClMemObjType() const { return memObjectType; }
     size_t getOffset() const { return offset; }
 
+    SurfaceStateCache &getSurfaceStateCache() { return surfaceStateCache; }
+
   protected:
     void getOsSpecificMemObjectInfo(const cl_mem_info &paramName, size_t *srcParamSize, void **srcParam);
+    SurfaceStateCache::AllocationState getSurfaceStateAllocationState() const;
 
     Context *context;
     cl_mem_object_type memObjectType;
@@ -145,6 +152,7 @@ class MemObj : public BaseObject<_cl_mem> {
     GraphicsAllocation *graphicsAllocation;
     GraphicsAllocation *mcsAllocation = nullptr;
     std::shared_ptr<SharingHandler> sharingHandler;
+    SurfaceStateCache surfaceStateCache;
 
     class DestructorCallback {
       public:
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/mem_obj/surface_state_cache.h"
+
+namespace OCLRT {
+
+static std::atomic<uint64_t> stateStampCounter{0};
+
+void SurfaceStateCache::invalidate() {
+    std::lock_guard<std::mutex> lock(mtx);
+    entries.clear();
+    stateStamp = generateStateStamp();
+}
+
+uint64_t SurfaceStateCache::generateStateStamp() {
+    return ++stateStampCounter;
+}
+
+SurfaceStateCache::Entry *SurfaceStateCache::findEntry(uint64_t variant, const AllocationState &allocationState) {
+    for (auto &entry : entries) {
+        if (entry.variant == variant && entry.allocationState == allocationState) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+SurfaceStateCache::Entry *SurfaceStateCache::addEntry(uint64_t variant, const AllocationState &allocationState, const void *clearedState, const void *setState, uint32_t numDwords) {
+    Entry *entry = nullptr;
+    for (auto &existingEntry : entries) {
+        if (existingEntry.variant == variant) {
+            // encoded for a previous allocation state
+            entry = &existingEntry;
+            break;
+        }
+    }
+    if (entry == nullptr) {
+        if (entries.size() == maxEntries) {
+            entries.erase(entries.begin());
+        }
+        entries.emplace_back();
+        entry = &entries.back();
+    }
+
+    entry->variant = variant;
+    entry->allocationState = allocationState;
+    entry->numDwords = numDwords;
+
+    auto clearedDwords = reinterpret_cast<const uint32_t *>(clearedState);
+    auto setDwords = reinterpret_cast<const uint32_t *>(setState);
+    for (uint32_t i = 0; i < numDwords; i++) {
+        entry->mask[i] = ~(clearedDwords[i] ^ setDwords[i]);
+        entry->value[i] = clearedDwords[i] & entry->mask[i];
+    }
+    return entry;
+}
+
+void SurfaceStateCache::applyEntry(const Entry &entry, void *surfaceState) {
+    auto dwords = reinterpret_cast<uint32_t *>(surfaceState);
+    for (uint32_t i = 0; i < entry.numDwords; i++) {
+        dwords[i] = (dwords[i] & ~entry.mask[i]) | entry.value[i];
+    }
+}
+} // namespace OCLRT
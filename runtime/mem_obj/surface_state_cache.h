@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/os_interface/debug_settings_manager.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace OCLRT {
+
+// Caches surface state encodings of a memory object, one entry per encoding variant (e.g. aux mode or mip level).
+// Encoders only program the fields describing the memory object and leave the remaining bits of the destination
+// (coming from the kernel's surface state heap) untouched, so an entry keeps the programmed bits as mask/value pairs.
+class SurfaceStateCache {
+  public:
+    static const size_t maxSurfaceStateDwords = 16;
+    static const size_t maxEntries = 4;
+
+    // Entries are valid only for the allocation state they were encoded for
+    struct AllocationState {
+        const void *allocation;
+        uint64_t gpuAddress;
+        uint32_t allocationType;
+        bool renderCompressed;
+
+        bool operator==(const AllocationState &other) const {
+            return allocation == other.allocation && gpuAddress == other.gpuAddress &&
+                   allocationType == other.allocationType && renderCompressed == other.renderCompressed;
+        }
+    };
+
+    template <typename SurfaceStateT, typename EncoderT>
+    void encode(SurfaceStateT *surfaceState, uint64_t variant, const AllocationState &allocationState, EncoderT &&encoder) {
+        static_assert(sizeof(SurfaceStateT) <= maxSurfaceStateDwords * sizeof(uint32_t), "surface state does not fit into cache entry");
+        static_assert(sizeof(SurfaceStateT) % sizeof(uint32_t) == 0, "surface state has to consist of dwords");
+
+        if (!enabled || DebugManager.flags.DisableMemObjSurfaceStateCache.get()) {
+            encoder(surfaceState);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx);
+        auto entry = findEntry(variant, allocationState);
+        if (entry == nullptr) {
+            // bits programmed by the encoder are the same on both states, all other bits differ
+            SurfaceStateT clearedState;
+            SurfaceStateT setState;
+            memset(&clearedState, 0, sizeof(SurfaceStateT));
+            memset(&setState, 0xFF, sizeof(SurfaceStateT));
+            encoder(&clearedState);
+            encoder(&setState);
+            entry = addEntry(variant, allocationState, &clearedState, &setState, sizeof(SurfaceStateT) / sizeof(uint32_t));
+        }
+        applyEntry(*entry, surfaceState);
+    }
+
+    void invalidate();
+
+    // Unique across all caches and renewed on every invalidation, identifies the memory object state
+    // that was encoded, e.g. to detect that a kernel argument refers to the same encoding as before
+    uint64_t getStateStamp() const {
+        return stateStamp;
+    }
+
+    void setEnabled(bool enabled) {
+        this->enabled = enabled;
+    }
+
+    size_t getNumEntries() const {
+        return entries.size();
+    }
+
+  protected:
+    struct Entry {
+        uint64_t variant;
+        AllocationState allocationState;
+        uint32_t numDwords;
+        uint32_t mask[maxSurfaceStateDwords];
+        uint32_t value[maxSurfaceStateDwords];
+    };
+
+    Entry *findEntry(uint64_t variant, const AllocationState &allocationState);
+    Entry *addEntry(uint64_t variant, const AllocationState &allocationState, const void *clearedState, const void *setState, uint32_t numDwords);
+    static void applyEntry(const Entry &entry, void *surfaceState);
+    static uint64_t generateStateStamp();
+
+    std::vector<Entry> entries;
+    std::mutex mtx;
+    std::atomic<uint64_t> stateStamp{generateStateStamp()};
+    bool enabled = true;
+};
+} // namespace OCLRT
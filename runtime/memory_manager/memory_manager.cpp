@@ -267,6 +267,7 @@ void MemoryManager::freeAllocationsList(uint32_t waitTaskCount, AllocationsList
 }
 
 TagAllocator<HwTimeStamps> *MemoryManager::getEventTsAllocator() {
+    std::lock_guard<std::mutex> lock(tagAllocatorsMtx);
     if (profilingTimeStampAllocator.get() == nullptr) {
         profilingTimeStampAllocator = std::make_unique<TagAllocator<HwTimeStamps>>(this, TagCount, MemoryConstants::cacheLineSize);
     }
@@ -274,6 +275,7 @@ TagAllocator<HwTimeStamps> *MemoryManager::getEventTsAllocator() {
 }
 
 TagAllocator<HwPerfCounter> *MemoryManager::getEventPerfCountAllocator() {
+    std::lock_guard<std::mutex> lock(tagAllocatorsMtx);
     if (perfCounterAllocator.get() == nullptr) {
         perfCounterAllocator = std::make_unique<TagAllocator<HwPerfCounter>>(this, TagCount, MemoryConstants::cacheLineSize);
     }
@@ -281,6 +283,7 @@ TagAllocator<HwPerfCounter> *MemoryManager::getEventPerfCountAllocator() {
 }
 
 TagAllocator<TimestampPacket> *MemoryManager::getTimestampPacketAllocator() {
+    std::lock_guard<std::mutex> lock(tagAllocatorsMtx);
     if (timestampPacketAllocator.get() == nullptr) {
         timestampPacketAllocator = std::make_unique<TagAllocator<TimestampPacket>>(this, TagCount, MemoryConstants::cacheLineSize);
     }
@@ -291,6 +294,13 @@ void MemoryManager::pushAllocationForResidency(GraphicsAllocation *gfxAllocation
     residencyAllocations.push_back(gfxAllocation);
 }
 
+void MemoryManager::reserveResidencyAllocations(size_t count) {
+    auto requiredCapacity = residencyAllocations.size() + count;
+    if (requiredCapacity > residencyAllocations.capacity()) {
+        residencyAllocations.reserve(std::max(requiredCapacity, 2 * residencyAllocations.capacity()));
+    }
+}
+
 void MemoryManager::clearResidencyAllocations() {
     residencyAllocations.clear();
 }
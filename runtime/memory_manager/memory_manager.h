@@ -219,6 +219,7 @@ class MemoryManager {
     GraphicsAllocation *peekPaddingAllocation() { return paddingAllocation; }
 
     void pushAllocationForResidency(GraphicsAllocation *gfxAllocation);
+    void reserveResidencyAllocations(size_t count);
     void clearResidencyAllocations();
     ResidencyContainer &getResidencyAllocations() {
         return residencyAllocations;
@@ -255,6 +256,8 @@ class MemoryManager {
 
     GraphicsAllocation *allocateGraphicsMemory(const AllocationData &allocationData);
     std::recursive_mutex mtx;
+    // tag allocators are created on first use, which may come from queues recording without the csr lock
+    std::mutex tagAllocatorsMtx;
     std::unique_ptr<TagAllocator<HwTimeStamps>> profilingTimeStampAllocator;
     std::unique_ptr<TagAllocator<HwPerfCounter>> perfCounterAllocator;
     std::unique_ptr<TagAllocator<TimestampPacket>> timestampPacketAllocator;
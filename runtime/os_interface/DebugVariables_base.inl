@@ -48,6 +48,13 @@ DECLARE_DEBUG_VARIABLE(bool, DisableResourceRecycling, false, "when set to true
 DECLARE_DEBUG_VARIABLE(bool, ForceDispatchScheduler, false, "dispatches scheduler kernel instead of kernel enqueued")
 DECLARE_DEBUG_VARIABLE(bool, TrackParentEvents, false, "events track their parents")
 DECLARE_DEBUG_VARIABLE(bool, RebuildPrecompiledKernels, false, "forces driver to recompile precompiled kernels from sources")
+DECLARE_DEBUG_VARIABLE(bool, DisableKernelInfoMetadata, false, "disables restoring kernel info from precomputed metadata, patch tokens are always parsed")
+DECLARE_DEBUG_VARIABLE(bool, DisableMemObjSurfaceStateCache, false, "disables caching of buffer and image surface states, they are encoded on every kernel argument change")
+DECLARE_DEBUG_VARIABLE(bool, DisableKernelArgValueTracking, false, "disables skipping of kernel arguments set again with the same value, every call re-patches the kernel")
+DECLARE_DEBUG_VARIABLE(bool, DisableKernelInstanceTemplates, false, "disables sharing of initial kernel state between kernels created from the same kernel info, every kernel is initialized from scratch")
+DECLARE_DEBUG_VARIABLE(bool, EnableQueueLocalRecording, false, "records enqueue commands and indirect state into queue owned storage outside of the command stream receiver lock, the lock is held only to splice and flush the task")
+DECLARE_DEBUG_VARIABLE(bool, EnableOOQHazardTracking, false, "out of order queues stall between dependent enqueues only when kernel argument allocations conflict, epilogue pipe controls of batched enqueues with events may be removed")
+DECLARE_DEBUG_VARIABLE(bool, EnableCsrDependencyTracking, false, "events record task counts they depend on per command stream receiver, enqueues and waits skip dependencies already completed according to csr tag")
 DECLARE_DEBUG_VARIABLE(bool, LoopAtPlatformInitialize, false, "Adds endless loop in platform initalize, useful for debugging.")
 /*LOGGING FLAGS*/
 DECLARE_DEBUG_VARIABLE(bool, PrintDebugMessages, false, "when enabled, some debug messages will be propagated to console")
@@ -87,9 +94,14 @@ DECLARE_DEBUG_VARIABLE(bool, EnableIntelAdvancedVme, true, "Enables cl_intel_adv
 DECLARE_DEBUG_VARIABLE(bool, EnableDeferredDeleter, true, "Enables async deleter")
 DECLARE_DEBUG_VARIABLE(bool, EnableAsyncDestroyAllocations, true, "Enables async destroying graphics allocations in mem obj destructor")
 DECLARE_DEBUG_VARIABLE(bool, EnableAsyncEventsHandler, true, "Enables async events handler")
+DECLARE_DEBUG_VARIABLE(int32_t, EventStoragePoolSize, 32, "0: disabled, >0: number of released Event objects per context whose storage is kept for reuse")
+DECLARE_DEBUG_VARIABLE(int32_t, EventCallbackExecutorThreads, 0, "0: event callbacks are executed by the thread updating event status, >0: number of worker threads executing event callbacks")
 DECLARE_DEBUG_VARIABLE(bool, EnableForcePin, true, "Enables early pinning for memory object")
 DECLARE_DEBUG_VARIABLE(bool, EnableComputeWorkSizeND, true, "Enables diffrent algorithm to compute local work size")
 DECLARE_DEBUG_VARIABLE(bool, EnableComputeWorkSizeSquared, false, "Enables algorithm to compute the most squared work group as possible")
+DECLARE_DEBUG_VARIABLE(bool, EnableLwsAutotuning, false, "Times local work size candidates for kernels enqueued without local work size on profiling queues and keeps the fastest")
+DECLARE_DEBUG_VARIABLE(int32_t, LwsAutotuningCandidates, 4, "Max number of local work size candidates tried per kernel and global work size")
+DECLARE_DEBUG_VARIABLE(int32_t, LwsAutotuningSamplesPerCandidate, 2, "Number of timed enqueues per local work size candidate")
 DECLARE_DEBUG_VARIABLE(bool, EnableVaLibCalls, true, "Enable cl-va sharing lib calls")
 DECLARE_DEBUG_VARIABLE(int32_t, EnableStatelessToStatefulBufferOffsetOpt, -1, "-1: dont override, 0: disable, 1: enable, Enables buffer-offset improvement of the stateless to stateful optimization")
 DECLARE_DEBUG_VARIABLE(int32_t, CreateMultipleDevices, 0, "0: default - disable, 1+: Driver will create multiple (N) devices during initialization.")
@@ -98,6 +110,8 @@ DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableKmdNotify, -1, "-1: dont override,
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideKmdNotifyDelayMicroseconds, -1, "-1: dont override, 0: infinite timeout, >0: timeout in microseconds")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableQuickKmdSleep, -1, "-1: dont override, 0: disable, 1: enable. It works only when Kmd Notify is enabled.")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideQuickKmdSleepDelayMicroseconds, -1, "-1: dont override, 0: infinite timeout, >0: timeout in microseconds")
+DECLARE_DEBUG_VARIABLE(int32_t, AdaptiveKmdNotifyTimeoutPercentile, 0, "0: disabled, 1-100: learn flush to completion latencies and use this percentile of them as Kmd Notify timeout")
+DECLARE_DEBUG_VARIABLE(int32_t, OverrideWaitStrategy, -1, "-1: dont override, 0: yield, 1: spin, 2: exponential backoff, 3: sleep, 4: adaptive. Strategy used when polling for task count completion")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableQuickKmdSleepForSporadicWaits, -1, "-1: dont override, 0: disable, 1: enable. It works only when QuickKmdSleep is enabled.")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideDelayQuickKmdSleepForSporadicWaitsMicroseconds, -1, "-1: dont override, >0: timeout in microseconds")
 DECLARE_DEBUG_VARIABLE(int32_t, CsrDispatchMode, 0, "Chooses DispatchMode for Csr")
@@ -109,4 +123,5 @@ DECLARE_DEBUG_VARIABLE(int32_t, NodeOrdinal, -1, "-1: default do not override, 0
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideThreadArbitrationPolicy, -1, "-1 (dont override) or any valid config (0: Age Based, 1: Round Robin)")
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideAubDeviceId, -1, "-1 dont override, any other: use this value for AUB generation device id")
 DECLARE_DEBUG_VARIABLE(bool, UseMaxSimdSizeToDeduceMaxWorkgroupSize, false, "With this flag on, max workgroup size is deduced using SIMD32 instead of SIMD8, this causes the max wkg size to be 4 times bigger")
+DECLARE_DEBUG_VARIABLE(int32_t, CpuGpuTimeModelValidityMicroseconds, 10000, "0: disabled, >0: time for which CPU/GPU time queries are served from the calibrated clock model before sampling timestamp register again")
 DECLARE_DEBUG_VARIABLE(bool, EnableTimestampPacket, false, "Write Timestamp Packet for each set of gpu walkers")
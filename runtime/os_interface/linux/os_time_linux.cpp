@@ -23,6 +23,7 @@
 #include <time.h>
 #include "runtime/os_interface/linux/drm_neo.h"
 #include "drm/i915_drm.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/linux/os_interface.h"
 #include "runtime/os_interface/linux/os_time_linux.h"
 
@@ -38,6 +39,9 @@ OSTimeLinux::OSTimeLinux(OSInterface *osInterface) {
         pDrm = Drm::get(0);
     }
     timestampTypeDetect();
+    if (DebugManager.flags.CpuGpuTimeModelValidityMicroseconds.get() > 0) {
+        clockModelValidityNs = static_cast<uint64_t>(DebugManager.flags.CpuGpuTimeModelValidityMicroseconds.get()) * 1000;
+    }
 }
 
 OSTimeLinux::~OSTimeLinux(){};
@@ -124,17 +128,84 @@ bool OSTimeLinux::getGpuTimeSplitted(uint64_t *timestamp) {
     return true;
 }
 
+bool OSTimeLinux::sampleCpuGpuTime(TimeStampData *pGpuCpuTime) {
+    if (!(this->*getGpuTime)(&pGpuCpuTime->GPUTimeStamp)) {
+        return false;
+    }
+    if (!getCpuTime(&pGpuCpuTime->CPUTimeinNS)) {
+        return false;
+    }
+
+    return true;
+}
+
+void OSTimeLinux::updateClockModel(const TimeStampData &sample) {
+    if (!clockModelReferenceValid) {
+        clockModelReference = sample;
+        clockModelReferenceValid = true;
+        return;
+    }
+    if (sample.CPUTimeinNS < clockModelReference.CPUTimeinNS) {
+        return;
+    }
+
+    auto cpuDelta = sample.CPUTimeinNS - clockModelReference.CPUTimeinNS;
+    if (cpuDelta >= clockModelValidityNs / 2) {
+        uint64_t timestampMask = (1ull << timestampSizeInBits) - 1;
+        auto gpuDelta = (sample.GPUTimeStamp - clockModelReference.GPUTimeStamp) & timestampMask;
+        gpuTicksPerNs = static_cast<double>(gpuDelta) / static_cast<double>(cpuDelta);
+        clockModelReference = sample;
+    } else if (gpuTicksPerNs > 0.0) {
+        // short interval is not precise enough to refit drift, only move the offset
+        clockModelReference = sample;
+    }
+}
+
+uint64_t OSTimeLinux::clampToLastGpuTimeStamp(uint64_t gpuTimeStamp) {
+    // timestamps wrap, a value less than half of the range behind the last one is treated as going backwards
+    uint64_t timestampMask = (1ull << timestampSizeInBits) - 1;
+    if (lastGpuTimeStampValid && (((gpuTimeStamp - lastGpuTimeStamp) & timestampMask) > (timestampMask >> 1))) {
+        return lastGpuTimeStamp;
+    }
+    lastGpuTimeStamp = gpuTimeStamp;
+    lastGpuTimeStampValid = true;
+    return gpuTimeStamp;
+}
+
 bool OSTimeLinux::getCpuGpuTime(TimeStampData *pGpuCpuTime) {
     if (nullptr == this->getGpuTime) {
         return false;
     }
-    if (!(this->*getGpuTime)(&pGpuCpuTime->GPUTimeStamp)) {
-        return false;
+    if (clockModelValidityNs == 0) {
+        return sampleCpuGpuTime(pGpuCpuTime);
     }
-    if (!getCpuTime(&pGpuCpuTime->CPUTimeinNS)) {
+
+    uint64_t cpuTime = 0;
+    if (!getCpuTime(&cpuTime)) {
         return false;
     }
+    {
+        std::unique_lock<std::mutex> lock(clockModelMtx);
+        if ((gpuTicksPerNs > 0.0) && (cpuTime >= clockModelReference.CPUTimeinNS) &&
+            (cpuTime - clockModelReference.CPUTimeinNS < clockModelValidityNs)) {
+            uint64_t timestampMask = (1ull << timestampSizeInBits) - 1;
+            auto gpuTicksElapsed = static_cast<uint64_t>((cpuTime - clockModelReference.CPUTimeinNS) * gpuTicksPerNs + 0.5);
+            pGpuCpuTime->GPUTimeStamp = clampToLastGpuTimeStamp((clockModelReference.GPUTimeStamp + gpuTicksElapsed) & timestampMask);
+            pGpuCpuTime->CPUTimeinNS = cpuTime;
+            return true;
+        }
+    }
 
+    TimeStampData sample = {0, 0};
+    if (!sampleCpuGpuTime(&sample)) {
+        return false;
+    }
+    {
+        std::unique_lock<std::mutex> lock(clockModelMtx);
+        updateClockModel(sample);
+        sample.GPUTimeStamp = clampToLastGpuTimeStamp(sample.GPUTimeStamp);
+    }
+    *pGpuCpuTime = sample;
     return true;
 }
 
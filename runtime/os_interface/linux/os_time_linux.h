@@ -23,6 +23,8 @@
 #pragma once
 #include "runtime/os_interface/os_time.h"
 
+#include <mutex>
+
 #define OCLRT_NUM_TIMESTAMP_BITS (36)
 #define OCLRT_NUM_TIMESTAMP_BITS_FALLBACK (32)
 #define TIMESTAMP_HIGH_REG 0x0235C
@@ -49,10 +51,25 @@ class OSTimeLinux : public OSTime {
   protected:
     typedef int (*resolutionFunc_t)(clockid_t, struct timespec *);
     typedef int (*getTimeFunc_t)(clockid_t, struct timespec *);
+    bool sampleCpuGpuTime(TimeStampData *pGpuCpuTime);
+    void updateClockModel(const TimeStampData &sample);
+    // keeps reported GPU time monotonic when a new register sample is behind the last prediction
+    uint64_t clampToLastGpuTimeStamp(uint64_t gpuTimeStamp);
+
     Drm *pDrm;
     unsigned timestampSizeInBits;
     resolutionFunc_t resolutionFunc;
     getTimeFunc_t getTimeFunc;
+
+    // GPU time is predicted from CPU time with offset and drift fitted on register samples
+    // taken at least half of the validity period apart, 0 validity disables the model
+    std::mutex clockModelMtx;
+    uint64_t clockModelValidityNs = 0;
+    TimeStampData clockModelReference = {0, 0};
+    bool clockModelReferenceValid = false;
+    double gpuTicksPerNs = 0.0;
+    uint64_t lastGpuTimeStamp = 0;
+    bool lastGpuTimeStampValid = false;
 };
 
 } // namespace OCLRT
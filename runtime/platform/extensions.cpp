@@ -22,6 +22,7 @@
 
 #include <string>
 #include "runtime/helpers/hw_info.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/platform/extensions.h"
 
 namespace OCLRT {
@@ -66,6 +67,45 @@ std::string getExtensionsList(const HardwareInfo &hwInfo) {
     return allExtensionsList;
 }
 
+std::string getDeviceExtensions(const HardwareInfo &hwInfo, unsigned int enabledClVersion) {
+    std::string deviceExtensions;
+    deviceExtensions.reserve(1000);
+
+    deviceExtensions.append(deviceExtensionsList);
+
+    bool fp64Enabled = hwInfo.capabilityTable.ftrSupportsFP64;
+    if (DebugManager.flags.OverrideDefaultFP64Settings.get() != -1) {
+        fp64Enabled = DebugManager.flags.OverrideDefaultFP64Settings.get() == 1;
+    }
+    if (fp64Enabled) {
+        deviceExtensions += "cl_khr_fp64 ";
+    }
+
+    if (enabledClVersion >= 21) {
+        deviceExtensions += "cl_khr_subgroups ";
+        deviceExtensions += "cl_khr_il_program ";
+    }
+
+    if (enabledClVersion >= 20) {
+        deviceExtensions += "cl_khr_mipmap_image cl_khr_mipmap_image_writes ";
+    }
+
+    if (DebugManager.flags.EnableNV12.get()) {
+        deviceExtensions += "cl_intel_planar_yuv ";
+    }
+    if (DebugManager.flags.EnablePackedYuv.get()) {
+        deviceExtensions += "cl_intel_packed_yuv ";
+    }
+    if (DebugManager.flags.EnableIntelVme.get()) {
+        deviceExtensions += "cl_intel_motion_estimation ";
+    }
+    if (DebugManager.flags.EnableIntelAdvancedVme.get()) {
+        deviceExtensions += "cl_intel_advanced_motion_estimation ";
+    }
+
+    return deviceExtensions;
+}
+
 std::string removeLastSpace(std::string &processedString) {
     if (processedString.size() > 0) {
         if (*processedString.rbegin() == ' ') {
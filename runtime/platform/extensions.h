@@ -27,6 +27,8 @@ namespace OCLRT {
 extern const char *deviceExtensionsList;
 
 std::string getExtensionsList(const HardwareInfo &hwInfo);
+// extensions reported by a device, except the sharing and OS specific ones
+std::string getDeviceExtensions(const HardwareInfo &hwInfo, unsigned int enabledClVersion);
 std::string removeLastSpace(std::string &s);
 std::string convertEnabledExtensionsToCompilerInternalOptions(const char *deviceExtensions);
 
@@ -35,9 +35,11 @@
 #include "runtime/os_interface/device_factory.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/event/async_events_handler.h"
+#include "runtime/event/callback_executor.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/platform/extensions.h"
 #include "CL/cl_ext.h"
+#include <algorithm>
 
 namespace OCLRT {
 
@@ -59,12 +61,15 @@ Platform *constructPlatform() {
 Platform::Platform() {
     devices.reserve(4);
     setAsyncEventsHandler(std::unique_ptr<AsyncEventsHandler>(new AsyncEventsHandler()));
+    auto numCallbackWorkers = static_cast<uint32_t>(std::max(DebugManager.flags.EventCallbackExecutorThreads.get(), 0));
+    setCallbackExecutor(std::unique_ptr<CallbackExecutor>(new CallbackExecutor(numCallbackWorkers)));
     executionEnvironment = new ExecutionEnvironment;
     executionEnvironment->incRefInternal();
 }
 
 Platform::~Platform() {
     asyncEventsHandler->closeThread();
+    callbackExecutor->closeThreads();
     for (auto dev : this->devices) {
         if (dev) {
             dev->decRefInternal();
@@ -243,4 +248,13 @@ std::unique_ptr<AsyncEventsHandler> Platform::setAsyncEventsHandler(std::unique_
     return handler;
 }
 
+CallbackExecutor *Platform::getCallbackExecutor() {
+    return callbackExecutor.get();
+}
+
+std::unique_ptr<CallbackExecutor> Platform::setCallbackExecutor(std::unique_ptr<CallbackExecutor> executor) {
+    callbackExecutor.swap(executor);
+    return executor;
+}
+
 } // namespace OCLRT
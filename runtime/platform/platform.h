@@ -33,6 +33,7 @@ namespace OCLRT {
 class CompilerInterface;
 class Device;
 class AsyncEventsHandler;
+class CallbackExecutor;
 class ExecutionEnvironment;
 struct HardwareInfo;
 
@@ -68,6 +69,8 @@ class Platform : public BaseObject<_cl_platform_id> {
     const PlatformInfo &getPlatformInfo() const;
     AsyncEventsHandler *getAsyncEventsHandler();
     std::unique_ptr<AsyncEventsHandler> setAsyncEventsHandler(std::unique_ptr<AsyncEventsHandler> handler);
+    CallbackExecutor *getCallbackExecutor();
+    std::unique_ptr<CallbackExecutor> setCallbackExecutor(std::unique_ptr<CallbackExecutor> executor);
     ExecutionEnvironment *peekExecutionEnvironment() { return executionEnvironment; }
 
   protected:
@@ -83,6 +86,7 @@ class Platform : public BaseObject<_cl_platform_id> {
     DeviceVector devices;
     std::string compilerExtensions;
     std::unique_ptr<AsyncEventsHandler> asyncEventsHandler;
+    std::unique_ptr<CallbackExecutor> callbackExecutor;
     ExecutionEnvironment *executionEnvironment = nullptr;
 };
 
@@ -189,6 +189,13 @@ cl_int Program::build(
     cl_int retVal = CL_SUCCESS;
     processKernel(pKernelData, retVal);
 
+    if (retVal == CL_SUCCESS && this->pDevice) {
+        auto &kernelInfo = *kernelInfoArray.back();
+        if (kernelInfo.heapInfo.pKernelHeader->KernelHeapSize) {
+            retVal = kernelInfo.createKernelAllocation(this->pDevice->getMemoryManager()) ? CL_SUCCESS : CL_OUT_OF_HOST_MEMORY;
+        }
+    }
+
     return retVal;
 }
 } // namespace OCLRT
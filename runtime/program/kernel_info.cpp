@@ -506,7 +506,17 @@ bool KernelInfo::createKernelAllocation(MemoryManager *memoryManager) {
     } else {
         return false;
     }
+    kernelAllocationOffset = 0;
+    isKernelAllocationShared = false;
     return true;
 }
 
+uint64_t KernelInfo::getKernelIsaGpuAddressToPatch() const {
+    DEBUG_BREAK_IF(!kernelAllocation);
+    if (kernelAllocation == nullptr) {
+        return 0llu;
+    }
+    return kernelAllocation->getGpuAddressToPatch() + kernelAllocationOffset;
+}
+
 } // namespace OCLRT
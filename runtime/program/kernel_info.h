@@ -32,6 +32,7 @@
 #include <cstdint>
 #include <cmath>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -41,6 +42,7 @@ class BuiltinDispatchInfoBuilder;
 class Device;
 class Kernel;
 struct KernelInfo;
+struct KernelInstanceTemplate;
 class DispatchInfo;
 struct KernelArgumentType;
 class GraphicsAllocation;
@@ -63,6 +65,9 @@ struct WorkloadInfo {
     uint32_t simdSizeOffset;
     uint32_t parentEventOffset;
     uint32_t prefferedWkgMultipleOffset;
+    uint32_t privateMemoryStatelessSizeOffset;
+    uint32_t localMemoryStatelessWindowSizeOffset;
+    uint32_t localMemoryStatelessWindowStartAddressOffset;
 
     static const uint32_t undefinedOffset;
     static const uint32_t invalidParentEvent;
@@ -91,6 +96,9 @@ struct WorkloadInfo {
         simdSizeOffset = undefinedOffset;
         parentEventOffset = undefinedOffset;
         prefferedWkgMultipleOffset = undefinedOffset;
+        privateMemoryStatelessSizeOffset = undefinedOffset;
+        localMemoryStatelessWindowSizeOffset = undefinedOffset;
+        localMemoryStatelessWindowStartAddressOffset = undefinedOffset;
     }
 };
 
@@ -140,6 +148,9 @@ struct KernelInfo {
         reqdWorkGroupSize[2] = WorkloadInfo::undefinedOffset;
     }
 
+    static const size_t kernelIsaAlignment = 64;
+    static const size_t kernelIsaPrefetchPadding = 512;
+
     KernelInfo(const KernelInfo &) = delete;
     KernelInfo &operator=(const KernelInfo &) = delete;
 
@@ -163,6 +174,8 @@ struct KernelInfo {
     void storePatchToken(const SPatchKernelAttributesInfo *pKernelAttributesInfo);
     void storePatchToken(const SPatchAllocateSystemThreadSurface *pSystemThreadSurface);
     GraphicsAllocation *getGraphicsAllocation() const { return this->kernelAllocation; }
+    uint32_t getKernelAllocationOffset() const { return this->kernelAllocationOffset; }
+    uint64_t getKernelIsaGpuAddressToPatch() const;
     cl_int resolveKernelInfo();
     void resizeKernelArgInfoAndRegisterParameter(uint32_t argCount) {
         if (kernelArgInfo.size() <= argCount) {
@@ -253,6 +266,9 @@ struct KernelInfo {
     uint64_t kernelId = 0;
     bool isKernelHeapSubstituted = false;
     GraphicsAllocation *kernelAllocation = nullptr;
+    uint32_t kernelAllocationOffset = 0;
+    bool isKernelAllocationShared = false;
     DebugData debugData;
+    mutable std::shared_ptr<const KernelInstanceTemplate> instanceTemplate;
 };
 } // namespace OCLRT
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/kernel_info_metadata.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/string.h"
+#include "patch_list.h"
+#include "patch_shared.h"
+
+#include <type_traits>
+
+using namespace iOpenCL;
+
+namespace OCLRT {
+namespace {
+class MetadataWriter {
+  public:
+    static constexpr bool isReading = false;
+
+    MetadataWriter(std::vector<char> &output) : output(output) {}
+
+    void setPatchList(const void *patchList, uint32_t patchListSize) {
+        this->patchList = patchList;
+        this->patchListSize = patchListSize;
+    }
+
+    template <typename T>
+    bool transfer(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types can be stored");
+        auto bytes = reinterpret_cast<const char *>(&value);
+        output.insert(output.end(), bytes, bytes + sizeof(T));
+        return true;
+    }
+
+    bool transfer(const std::string &value) {
+        uint32_t size = static_cast<uint32_t>(value.size());
+        transfer(size);
+        output.insert(output.end(), value.begin(), value.end());
+        return true;
+    }
+
+    template <typename T>
+    bool transferToken(const T *const &token) {
+        uint32_t offset = KernelInfoMetadata::noToken;
+        if (token != nullptr) {
+            auto tokenAddress = reinterpret_cast<uintptr_t>(token);
+            auto patchListAddress = reinterpret_cast<uintptr_t>(patchList);
+            if (tokenAddress < patchListAddress || tokenAddress + sizeof(T) > patchListAddress + patchListSize) {
+                return false;
+            }
+            offset = static_cast<uint32_t>(tokenAddress - patchListAddress);
+        }
+        return transfer(offset);
+    }
+
+    bool hasRemaining(size_t bytes) const {
+        return true;
+    }
+
+    size_t getPosition() const {
+        return output.size();
+    }
+
+  protected:
+    std::vector<char> &output;
+    const void *patchList = nullptr;
+    uint32_t patchListSize = 0;
+};
+
+class MetadataReader {
+  public:
+    static constexpr bool isReading = true;
+
+    MetadataReader(const char *data, size_t size) : data(data), size(size) {}
+
+    void setPatchList(const void *patchList, uint32_t patchListSize) {
+        this->patchList = patchList;
+        this->patchListSize = patchListSize;
+    }
+
+    template <typename T>
+    bool transfer(T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable types can be loaded");
+        if (!hasRemaining(sizeof(T))) {
+            return false;
+        }
+        memcpy_s(&value, sizeof(T), data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    bool transfer(std::string &value) {
+        uint32_t stringSize = 0;
+        if (!transfer(stringSize) || !hasRemaining(stringSize)) {
+            return false;
+        }
+        value.assign(data + position, stringSize);
+        position += stringSize;
+        return true;
+    }
+
+    template <typename T>
+    bool transferToken(const T *&token) {
+        uint32_t offset = 0;
+        if (!transfer(offset)) {
+            return false;
+        }
+        token = resolveToken<T>(offset);
+        return (offset == KernelInfoMetadata::noToken) || (token != nullptr);
+    }
+
+    template <typename T>
+    const T *resolveToken(uint32_t offset) const {
+        if (offset == KernelInfoMetadata::noToken || static_cast<uint64_t>(offset) + sizeof(T) > patchListSize) {
+            return nullptr;
+        }
+        return reinterpret_cast<const T *>(ptrOffset(patchList, offset));
+    }
+
+    bool hasRemaining(size_t bytes) const {
+        return size - position >= bytes;
+    }
+
+    size_t getPosition() const {
+        return position;
+    }
+
+  protected:
+    const char *data = nullptr;
+    size_t size = 0;
+    size_t position = 0;
+    const void *patchList = nullptr;
+    uint32_t patchListSize = 0;
+};
+
+template <typename Stream, typename T>
+bool transferCount(Stream &stream, std::vector<T> &container, size_t minElementSize) {
+    uint32_t count = static_cast<uint32_t>(container.size());
+    if (!stream.transfer(count) || !stream.hasRemaining(count * minElementSize)) {
+        return false;
+    }
+    if (Stream::isReading) {
+        container.resize(count);
+    }
+    return true;
+}
+
+template <typename Stream, typename T>
+bool transferTokens(Stream &stream, std::vector<const T *> &tokens) {
+    bool success = transferCount(stream, tokens, sizeof(uint32_t));
+    for (size_t i = 0; success && i < tokens.size(); i++) {
+        success = stream.transferToken(tokens[i]);
+    }
+    return success;
+}
+
+template <typename Stream>
+bool transferKernelArgInfo(Stream &stream, KernelArgInfo &argInfo) {
+    bool success = stream.transfer(argInfo.name) &&
+                   stream.transfer(argInfo.typeStr) &&
+                   stream.transfer(argInfo.accessQualifierStr) &&
+                   stream.transfer(argInfo.addressQualifierStr) &&
+                   stream.transfer(argInfo.typeQualifierStr) &&
+                   stream.transfer(argInfo.offsetHeap) &&
+                   stream.transfer(argInfo.slmAlignment) &&
+                   stream.transfer(argInfo.isImage) &&
+                   stream.transfer(argInfo.isMediaImage) &&
+                   stream.transfer(argInfo.isMediaBlockImage) &&
+                   stream.transfer(argInfo.isSampler) &&
+                   stream.transfer(argInfo.isAccelerator) &&
+                   stream.transfer(argInfo.isDeviceQueue) &&
+                   stream.transfer(argInfo.isBuffer) &&
+                   stream.transfer(argInfo.pureStatefulBufferAccess) &&
+                   stream.transfer(argInfo.samplerArgumentType) &&
+                   stream.transfer(argInfo.offsetImgWidth) &&
+                   stream.transfer(argInfo.offsetImgHeight) &&
+                   stream.transfer(argInfo.offsetImgDepth) &&
+                   stream.transfer(argInfo.offsetChannelDataType) &&
+                   stream.transfer(argInfo.offsetChannelOrder) &&
+                   stream.transfer(argInfo.offsetArraySize) &&
+                   stream.transfer(argInfo.offsetNumSamples) &&
+                   stream.transfer(argInfo.offsetSamplerSnapWa) &&
+                   stream.transfer(argInfo.offsetSamplerAddressingMode) &&
+                   stream.transfer(argInfo.offsetSamplerNormalizedCoords) &&
+                   stream.transfer(argInfo.offsetVmeMbBlockType) &&
+                   stream.transfer(argInfo.offsetVmeSubpixelMode) &&
+                   stream.transfer(argInfo.offsetVmeSadAdjustMode) &&
+                   stream.transfer(argInfo.offsetVmeSearchPathType) &&
+                   stream.transfer(argInfo.offsetObjectId) &&
+                   stream.transfer(argInfo.offsetBufferOffset) &&
+                   stream.transfer(argInfo.offsetNumMipLevels) &&
+                   stream.transfer(argInfo.needPatch) &&
+                   stream.transfer(argInfo.isTransformable) &&
+                   stream.transfer(argInfo.accessQualifier) &&
+                   stream.transfer(argInfo.addressQualifier) &&
+                   stream.transfer(argInfo.typeQualifier);
+
+    success = success && transferCount(stream, argInfo.kernelArgPatchInfoVector, sizeof(KernelArgPatchInfo));
+    for (size_t i = 0; success && i < argInfo.kernelArgPatchInfoVector.size(); i++) {
+        success = stream.transfer(argInfo.kernelArgPatchInfoVector[i]);
+    }
+    return success;
+}
+
+// Single place describing the layout of a kernel record, shared by the encoder and the decoder
+template <typename Stream>
+bool transferKernelInfo(Stream &stream, KernelInfo &kernelInfo) {
+    static_assert(std::is_trivially_copyable<WorkloadInfo>::value, "WorkloadInfo is stored as raw bytes");
+    auto &patchInfo = kernelInfo.patchInfo;
+
+    bool success = stream.transferToken(patchInfo.interfaceDescriptorDataLoad) &&
+                   stream.transferToken(patchInfo.localsurface) &&
+                   stream.transferToken(patchInfo.mediavfestate) &&
+                   stream.transferToken(patchInfo.interfaceDescriptorData) &&
+                   stream.transferToken(patchInfo.samplerStateArray) &&
+                   stream.transferToken(patchInfo.bindingTableState) &&
+                   stream.transferToken(patchInfo.dataParameterStream) &&
+                   stream.transferToken(patchInfo.threadPayload) &&
+                   stream.transferToken(patchInfo.executionEnvironment) &&
+                   stream.transferToken(patchInfo.pKernelAttributesInfo) &&
+                   stream.transferToken(patchInfo.pAllocateStatelessPrivateSurface) &&
+                   stream.transferToken(patchInfo.pAllocateStatelessConstantMemorySurfaceWithInitialization) &&
+                   stream.transferToken(patchInfo.pAllocateStatelessGlobalMemorySurfaceWithInitialization) &&
+                   stream.transferToken(patchInfo.pAllocateStatelessPrintfSurface) &&
+                   stream.transferToken(patchInfo.pAllocateStatelessEventPoolSurface) &&
+                   stream.transferToken(patchInfo.pAllocateStatelessDefaultDeviceQueueSurface) &&
+                   stream.transferToken(patchInfo.pAllocateSystemThreadSurface) &&
+                   transferTokens(stream, patchInfo.dataParameterBuffers) &&
+                   transferTokens(stream, patchInfo.statelessGlobalMemObjKernelArgs) &&
+                   transferTokens(stream, patchInfo.imageMemObjKernelArgs) &&
+                   transferTokens(stream, patchInfo.globalMemObjKernelArgs) &&
+                   transferTokens(stream, patchInfo.kernelArgumentInfo) &&
+                   stream.transfer(kernelInfo.workloadInfo) &&
+                   stream.transfer(kernelInfo.usesSsh) &&
+                   stream.transfer(kernelInfo.requiresSshForBuffers) &&
+                   stream.transfer(kernelInfo.isVmeWorkload) &&
+                   stream.transfer(kernelInfo.workgroupWalkOrder) &&
+                   stream.transfer(kernelInfo.workgroupDimensionsOrder) &&
+                   stream.transfer(kernelInfo.argumentsToPatchNum) &&
+                   stream.transfer(kernelInfo.systemKernelOffset);
+
+    for (uint32_t i = 0; success && i < 3; i++) {
+        uint32_t reqdWorkGroupSize = static_cast<uint32_t>(kernelInfo.reqdWorkGroupSize[i]);
+        success = stream.transfer(reqdWorkGroupSize);
+        if (Stream::isReading) {
+            kernelInfo.reqdWorkGroupSize[i] = reqdWorkGroupSize;
+        }
+    }
+
+    success = success && transferCount(stream, kernelInfo.childrenKernelsIdOffset, 2 * sizeof(uint32_t));
+    for (size_t i = 0; success && i < kernelInfo.childrenKernelsIdOffset.size(); i++) {
+        success = stream.transfer(kernelInfo.childrenKernelsIdOffset[i].first) &&
+                  stream.transfer(kernelInfo.childrenKernelsIdOffset[i].second);
+    }
+
+    success = success && transferCount(stream, kernelInfo.kernelArgInfo, sizeof(uint32_t));
+    for (size_t i = 0; success && i < kernelInfo.kernelArgInfo.size(); i++) {
+        success = transferKernelArgInfo(stream, kernelInfo.kernelArgInfo[i]);
+    }
+    return success;
+}
+
+// string and GTPin tokens are not referenced from KernelInfo, so their offsets are collected directly from the patch list
+void collectTokenOffsets(const KernelInfo &kernelInfo, std::vector<uint32_t> &stringOffsets, uint32_t &igcInfoOffset) {
+    auto pPatchList = kernelInfo.heapInfo.pPatchList;
+    auto patchListSize = kernelInfo.heapInfo.pKernelHeader->PatchListSize;
+    auto pCurPatchListPtr = pPatchList;
+    igcInfoOffset = KernelInfoMetadata::noToken;
+
+    while (ptrDiff(pCurPatchListPtr, pPatchList) < patchListSize) {
+        auto pPatch = reinterpret_cast<const SPatchItemHeader *>(pCurPatchListPtr);
+        auto offset = static_cast<uint32_t>(ptrDiff(pCurPatchListPtr, pPatchList));
+        if (pPatch->Token == PATCH_TOKEN_STRING) {
+            stringOffsets.push_back(offset);
+        } else if (pPatch->Token == PATCH_TOKEN_GTPIN_INFO) {
+            igcInfoOffset = offset;
+        }
+        if (pPatch->Size == 0) {
+            break;
+        }
+        pCurPatchListPtr = ptrOffset(pCurPatchListPtr, pPatch->Size);
+    }
+}
+} // namespace
+
+bool KernelInfoMetadataEncoder::encode(const std::vector<const KernelInfo *> &kernelInfos, std::vector<char> &metadata) {
+    std::vector<char> output;
+    MetadataWriter writer(output);
+
+    KernelInfoMetadata::Header header = {};
+    header.magic = KernelInfoMetadata::magic;
+    header.version = KernelInfoMetadata::version;
+    header.numKernels = static_cast<uint32_t>(kernelInfos.size());
+    header.workloadInfoSize = static_cast<uint32_t>(sizeof(WorkloadInfo));
+    writer.transfer(header);
+
+    for (auto kernelInfo : kernelInfos) {
+        auto pKernelHeader = kernelInfo->heapInfo.pKernelHeader;
+        if (pKernelHeader == nullptr || kernelInfo->heapInfo.pPatchList == nullptr) {
+            return false;
+        }
+
+        std::vector<uint32_t> stringOffsets;
+        uint32_t igcInfoOffset = KernelInfoMetadata::noToken;
+        collectTokenOffsets(*kernelInfo, stringOffsets, igcInfoOffset);
+
+        auto recordStart = writer.getPosition();
+        uint32_t recordSize = 0;
+        writer.transfer(recordSize);
+        writer.transfer(pKernelHeader->CheckSum);
+        writer.transfer(pKernelHeader->KernelNameSize);
+        writer.transfer(pKernelHeader->KernelHeapSize);
+        writer.transfer(pKernelHeader->PatchListSize);
+        writer.transfer(igcInfoOffset);
+        transferCount(writer, stringOffsets, sizeof(uint32_t));
+        for (auto stringOffset : stringOffsets) {
+            writer.transfer(stringOffset);
+        }
+
+        writer.setPatchList(kernelInfo->heapInfo.pPatchList, pKernelHeader->PatchListSize);
+        // writer only reads from kernelInfo
+        if (!transferKernelInfo(writer, const_cast<KernelInfo &>(*kernelInfo))) {
+            return false;
+        }
+
+        recordSize = static_cast<uint32_t>(writer.getPosition() - recordStart);
+        memcpy_s(&output[recordStart], sizeof(recordSize), &recordSize, sizeof(recordSize));
+    }
+
+    metadata.swap(output);
+    return true;
+}
+
+KernelInfoMetadataDecoder::KernelInfoMetadataDecoder(const void *metadata, size_t metadataSize, uint32_t numKernels)
+    : metadata(reinterpret_cast<const char *>(metadata)), metadataSize(metadataSize), kernelsLeft(numKernels) {
+    KernelInfoMetadata::Header header = {};
+    MetadataReader reader(this->metadata, metadataSize);
+    if (metadata == nullptr || !reader.transfer(header)) {
+        return;
+    }
+    valid = header.magic == KernelInfoMetadata::magic &&
+            header.version == KernelInfoMetadata::version &&
+            header.numKernels == numKernels &&
+            header.workloadInfoSize == sizeof(WorkloadInfo);
+    position = reader.getPosition();
+}
+
+KernelInfoMetadataDecoder::DecodeStatus KernelInfoMetadataDecoder::decodeNextKernel(KernelInfo &kernelInfo, const void *&igcInfo) {
+    if (!valid || kernelsLeft == 0) {
+        return DecodeStatus::InvalidMetadata;
+    }
+    kernelsLeft--;
+
+    uint32_t recordSize = 0;
+    MetadataReader recordSizeReader(metadata + position, metadataSize - position);
+    if (!recordSizeReader.transfer(recordSize) || recordSize < sizeof(recordSize) || recordSize > metadataSize - position) {
+        valid = false;
+        return DecodeStatus::InvalidMetadata;
+    }
+    MetadataReader reader(metadata + position + sizeof(recordSize), recordSize - sizeof(recordSize));
+    position += recordSize;
+
+    SKernelBinaryHeaderCommon recordedHeader = {};
+    uint32_t igcInfoOffset = KernelInfoMetadata::noToken;
+    if (!reader.transfer(recordedHeader.CheckSum) ||
+        !reader.transfer(recordedHeader.KernelNameSize) ||
+        !reader.transfer(recordedHeader.KernelHeapSize) ||
+        !reader.transfer(recordedHeader.PatchListSize) ||
+        !reader.transfer(igcInfoOffset)) {
+        return DecodeStatus::InvalidMetadata;
+    }
+
+    auto pKernelHeader = kernelInfo.heapInfo.pKernelHeader;
+    if (recordedHeader.CheckSum != pKernelHeader->CheckSum ||
+        recordedHeader.KernelNameSize != pKernelHeader->KernelNameSize ||
+        recordedHeader.KernelHeapSize != pKernelHeader->KernelHeapSize ||
+        recordedHeader.PatchListSize != pKernelHeader->PatchListSize) {
+        return DecodeStatus::KernelMismatch;
+    }
+
+    reader.setPatchList(kernelInfo.heapInfo.pPatchList, pKernelHeader->PatchListSize);
+
+    std::vector<uint32_t> stringOffsets;
+    bool success = transferCount(reader, stringOffsets, sizeof(uint32_t));
+    for (size_t i = 0; success && i < stringOffsets.size(); i++) {
+        success = reader.transfer(stringOffsets[i]);
+    }
+    success = success && transferKernelInfo(reader, kernelInfo) && !reader.hasRemaining(1);
+    if (!success) {
+        return DecodeStatus::InvalidMetadata;
+    }
+
+    for (auto stringOffset : stringOffsets) {
+        auto pString = reader.resolveToken<SPatchString>(stringOffset);
+        if (pString == nullptr || static_cast<uint64_t>(stringOffset) + sizeof(SPatchString) + pString->StringSize > pKernelHeader->PatchListSize) {
+            return DecodeStatus::InvalidMetadata;
+        }
+        kernelInfo.storePatchToken(pString);
+    }
+
+    if (kernelInfo.patchInfo.pKernelAttributesInfo) {
+        kernelInfo.storePatchToken(kernelInfo.patchInfo.pKernelAttributesInfo);
+    }
+
+    igcInfo = nullptr;
+    if (igcInfoOffset != KernelInfoMetadata::noToken) {
+        auto pIgcInfoToken = reader.resolveToken<SPatchItemHeader>(igcInfoOffset);
+        if (pIgcInfoToken == nullptr) {
+            return DecodeStatus::InvalidMetadata;
+        }
+        igcInfo = ptrOffset(pIgcInfoToken, sizeof(SPatchItemHeader));
+    }
+
+    return DecodeStatus::Success;
+}
+} // namespace OCLRT
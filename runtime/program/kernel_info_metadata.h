@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/program/kernel_info.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace OCLRT {
+
+// Versioned, precomputed form of the KernelInfo layout that parsePatchList derives from patch tokens.
+// Patch token pointers are stored as offsets into the kernel's patch list, so decoding only rebases them.
+namespace KernelInfoMetadata {
+constexpr uint32_t magic = 0x4d494b4f; // "OKIM"
+constexpr uint32_t version = 1;
+constexpr uint32_t noToken = 0xFFFFFFFF;
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t numKernels;
+    uint32_t workloadInfoSize;
+};
+} // namespace KernelInfoMetadata
+
+class KernelInfoMetadataEncoder {
+  public:
+    // kernelInfos have to be passed in the order their blobs appear in the device binary
+    static bool encode(const std::vector<const KernelInfo *> &kernelInfos, std::vector<char> &metadata);
+};
+
+class KernelInfoMetadataDecoder {
+  public:
+    enum class DecodeStatus {
+        Success,
+        KernelMismatch,
+        InvalidMetadata
+    };
+
+    KernelInfoMetadataDecoder(const void *metadata, size_t metadataSize, uint32_t numKernels);
+
+    bool isValid() const {
+        return valid;
+    }
+
+    // kernelInfo needs heapInfo set up; on KernelMismatch it is left untouched and should be parsed from patch tokens
+    DecodeStatus decodeNextKernel(KernelInfo &kernelInfo, const void *&igcInfo);
+
+  protected:
+    const char *metadata = nullptr;
+    size_t metadataSize = 0;
+    size_t position = 0;
+    uint32_t kernelsLeft = 0;
+    bool valid = false;
+};
+} // namespace OCLRT
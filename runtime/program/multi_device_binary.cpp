@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/multi_device_binary.h"
+#include "runtime/helpers/hw_info.h"
+#include "elf/writer.h"
+
+#include <cstring>
+
+namespace OCLRT {
+
+void MultiDeviceBinaryWriter::write(const std::vector<DeviceBinaryVariant::Desc> &variants, const std::string &irBinary, bool isSpirV,
+                                    const std::string &options, CLElfLib::ElfBinaryStorage &binary) {
+    CLElfLib::CElfWriter elfWriter(CLElfLib::E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, CLElfLib::E_EH_MACHINE::EH_MACHINE_NONE, 0);
+
+    elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_OPTIONS, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "BuildOptions", options, static_cast<uint32_t>(options.size() + 1u)));
+    if (!irBinary.empty()) {
+        elfWriter.addSection(CLElfLib::SSectionNode(isSpirV ? CLElfLib::E_SH_TYPE::SH_TYPE_SPIRV : CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_LLVM_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE,
+                                                    "Intel(R) OpenCL LLVM Object", irBinary, static_cast<uint32_t>(irBinary.size())));
+    }
+
+    for (const auto &variant : variants) {
+        DeviceBinaryVariant::Header header = {};
+        header.magic = DeviceBinaryVariant::magic;
+        header.coreFamily = static_cast<uint32_t>(variant.coreFamily);
+        header.productFamily = static_cast<uint32_t>(variant.productFamily);
+
+        std::string sectionData(reinterpret_cast<const char *>(&header), sizeof(header));
+        sectionData += variant.deviceBinary;
+        auto sectionDataSize = static_cast<uint32_t>(sectionData.size());
+        elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY_VARIANT, CLElfLib::E_SH_FLAG::SH_FLAG_NONE,
+                                                    "Intel(R) OpenCL Device Binary Variant", std::move(sectionData), sectionDataSize));
+    }
+
+    binary = CLElfLib::ElfBinaryStorage(elfWriter.getTotalBinarySize());
+    elfWriter.resolveBinary(binary);
+}
+
+DeviceBinaryVariantSelector::DeviceBinaryVariantSelector(const HardwareInfo &hwInfo)
+    : coreFamily(hwInfo.pPlatform->eRenderCoreFamily),
+      productFamily(hwInfo.pPlatform->eProductFamily) {
+}
+
+bool DeviceBinaryVariantSelector::addVariant(const char *sectionData, size_t sectionDataSize) {
+    if (sectionData == nullptr || sectionDataSize <= sizeof(DeviceBinaryVariant::Header)) {
+        return false;
+    }
+
+    DeviceBinaryVariant::Header header;
+    memcpy(&header, sectionData, sizeof(header));
+    if (header.magic != DeviceBinaryVariant::magic) {
+        return false;
+    }
+    numVariants++;
+
+    if (exactMatch || header.coreFamily != static_cast<uint32_t>(coreFamily)) {
+        return true;
+    }
+
+    // device binaries are compatible within a core family (see Program::validateGenBinaryDevice),
+    // so a variant built for this very product only takes precedence over other products of the family
+    bool isExactMatch = (header.productFamily == static_cast<uint32_t>(productFamily));
+    if (isExactMatch || selectedBinary == nullptr) {
+        exactMatch = isExactMatch;
+        selectedBinary = sectionData + sizeof(DeviceBinaryVariant::Header);
+        selectedBinarySize = sectionDataSize - sizeof(DeviceBinaryVariant::Header);
+    }
+    return true;
+}
+} // namespace OCLRT
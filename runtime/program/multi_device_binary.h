@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "elf/types.h"
+#include "igfxfmid.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+struct HardwareInfo;
+
+// Multi-device program binaries are executable ELFs that carry one SH_TYPE_OPENCL_DEV_BINARY_VARIANT
+// section per target, optionally next to an IR section used when none of the targets matches.
+// Every variant section starts with a Header followed by the device binary, so a variant can be
+// selected from its header alone: a variant built for the device's product is preferred over one
+// built for another product of the same core family.
+namespace DeviceBinaryVariant {
+constexpr uint32_t magic = 0x56424444; // "DDBV"
+
+struct Header {
+    uint32_t magic;
+    uint32_t coreFamily;    // GFXCORE_FAMILY
+    uint32_t productFamily; // PRODUCT_FAMILY
+    uint32_t reserved;
+};
+
+struct Desc {
+    GFXCORE_FAMILY coreFamily;
+    PRODUCT_FAMILY productFamily;
+    std::string deviceBinary;
+};
+} // namespace DeviceBinaryVariant
+
+class MultiDeviceBinaryWriter {
+  public:
+    static void write(const std::vector<DeviceBinaryVariant::Desc> &variants, const std::string &irBinary, bool isSpirV,
+                      const std::string &options, CLElfLib::ElfBinaryStorage &binary);
+};
+
+class DeviceBinaryVariantSelector {
+  public:
+    DeviceBinaryVariantSelector(const HardwareInfo &hwInfo);
+
+    // returns false for a malformed variant section
+    bool addVariant(const char *sectionData, size_t sectionDataSize);
+
+    bool hasVariants() const {
+        return numVariants > 0;
+    }
+    const char *getSelectedBinary() const {
+        return selectedBinary;
+    }
+    size_t getSelectedBinarySize() const {
+        return selectedBinarySize;
+    }
+
+  protected:
+    GFXCORE_FAMILY coreFamily;
+    PRODUCT_FAMILY productFamily;
+    uint32_t numVariants = 0;
+    bool exactMatch = false;
+    const char *selectedBinary = nullptr;
+    size_t selectedBinarySize = 0;
+};
+} // namespace OCLRT
@@ -24,7 +24,14 @@
 #include "elf/reader.h"
 #include "elf/writer.h"
 #include "program.h"
+#include "runtime/helpers/options.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/string.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/program/kernel_info_metadata.h"
+#include "runtime/program/multi_device_binary.h"
+
+#include <algorithm>
 
 namespace OCLRT {
 
@@ -36,6 +43,7 @@ cl_int Program::processElfBinary(
 
     binaryVersion = iOpenCL::CURRENT_ICBE_VERSION;
 
+    kernelMetadata.clear();
     elfBinarySize = binarySize;
     elfBinary = CLElfLib::ElfBinaryStorage(reinterpret_cast<const char *>(pBinary), reinterpret_cast<const char *>(reinterpret_cast<const char *>(pBinary) + binarySize));
 
@@ -60,6 +68,8 @@ cl_int Program::processElfBinary(
         default:
             return CL_INVALID_BINARY;
         }
+        DeviceBinaryVariantSelector variantSelector(pDevice ? pDevice->getHardwareInfo() : *platformDevices[0]);
+
         // section 0 is always null
         for (size_t i = 1u; i < elfReader.getSectionHeaders().size(); ++i) {
             const auto &sectionHeader = elfReader.getSectionHeaders()[i];
@@ -83,12 +93,25 @@ cl_int Program::processElfBinary(
                 }
                 break;
 
+            case CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY_VARIANT:
+                if (!variantSelector.addVariant(elfReader.getSectionData(sectionHeader.DataOffset), static_cast<size_t>(sectionHeader.DataSize))) {
+                    return CL_INVALID_BINARY;
+                }
+                break;
+
             case CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_OPTIONS:
                 if (sectionHeader.DataSize > 0) {
                     options = std::string(elfReader.getSectionData(sectionHeader.DataOffset), static_cast<size_t>(sectionHeader.DataSize));
                 }
                 break;
 
+            case CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_KERNEL_METADATA:
+                if (sectionHeader.DataSize > 0) {
+                    auto pMetadata = elfReader.getSectionData(sectionHeader.DataOffset);
+                    kernelMetadata.assign(pMetadata, pMetadata + static_cast<size_t>(sectionHeader.DataSize));
+                }
+                break;
+
             case CLElfLib::E_SH_TYPE::SH_TYPE_STR_TBL:
                 // We can skip the string table
                 break;
@@ -98,6 +121,20 @@ cl_int Program::processElfBinary(
             }
         }
 
+        if (variantSelector.hasVariants()) {
+            auto pSelectedBinary = variantSelector.getSelectedBinary();
+            if (pSelectedBinary && validateGenBinaryHeader(reinterpret_cast<const SProgramBinaryHeader *>(pSelectedBinary))) {
+                storeGenBinary(pSelectedBinary, variantSelector.getSelectedBinarySize());
+                isCreatedFromBinary = true;
+            } else {
+                // no bundled device binary is usable on this device, build it from the IR fallback instead
+                auto retVal = rebuildProgramFromIr();
+                if (retVal != CL_SUCCESS) {
+                    return CL_INVALID_BINARY;
+                }
+            }
+        }
+
         isProgramBinaryResolved = true;
 
         // Create an empty build log since program is effectively built
@@ -158,6 +195,15 @@ cl_int Program::resolveProgramBinary() {
             elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL Device Binary", std::move(genBinaryTemp), static_cast<uint32_t>(genBinarySize)));
         }
 
+        // Add precomputed kernel metadata, so kernels can be restored without parsing patch tokens
+        if (headerType == CLElfLib::E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE) {
+            encodeKernelMetadata();
+            if (!kernelMetadata.empty()) {
+                std::string kernelMetadataTemp(kernelMetadata.begin(), kernelMetadata.end());
+                elfWriter.addSection(CLElfLib::SSectionNode(CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_KERNEL_METADATA, CLElfLib::E_SH_FLAG::SH_FLAG_NONE, "Intel(R) OpenCL Kernel Metadata", std::move(kernelMetadataTemp), static_cast<uint32_t>(kernelMetadata.size())));
+            }
+        }
+
         // Add the device debug data if it exists
         if (debugData != nullptr) {
             std::string debugDataTemp = debugData ? std::string(debugData, debugDataSize) : "";
@@ -173,4 +219,36 @@ cl_int Program::resolveProgramBinary() {
     }
     return CL_SUCCESS;
 }
+
+void Program::encodeKernelMetadata() {
+    kernelMetadata.clear();
+    if (!genBinary || genBinarySize == 0 || DebugManager.flags.DisableKernelInfoMetadata.get()) {
+        return;
+    }
+
+    std::vector<const KernelInfo *> kernelInfos(kernelInfoArray.begin(), kernelInfoArray.end());
+    for (size_t i = 0; i < blockKernelManager->getCount(); i++) {
+        kernelInfos.push_back(blockKernelManager->getBlockKernelInfo(i));
+    }
+
+    auto pGenBinaryHeader = reinterpret_cast<const SProgramBinaryHeader *>(genBinary);
+    if (kernelInfos.size() != pGenBinaryHeader->NumberOfKernels) {
+        return;
+    }
+
+    // records follow the order of kernel blobs in the device binary
+    auto genBinaryEnd = ptrOffset(genBinary, genBinarySize);
+    for (auto kernelInfo : kernelInfos) {
+        if (kernelInfo->heapInfo.pBlob < genBinary || kernelInfo->heapInfo.pBlob >= genBinaryEnd) {
+            return;
+        }
+    }
+    std::sort(kernelInfos.begin(), kernelInfos.end(), [](const KernelInfo *lhs, const KernelInfo *rhs) {
+        return lhs->heapInfo.pBlob < rhs->heapInfo.pBlob;
+    });
+
+    if (!KernelInfoMetadataEncoder::encode(kernelInfos, kernelMetadata)) {
+        kernelMetadata.clear();
+    }
+}
 } // namespace OCLRT
@@ -32,6 +32,7 @@
 #include "runtime/kernel/kernel.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/gtpin/gtpin_notify.h"
+#include "runtime/program/kernel_info_metadata.h"
 
 #include <algorithm>
 
@@ -76,7 +77,8 @@ std::string Program::getKernelNamesString() const {
 
 size_t Program::processKernel(
     const void *pKernelBlob,
-    cl_int &retVal) {
+    cl_int &retVal,
+    KernelInfoMetadataDecoder *metadataDecoder) {
     size_t sizeProcessed = 0;
 
     do {
@@ -110,7 +112,24 @@ size_t Program::processKernel(
 
         pKernelInfo->heapInfo.pPatchList = pCurKernelPtr;
 
-        retVal = parsePatchList(*pKernelInfo);
+        auto decodeStatus = KernelInfoMetadataDecoder::DecodeStatus::KernelMismatch;
+        if (metadataDecoder && metadataDecoder->isValid()) {
+            const void *igcInfo = nullptr;
+            decodeStatus = metadataDecoder->decodeNextKernel(*pKernelInfo, igcInfo);
+            if (decodeStatus == KernelInfoMetadataDecoder::DecodeStatus::Success) {
+                if (igcInfo) {
+                    setIgcInfo(igcInfo);
+                }
+                initializeCrossThreadData(*pKernelInfo);
+                retVal = CL_SUCCESS;
+            } else if (decodeStatus == KernelInfoMetadataDecoder::DecodeStatus::InvalidMetadata) {
+                retVal = CL_INVALID_BINARY;
+            }
+        }
+
+        if (decodeStatus == KernelInfoMetadataDecoder::DecodeStatus::KernelMismatch) {
+            retVal = parsePatchList(*pKernelInfo);
+        }
         if (retVal != CL_SUCCESS) {
             delete pKernelInfo;
             sizeProcessed = ptrDiff(pCurKernelPtr, pKernelBlob);
@@ -160,9 +179,6 @@ cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
     auto pPatchList = kernelInfo.heapInfo.pPatchList;
     auto patchListSize = kernelInfo.heapInfo.pKernelHeader->PatchListSize;
     auto pCurPatchListPtr = pPatchList;
-    uint32_t PrivateMemoryStatelessSizeOffset = 0xFFffFFff;
-    uint32_t LocalMemoryStatelessWindowSizeOffset = 0xFFffFFff;
-    uint32_t LocalMemoryStatelessWindowStartAddressOffset = 0xFFffFFff;
 
     //Speed up containers by giving some pre-allocated storage
     kernelInfo.kernelArgInfo.reserve(10);
@@ -372,16 +388,15 @@ cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
 
             case DATA_PARAMETER_PRIVATE_MEMORY_STATELESS_SIZE:
                 DBG_LOG(LogPatchTokens, "\n  .Type", "PRIVATE_MEMORY_STATELESS_SIZE");
-                PrivateMemoryStatelessSizeOffset = pDataParameterBuffer->Offset;
+                kernelInfo.workloadInfo.privateMemoryStatelessSizeOffset = pDataParameterBuffer->Offset;
                 break;
             case DATA_PARAMETER_LOCAL_MEMORY_STATELESS_WINDOW_SIZE:
                 DBG_LOG(LogPatchTokens, "\n  .Type", "LOCAL_MEMORY_STATELESS_WINDOW_SIZE");
-                LocalMemoryStatelessWindowSizeOffset = pDataParameterBuffer->Offset;
+                kernelInfo.workloadInfo.localMemoryStatelessWindowSizeOffset = pDataParameterBuffer->Offset;
                 break;
             case DATA_PARAMETER_LOCAL_MEMORY_STATELESS_WINDOW_START_ADDRESS:
                 DBG_LOG(LogPatchTokens, "\n  .Type", "LOCAL_MEMORY_STATELESS_WINDOW_START_ADDRESS");
-                LocalMemoryStatelessWindowStartAddressOffset = pDataParameterBuffer->Offset;
-                pDevice->prepareSLMWindow();
+                kernelInfo.workloadInfo.localMemoryStatelessWindowStartAddressOffset = pDataParameterBuffer->Offset;
                 break;
             case DATA_PARAMETER_PREFERRED_WORKGROUP_MULTIPLE:
                 DBG_LOG(LogPatchTokens, "\n  .Type", "PREFERRED_WORKGROUP_MULTIPLE");
@@ -815,35 +830,84 @@ cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
         retVal = kernelInfo.resolveKernelInfo();
     }
 
+    initializeCrossThreadData(kernelInfo);
+
+    return retVal;
+}
+
+void Program::initializeCrossThreadData(KernelInfo &kernelInfo) {
+    const auto &workloadInfo = kernelInfo.workloadInfo;
+    if (workloadInfo.localMemoryStatelessWindowStartAddressOffset != WorkloadInfo::undefinedOffset) {
+        pDevice->prepareSLMWindow();
+    }
+
     if (kernelInfo.patchInfo.dataParameterStream && kernelInfo.patchInfo.dataParameterStream->DataParameterStreamSize) {
         uint32_t crossThreadDataSize = kernelInfo.patchInfo.dataParameterStream->DataParameterStreamSize;
         kernelInfo.crossThreadData = new char[crossThreadDataSize];
         memset(kernelInfo.crossThreadData, 0x00, crossThreadDataSize);
 
-        if (LocalMemoryStatelessWindowStartAddressOffset != 0xFFffFFff) {
-            *(uintptr_t *)&(kernelInfo.crossThreadData[LocalMemoryStatelessWindowStartAddressOffset]) = reinterpret_cast<uintptr_t>(this->pDevice->getSLMWindowStartAddress());
+        if (workloadInfo.localMemoryStatelessWindowStartAddressOffset != WorkloadInfo::undefinedOffset) {
+            *(uintptr_t *)&(kernelInfo.crossThreadData[workloadInfo.localMemoryStatelessWindowStartAddressOffset]) = reinterpret_cast<uintptr_t>(this->pDevice->getSLMWindowStartAddress());
+        }
+
+        if (workloadInfo.localMemoryStatelessWindowSizeOffset != WorkloadInfo::undefinedOffset) {
+            *(uint32_t *)&(kernelInfo.crossThreadData[workloadInfo.localMemoryStatelessWindowSizeOffset]) = (uint32_t)this->pDevice->getDeviceInfo().localMemSize;
         }
 
-        if (LocalMemoryStatelessWindowSizeOffset != 0xFFffFFff) {
-            *(uint32_t *)&(kernelInfo.crossThreadData[LocalMemoryStatelessWindowSizeOffset]) = (uint32_t)this->pDevice->getDeviceInfo().localMemSize;
+        if (kernelInfo.patchInfo.pAllocateStatelessPrivateSurface && (workloadInfo.privateMemoryStatelessSizeOffset != WorkloadInfo::undefinedOffset)) {
+            *(uint32_t *)&(kernelInfo.crossThreadData[workloadInfo.privateMemoryStatelessSizeOffset]) = kernelInfo.patchInfo.pAllocateStatelessPrivateSurface->PerThreadPrivateMemorySize * this->getDevice(0).getDeviceInfo().computeUnitsUsedForScratch * kernelInfo.getMaxSimdSize();
         }
 
-        if (kernelInfo.patchInfo.pAllocateStatelessPrivateSurface && (PrivateMemoryStatelessSizeOffset != 0xFFffFFff)) {
-            *(uint32_t *)&(kernelInfo.crossThreadData[PrivateMemoryStatelessSizeOffset]) = kernelInfo.patchInfo.pAllocateStatelessPrivateSurface->PerThreadPrivateMemorySize * this->getDevice(0).getDeviceInfo().computeUnitsUsedForScratch * kernelInfo.getMaxSimdSize();
+        if (workloadInfo.maxWorkGroupSizeOffset != WorkloadInfo::undefinedOffset) {
+            *(uint32_t *)&(kernelInfo.crossThreadData[workloadInfo.maxWorkGroupSizeOffset]) = (uint32_t)this->getDevice(0).getDeviceInfo().maxWorkGroupSize;
         }
+    }
 
-        if (kernelInfo.workloadInfo.maxWorkGroupSizeOffset != WorkloadInfo::undefinedOffset) {
-            *(uint32_t *)&(kernelInfo.crossThreadData[kernelInfo.workloadInfo.maxWorkGroupSizeOffset]) = (uint32_t)this->getDevice(0).getDeviceInfo().maxWorkGroupSize;
+    DEBUG_BREAK_IF(kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && !this->pDevice);
+}
+
+cl_int Program::createKernelIsaHeap() {
+    // ISA of all kernels without an allocation is packed into one instruction heap,
+    // each kernel starting at KSP aligned offset, with trailing padding for instruction prefetch
+    size_t isaHeapSize = 0;
+    for (auto &kernelInfo : kernelInfoArray) {
+        if (kernelInfo->kernelAllocation || kernelInfo->heapInfo.pKernelHeader->KernelHeapSize == 0) {
+            continue;
         }
+        isaHeapSize = alignUp(isaHeapSize, KernelInfo::kernelIsaAlignment);
+        isaHeapSize += kernelInfo->heapInfo.pKernelHeader->KernelHeapSize;
     }
 
-    if (kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && this->pDevice) {
-        retVal = kernelInfo.createKernelAllocation(this->pDevice->getMemoryManager()) ? CL_SUCCESS : CL_OUT_OF_HOST_MEMORY;
+    if (isaHeapSize == 0) {
+        return CL_SUCCESS;
     }
+    isaHeapSize += KernelInfo::kernelIsaPrefetchPadding;
 
-    DEBUG_BREAK_IF(kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && !this->pDevice);
+    auto isaHeap = this->pDevice->getMemoryManager()->allocate32BitGraphicsMemory(isaHeapSize, nullptr, AllocationOrigin::INTERNAL_ALLOCATION);
+    if (isaHeap == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+    kernelIsaHeaps.push_back(isaHeap);
+
+    auto isaHeapBuffer = isaHeap->getUnderlyingBuffer();
+    size_t isaHeapOffset = 0;
+    for (auto &kernelInfo : kernelInfoArray) {
+        auto kernelIsaSize = kernelInfo->heapInfo.pKernelHeader->KernelHeapSize;
+        if (kernelInfo->kernelAllocation || kernelIsaSize == 0) {
+            continue;
+        }
+        auto alignedOffset = alignUp(isaHeapOffset, KernelInfo::kernelIsaAlignment);
+        memset(ptrOffset(isaHeapBuffer, isaHeapOffset), 0, alignedOffset - isaHeapOffset);
+        memcpy_s(ptrOffset(isaHeapBuffer, alignedOffset), isaHeapSize - alignedOffset, kernelInfo->heapInfo.pKernelHeap, kernelIsaSize);
+
+        kernelInfo->kernelAllocation = isaHeap;
+        kernelInfo->kernelAllocationOffset = static_cast<uint32_t>(alignedOffset);
+        kernelInfo->isKernelAllocationShared = true;
+        isaHeapOffset = alignedOffset + kernelIsaSize;
+    }
+    memset(ptrOffset(isaHeapBuffer, isaHeapOffset), 0, isaHeapSize - isaHeapOffset);
 
-    return retVal;
+    return CL_SUCCESS;
 }
 
 cl_int Program::parseProgramScopePatchList() {
@@ -997,11 +1061,18 @@ cl_int Program::processGenBinary() {
         pCurBinaryPtr = ptrOffset(pCurBinaryPtr, pGenBinaryHeader->PatchListSize);
 
         auto numKernels = pGenBinaryHeader->NumberOfKernels;
+        KernelInfoMetadataDecoder metadataDecoder(kernelMetadata.data(), kernelMetadata.size(), numKernels);
+        bool useKernelMetadata = !kernelMetadata.empty() && !DebugManager.flags.DisableKernelInfoMetadata.get();
+
         for (uint32_t i = 0; i < numKernels && retVal == CL_SUCCESS; i++) {
 
-            size_t bytesProcessed = processKernel(pCurBinaryPtr, retVal);
+            size_t bytesProcessed = processKernel(pCurBinaryPtr, retVal, useKernelMetadata ? &metadataDecoder : nullptr);
             pCurBinaryPtr = ptrOffset(pCurBinaryPtr, bytesProcessed);
         }
+
+        if (retVal == CL_SUCCESS && this->pDevice) {
+            retVal = createKernelIsaHeap();
+        }
     } while (false);
 
     return retVal;
@@ -28,6 +28,7 @@
 #include "runtime/helpers/hw_helper.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/compiler_interface/compiler_interface.h"
+#include "runtime/compiler_interface/compiler_options.h"
 
 #include <sstream>
 
@@ -68,39 +69,25 @@ Program::Program(ExecutionEnvironment &executionEnvironment, Context *context, b
     programOptionVersion = 12u;
     allowNonUniform = false;
     char paramValue[32] = {};
-    bool force32BitAddressess = false;
 
     if (pDevice) {
         pDevice->getDeviceInfo(CL_DEVICE_VERSION, 32, paramValue, nullptr);
+        uint32_t clVersion = 0;
         if (strstr(paramValue, "2.1")) {
-            internalOptions = "-ocl-version=210 ";
+            clVersion = 21;
         } else if (strstr(paramValue, "2.0")) {
-            internalOptions = "-ocl-version=200 ";
+            clVersion = 20;
         } else if (strstr(paramValue, "1.2")) {
-            internalOptions = "-ocl-version=120 ";
-        }
-        force32BitAddressess = pDevice->getDeviceInfo().force32BitAddressess;
-
-        if (force32BitAddressess) {
-            internalOptions += "-m32 ";
-        }
-
-        if (DebugManager.flags.DisableStatelessToStatefulOptimization.get()) {
-            internalOptions += "-cl-intel-greater-than-4GB-buffer-required ";
+            clVersion = 12;
         }
         kernelDebugEnabled = pDevice->isSourceLevelDebuggerActive();
 
-        auto enableStatelessToStatefullWithOffset = pDevice->getHardwareCapabilities().isStatelesToStatefullWithOffsetSupported;
-        if (DebugManager.flags.EnableStatelessToStatefulBufferOffsetOpt.get() != -1) {
-            enableStatelessToStatefullWithOffset = DebugManager.flags.EnableStatelessToStatefulBufferOffsetOpt.get() != 0;
-        }
-
-        if (enableStatelessToStatefullWithOffset) {
-            internalOptions += "-cl-intel-has-buffer-offset-arg ";
-        }
+        internalOptions = CompilerOptions::getDeviceInternalOptions(clVersion,
+                                                                    pDevice->getDeviceInfo().force32BitAddressess,
+                                                                    pDevice->getHardwareCapabilities().isStatelesToStatefullWithOffsetSupported);
     }
 
-    internalOptions += "-fpreserve-vec3-type ";
+    internalOptions += CompilerOptions::preserveVec3Type;
 }
 
 Program::~Program() {
@@ -121,6 +108,8 @@ Program::~Program() {
 
     delete blockKernelManager;
 
+    freeKernelIsaHeaps();
+
     if (constantSurface) {
         this->executionEnvironment.memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(constantSurface);
         constantSurface = nullptr;
@@ -273,6 +262,7 @@ void Program::storeGenBinary(
     const void *pSrc,
     const size_t srcSize) {
     storeBinary(genBinary, genBinarySize, pSrc, srcSize);
+    kernelMetadata.clear();
 }
 
 void Program::storeIrBinary(
@@ -409,7 +399,7 @@ void Program::freeBlockResources() {
         }
         auto kernelInfo = blockKernelManager->getBlockKernelInfo(i);
         DEBUG_BREAK_IF(!kernelInfo->kernelAllocation);
-        if (kernelInfo->kernelAllocation) {
+        if (kernelInfo->kernelAllocation && !kernelInfo->isKernelAllocationShared) {
             this->executionEnvironment.memoryManager->freeGraphicsMemory(kernelInfo->kernelAllocation);
         }
     }
@@ -417,12 +407,24 @@ void Program::freeBlockResources() {
 
 void Program::cleanCurrentKernelInfo() {
     for (auto &kernelInfo : kernelInfoArray) {
-        if (kernelInfo->kernelAllocation) {
+        if (kernelInfo->kernelAllocation && !kernelInfo->isKernelAllocationShared) {
             this->executionEnvironment.memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(kernelInfo->kernelAllocation);
         }
         delete kernelInfo;
     }
     kernelInfoArray.clear();
+
+    // block kernels keep referencing ISA heap until program is destroyed
+    if (blockKernelManager->getCount() == 0) {
+        freeKernelIsaHeaps();
+    }
+}
+
+void Program::freeKernelIsaHeaps() {
+    for (auto &isaHeap : kernelIsaHeaps) {
+        this->executionEnvironment.memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(isaHeap);
+    }
+    kernelIsaHeaps.clear();
 }
 
 void Program::updateNonUniformFlag() {
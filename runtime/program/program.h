@@ -42,6 +42,7 @@ namespace OCLRT {
 class Context;
 class CompilerInterface;
 class ExecutionEnvironment;
+class KernelInfoMetadataDecoder;
 template <>
 struct OpenCLObjectMapper<_cl_program> {
     typedef class Program DerivedType;
@@ -266,7 +267,14 @@ class Program : public BaseObject<_cl_program> {
 
     cl_int parsePatchList(KernelInfo &pKernelInfo);
 
-    size_t processKernel(const void *pKernelBlob, cl_int &retVal);
+    size_t processKernel(const void *pKernelBlob, cl_int &retVal, KernelInfoMetadataDecoder *metadataDecoder = nullptr);
+
+    void initializeCrossThreadData(KernelInfo &kernelInfo);
+
+    void encodeKernelMetadata();
+
+    cl_int createKernelIsaHeap();
+    void freeKernelIsaHeaps();
 
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
 
@@ -297,11 +305,15 @@ class Program : public BaseObject<_cl_program> {
     char*                     debugData;
     size_t                    debugDataSize;
 
+    std::vector<char>         kernelMetadata;
+
     std::vector<KernelInfo*>  kernelInfoArray;
     std::vector<KernelInfo*>  parentKernelInfoArray;
     std::vector<KernelInfo*>  subgroupKernelInfoArray;
     BlockKernelManager *      blockKernelManager;
 
+    std::vector<GraphicsAllocation*> kernelIsaHeaps;
+
     const void*               programScopePatchList;
     size_t                    programScopePatchListSize;
 
@@ -24,18 +24,22 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/memory_manager/memory_manager.h"
-#include "runtime/utilities/idlist.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 namespace OCLRT {
 class GraphicsAllocation;
 
 template <typename TagType>
-struct TagNode : public IDNode<TagNode<TagType>> {
+struct TagNode {
   public:
     TagType *tag;
     GraphicsAllocation *getGraphicsAllocation() {
@@ -48,11 +52,27 @@ struct TagNode : public IDNode<TagNode<TagType>> {
     TagNode() = default;
     GraphicsAllocation *gfxAllocation;
     std::atomic<uint32_t> refCount{0};
+    uint32_t index = 0;
+    std::atomic<uint32_t> nextFreeIndex{0};
 
     template <typename TagType2>
     friend class TagAllocator;
 };
 
+namespace TagAllocatorConstants {
+// node index is chunk index in upper bits and position in chunk in lower bits
+constexpr uint32_t chunkIndexBits = 10;
+constexpr uint32_t nodeIndexBits = 22;
+constexpr uint32_t maxChunks = 1u << chunkIndexBits;
+constexpr uint32_t maxNodesPerChunk = (1u << nodeIndexBits) - 1;
+constexpr uint32_t invalidIndex = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t cacheSlots = 16;
+constexpr uint32_t cachedNodesPerSlot = 8;
+} // namespace TagAllocatorConstants
+
+// Free nodes are kept on a lock-free stack addressed by node indices, with a version counter
+// in the upper half of the head protecting from ABA. Returned nodes first go to small caches
+// selected by calling thread, so threads taking and returning tags rarely touch the shared head.
 template <typename TagType>
 class TagAllocator {
   public:
@@ -61,6 +81,9 @@ class TagAllocator {
     TagAllocator(MemoryManager *memMngr, size_t tagCount, size_t tagAlignment) : memoryManager(memMngr),
                                                                                  tagCount(tagCount),
                                                                                  tagAlignment(tagAlignment) {
+        for (auto &chunk : chunks) {
+            chunk = nullptr;
+        }
         populateFreeTags();
     }
 
@@ -69,6 +92,16 @@ class TagAllocator {
     }
 
     void cleanUpResources() {
+        std::unique_lock<std::mutex> lock(allocationsMutex);
+        freeHead = TagAllocatorConstants::invalidIndex;
+        for (auto &slot : cacheSlots) {
+            slot.numNodes = 0;
+        }
+        for (auto &chunk : chunks) {
+            chunk = nullptr;
+        }
+        numTags = 0;
+
         size_t size = gfxAllocations.size();
 
         for (uint32_t i = 0; i < size; ++i) {
@@ -84,12 +117,19 @@ class TagAllocator {
     }
 
     NodeType *getTag() {
-        NodeType *node = freeTags.removeFrontOne().release();
+        NodeType *node = popFromCache();
         if (!node) {
-            populateFreeTags();
-            node = freeTags.removeFrontOne().release();
+            node = popFromFreeTags();
+        }
+        while (!node) {
+            // nodes cached by threads hashed to other slots are reused before the pool grows
+            drainCacheSlots();
+            node = popFromFreeTags();
+            if (!node) {
+                populateFreeTags();
+                node = popFromFreeTags();
+            }
         }
-        usedTags.pushFrontOne(*node);
         node->incRefCount();
         return node;
     }
@@ -100,11 +140,52 @@ class TagAllocator {
         }
     }
 
+    // diagnostic helpers, not synchronized with concurrent getTag / returnTag calls
+    size_t peekNumTags() const {
+        return numTags;
+    }
+
+    bool peekIsFreeTag(const NodeType *node) const {
+        for (auto &slot : cacheSlots) {
+            if (std::find(slot.nodes.begin(), slot.nodes.begin() + slot.numNodes, node) != slot.nodes.begin() + slot.numNodes) {
+                return true;
+            }
+        }
+        for (auto index = static_cast<uint32_t>(freeHead.load()); index != TagAllocatorConstants::invalidIndex;) {
+            auto freeNode = getNode(index);
+            if (freeNode == node) {
+                return true;
+            }
+            index = freeNode->nextFreeIndex.load();
+        }
+        return false;
+    }
+
+    size_t peekNumFreeTags() const {
+        size_t numFreeTags = 0;
+        for (auto &slot : cacheSlots) {
+            numFreeTags += slot.numNodes;
+        }
+        for (auto index = static_cast<uint32_t>(freeHead.load()); index != TagAllocatorConstants::invalidIndex;) {
+            numFreeTags++;
+            index = getNode(index)->nextFreeIndex.load();
+        }
+        return numFreeTags;
+    }
+
   protected:
-    IDList<NodeType> freeTags;
-    IDList<NodeType> usedTags;
+    struct CacheSlot {
+        std::atomic<bool> busy{false};
+        uint32_t numNodes = 0;
+        std::array<NodeType *, TagAllocatorConstants::cachedNodesPerSlot> nodes;
+    };
+
+    std::atomic<uint64_t> freeHead{TagAllocatorConstants::invalidIndex};
+    std::array<std::atomic<NodeType *>, TagAllocatorConstants::maxChunks> chunks;
+    std::array<CacheSlot, TagAllocatorConstants::cacheSlots> cacheSlots;
     std::vector<GraphicsAllocation *> gfxAllocations;
     std::vector<NodeType *> tagPoolMemory;
+    size_t numTags = 0;
 
     MemoryManager *memoryManager;
     size_t tagCount;
@@ -113,19 +194,107 @@ class TagAllocator {
     std::mutex allocationsMutex;
 
     MOCKABLE_VIRTUAL void returnTagToPool(NodeType *node) {
-        NodeType *usedNode = usedTags.removeOne(*node).release();
-        DEBUG_BREAK_IF(usedNode == nullptr);
-        ((void)(usedNode));
-        freeTags.pushFrontOne(*node);
+        if (!pushToCache(node)) {
+            pushToFreeTags(node, node);
+        }
+    }
+
+    NodeType *getNode(uint32_t index) const {
+        auto chunk = chunks[index >> TagAllocatorConstants::nodeIndexBits].load(std::memory_order_acquire);
+        return chunk + (index & ((1u << TagAllocatorConstants::nodeIndexBits) - 1));
     }
 
+    static uint64_t makeHead(uint64_t previousHead, uint32_t index) {
+        return ((previousHead >> 32) + 1) << 32 | index;
+    }
+
+    // pushes already linked nodes from first to last
+    void pushToFreeTags(NodeType *first, NodeType *last) {
+        uint64_t head = freeHead.load(std::memory_order_relaxed);
+        do {
+            last->nextFreeIndex.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        } while (!freeHead.compare_exchange_weak(head, makeHead(head, first->index), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    NodeType *popFromFreeTags() {
+        uint64_t head = freeHead.load(std::memory_order_acquire);
+        NodeType *node = nullptr;
+        do {
+            auto index = static_cast<uint32_t>(head);
+            if (index == TagAllocatorConstants::invalidIndex) {
+                return nullptr;
+            }
+            node = getNode(index);
+        } while (!freeHead.compare_exchange_weak(head, makeHead(head, node->nextFreeIndex.load(std::memory_order_relaxed)), std::memory_order_acquire, std::memory_order_acquire));
+        return node;
+    }
+
+    CacheSlot &getCacheSlot() {
+        static thread_local size_t slotIndex = std::hash<std::thread::id>()(std::this_thread::get_id()) % TagAllocatorConstants::cacheSlots;
+        return cacheSlots[slotIndex];
+    }
+
+    // cache slots are only tried, threads colliding on a slot fall back to the free list
+    bool pushToCache(NodeType *node) {
+        auto &slot = getCacheSlot();
+        if (slot.busy.exchange(true, std::memory_order_acquire)) {
+            return false;
+        }
+        bool cached = false;
+        if (slot.numNodes < TagAllocatorConstants::cachedNodesPerSlot) {
+            slot.nodes[slot.numNodes++] = node;
+            cached = true;
+        }
+        slot.busy.store(false, std::memory_order_release);
+        return cached;
+    }
+
+    NodeType *popFromCache() {
+        auto &slot = getCacheSlot();
+        if (slot.busy.exchange(true, std::memory_order_acquire)) {
+            return nullptr;
+        }
+        NodeType *node = nullptr;
+        if (slot.numNodes > 0) {
+            node = slot.nodes[--slot.numNodes];
+        }
+        slot.busy.store(false, std::memory_order_release);
+        return node;
+    }
+
+    void drainCacheSlots() {
+        for (auto &slot : cacheSlots) {
+            while (slot.busy.exchange(true, std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            auto numNodes = slot.numNodes;
+            slot.numNodes = 0;
+            for (uint32_t i = 1; i < numNodes; i++) {
+                slot.nodes[i - 1]->nextFreeIndex.store(slot.nodes[i]->index, std::memory_order_relaxed);
+            }
+            NodeType *first = numNodes > 0 ? slot.nodes[0] : nullptr;
+            NodeType *last = numNodes > 0 ? slot.nodes[numNodes - 1] : nullptr;
+            slot.busy.store(false, std::memory_order_release);
+
+            if (first) {
+                pushToFreeTags(first, last);
+            }
+        }
+    }
+
+    // only growing threads are serialized, threads taking and returning tags never wait here
     void populateFreeTags() {
+        std::unique_lock<std::mutex> lock(allocationsMutex);
+        if (static_cast<uint32_t>(freeHead.load(std::memory_order_acquire)) != TagAllocatorConstants::invalidIndex) {
+            return;
+        }
 
         size_t tagSize = sizeof(TagType);
         tagSize = alignUp(tagSize, tagAlignment);
         size_t allocationSizeRequired = tagCount * tagSize;
 
-        std::unique_lock<std::mutex> lock(allocationsMutex);
+        auto chunkIndex = static_cast<uint32_t>(tagPoolMemory.size());
+        UNRECOVERABLE_IF(chunkIndex >= TagAllocatorConstants::maxChunks);
 
         GraphicsAllocation *graphicsAllocation = memoryManager->allocateGraphicsMemory(allocationSizeRequired);
         gfxAllocations.push_back(graphicsAllocation);
@@ -133,19 +302,24 @@ class TagAllocator {
         uintptr_t Size = graphicsAllocation->getUnderlyingBufferSize();
         uintptr_t Start = reinterpret_cast<uintptr_t>(graphicsAllocation->getUnderlyingBuffer());
         uintptr_t End = Start + Size;
-        size_t nodeCount = Size / tagSize;
+        size_t nodeCount = std::min(Size / tagSize, static_cast<size_t>(TagAllocatorConstants::maxNodesPerChunk));
 
         NodeType *nodesMemory = new NodeType[nodeCount];
 
         for (size_t i = 0; i < nodeCount; ++i) {
             nodesMemory[i].gfxAllocation = graphicsAllocation;
             nodesMemory[i].tag = reinterpret_cast<TagType *>(Start);
-            freeTags.pushTailOne(nodesMemory[i]);
+            nodesMemory[i].index = (chunkIndex << TagAllocatorConstants::nodeIndexBits) | static_cast<uint32_t>(i);
+            nodesMemory[i].nextFreeIndex = nodesMemory[i].index + 1;
             Start += tagSize;
         }
         DEBUG_BREAK_IF(Start > End);
         ((void)(End));
         tagPoolMemory.push_back(nodesMemory);
+        numTags += nodeCount;
+
+        chunks[chunkIndex].store(nodesMemory, std::memory_order_release);
+        pushToFreeTags(&nodesMemory[0], &nodesMemory[nodeCount - 1]);
     }
 };
 } // namespace OCLRT
@@ -46,6 +46,7 @@
 #include "unit_tests/api/cl_set_default_device_command_queue_tests.inl"
 #include "unit_tests/api/cl_set_event_callback_tests.inl"
 #include "unit_tests/api/cl_set_kernel_arg_svm_pointer_tests.inl"
+#include "unit_tests/api/cl_set_kernel_args_intel_tests.inl"
 #include "unit_tests/api/cl_set_kernel_exec_info_tests.inl"
 #include "unit_tests/api/cl_set_mem_object_destructor_callback_tests.inl"
 #include "unit_tests/api/cl_set_performance_configuration_tests.inl"
@@ -421,4 +421,41 @@ INSTANTIATE_TEST_CASE_P(AllValidThrottleValues,
                         clCreateCommandQueueWithPropertiesApiThrottle,
                         ::testing::ValuesIn(throttleParams));
 
+std::pair<uint32_t, WaitStrategy> waitStrategyParams[5]{
+    std::make_pair(CL_QUEUE_WAIT_STRATEGY_YIELD_INTEL, WaitStrategy::Yield),
+    std::make_pair(CL_QUEUE_WAIT_STRATEGY_SPIN_INTEL, WaitStrategy::Spin),
+    std::make_pair(CL_QUEUE_WAIT_STRATEGY_BACKOFF_INTEL, WaitStrategy::Backoff),
+    std::make_pair(CL_QUEUE_WAIT_STRATEGY_SLEEP_INTEL, WaitStrategy::Sleep),
+    std::make_pair(CL_QUEUE_WAIT_STRATEGY_ADAPTIVE_INTEL, WaitStrategy::Adaptive)};
+
+class clCreateCommandQueueWithPropertiesApiWaitStrategy : public clCreateCommandQueueWithPropertiesApi,
+                                                          public ::testing::WithParamInterface<std::pair<uint32_t, WaitStrategy>> {
+};
+
+TEST_P(clCreateCommandQueueWithPropertiesApiWaitStrategy, givenCreateQueueWithWaitStrategyPropertyThenSetCorrectWaitStrategyInternally) {
+    cl_int retVal = CL_SUCCESS;
+    cl_queue_properties properties[] = {CL_QUEUE_WAIT_STRATEGY_INTEL, GetParam().first, 0};
+    auto cmdq = clCreateCommandQueueWithProperties(pContext, devices[0], properties, &retVal);
+    EXPECT_NE(nullptr, cmdq);
+    EXPECT_EQ(retVal, CL_SUCCESS);
+
+    auto commandQueue = castToObject<CommandQueue>(cmdq);
+    EXPECT_EQ(commandQueue->getWaitStrategy(), GetParam().second);
+
+    retVal = clReleaseCommandQueue(cmdq);
+    EXPECT_EQ(retVal, CL_SUCCESS);
+}
+
+INSTANTIATE_TEST_CASE_P(AllValidWaitStrategies,
+                        clCreateCommandQueueWithPropertiesApiWaitStrategy,
+                        ::testing::ValuesIn(waitStrategyParams));
+
+TEST_F(clCreateCommandQueueWithPropertiesApi, givenInvalidWaitStrategyWhenQueueIsCreatedThenReturnError) {
+    cl_int retVal = CL_SUCCESS;
+    cl_queue_properties properties[] = {CL_QUEUE_WAIT_STRATEGY_INTEL, CL_QUEUE_WAIT_STRATEGY_ADAPTIVE_INTEL + 1, 0};
+    auto cmdq = clCreateCommandQueueWithProperties(pContext, devices[0], properties, &retVal);
+    EXPECT_EQ(nullptr, cmdq);
+    EXPECT_EQ(retVal, CL_INVALID_QUEUE_PROPERTIES);
+}
+
 } // namespace ULT
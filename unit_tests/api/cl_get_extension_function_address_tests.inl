@@ -66,4 +66,9 @@ TEST_F(clGetExtensionFunctionAddressTests, clSetPerformanceConfigurationINTEL) {
     auto retVal = clGetExtensionFunctionAddress("clSetPerformanceConfigurationINTEL");
     EXPECT_EQ(retVal, reinterpret_cast<void *>(clSetPerformanceConfigurationINTEL));
 }
+
+TEST_F(clGetExtensionFunctionAddressTests, clSetKernelArgsINTEL) {
+    auto retVal = clGetExtensionFunctionAddress("clSetKernelArgsINTEL");
+    EXPECT_EQ(retVal, reinterpret_cast<void *>(clSetKernelArgsINTEL));
+}
 } // namespace ULT
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/svm_memory_manager.h"
+#include "cl_api_tests.h"
+#include "unit_tests/fixtures/device_fixture.h"
+#include "unit_tests/mocks/mock_kernel.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+class KernelArgsIntelFixture : public api_fixture, public DeviceFixture {
+  protected:
+    void SetUp() override {
+        api_fixture::SetUp();
+        DeviceFixture::SetUp();
+
+        pKernelInfo = std::make_unique<KernelInfo>();
+
+        kernelHeader.SurfaceStateHeapSize = sizeof(pSshLocal);
+        pKernelInfo->heapInfo.pSsh = pSshLocal;
+        pKernelInfo->heapInfo.pKernelHeader = &kernelHeader;
+        pKernelInfo->usesSsh = true;
+        pKernelInfo->requiresSshForBuffers = true;
+
+        KernelArgPatchInfo kernelArgPatchInfo;
+        pKernelInfo->kernelArgInfo.resize(2);
+
+        pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector.push_back(kernelArgPatchInfo);
+        pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset = 0x30;
+        pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].size = static_cast<uint32_t>(sizeof(void *));
+        pKernelInfo->kernelArgInfo[0].typeStr = "char *";
+        pKernelInfo->kernelArgInfo[0].addressQualifier = CL_KERNEL_ARG_ADDRESS_GLOBAL;
+
+        pKernelInfo->kernelArgInfo[1].kernelArgPatchInfoVector.push_back(kernelArgPatchInfo);
+        pKernelInfo->kernelArgInfo[1].kernelArgPatchInfoVector[0].crossthreadOffset = 0x20;
+        pKernelInfo->kernelArgInfo[1].kernelArgPatchInfoVector[0].size = static_cast<uint32_t>(sizeof(cl_uint));
+        pKernelInfo->kernelArgInfo[1].typeStr = "uint";
+        pKernelInfo->kernelArgInfo[1].addressQualifier = CL_KERNEL_ARG_ADDRESS_PRIVATE;
+
+        pMockKernel = new MockKernel(pProgram, *pKernelInfo, *pPlatform->getDevice(0));
+        ASSERT_EQ(CL_SUCCESS, pMockKernel->initialize());
+        pMockKernel->setCrossThreadData(pCrossThreadData, sizeof(pCrossThreadData));
+    }
+
+    void TearDown() override {
+        delete pMockKernel;
+
+        DeviceFixture::TearDown();
+        api_fixture::TearDown();
+    }
+
+    cl_uint getImmediateArg() {
+        return *reinterpret_cast<cl_uint *>(ptrOffset(pMockKernel->getCrossThreadData(), 0x20));
+    }
+
+    MockKernel *pMockKernel = nullptr;
+    std::unique_ptr<KernelInfo> pKernelInfo;
+    SKernelBinaryHeaderCommon kernelHeader;
+    char pSshLocal[64] = {};
+    char pCrossThreadData[64] = {};
+};
+
+typedef Test<KernelArgsIntelFixture> clSetKernelArgsINTELTests;
+
+namespace ULT {
+
+TEST_F(clSetKernelArgsINTELTests, givenNullKernelWhenSettingArgsThenInvalidKernelIsReturned) {
+    cl_uint value = 7;
+    cl_kernel_arg_desc_intel argDesc = {1, CL_KERNEL_ARG_VALUE_INTEL, sizeof(value), &value};
+
+    auto retVal = clSetKernelArgsINTEL(nullptr, 1, &argDesc);
+    EXPECT_EQ(CL_INVALID_KERNEL, retVal);
+}
+
+TEST_F(clSetKernelArgsINTELTests, givenNoArgDescsWhenSettingArgsThenInvalidValueIsReturned) {
+    cl_uint value = 7;
+    cl_kernel_arg_desc_intel argDesc = {1, CL_KERNEL_ARG_VALUE_INTEL, sizeof(value), &value};
+
+    auto retVal = clSetKernelArgsINTEL(pMockKernel, 0, &argDesc);
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+
+    retVal = clSetKernelArgsINTEL(pMockKernel, 1, nullptr);
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+}
+
+TEST_F(clSetKernelArgsINTELTests, givenValueAndSvmPointerArgsWhenSettingArgsThenAllArgsArePatched) {
+    cl_uint value = 7;
+    cl_kernel_arg_desc_intel argDescs[] = {
+        {1, CL_KERNEL_ARG_VALUE_INTEL, sizeof(value), &value},
+        {0, CL_KERNEL_ARG_SVM_POINTER_INTEL, 0, nullptr}};
+
+    auto retVal = clSetKernelArgsINTEL(pMockKernel, 2, argDescs);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_EQ(value, getImmediateArg());
+    EXPECT_TRUE(pMockKernel->getKernelArgInfo(0).isPatched);
+    EXPECT_TRUE(pMockKernel->getKernelArgInfo(1).isPatched);
+    EXPECT_TRUE(pMockKernel->isPatched());
+}
+
+TEST_F(clSetKernelArgsINTELTests, givenSvmAllocationWhenSettingSvmPointerArgThenArgIsPatchedWithSvmPointer) {
+    const DeviceInfo &devInfo = pDevice->getDeviceInfo();
+    if (devInfo.svmCapabilities != 0) {
+        void *ptrSvm = clSVMAlloc(pContext, CL_MEM_READ_WRITE, 256, 4);
+        EXPECT_NE(nullptr, ptrSvm);
+
+        cl_kernel_arg_desc_intel argDesc = {0, CL_KERNEL_ARG_SVM_POINTER_INTEL, 0, ptrSvm};
+        auto retVal = clSetKernelArgsINTEL(pMockKernel, 1, &argDesc);
+        EXPECT_EQ(CL_SUCCESS, retVal);
+
+        auto patchedPtr = *reinterpret_cast<void **>(ptrOffset(pMockKernel->getCrossThreadData(), 0x30));
+        EXPECT_EQ(ptrSvm, patchedPtr);
+        EXPECT_EQ(Kernel::SVM_ALLOC_OBJ, pMockKernel->getKernelArgInfo(0).type);
+
+        clSVMFree(pContext, ptrSvm);
+    }
+}
+
+TEST_F(clSetKernelArgsINTELTests, givenHostPointerWhenSettingSvmPointerArgThenInvalidArgValueIsReturned) {
+    char hostMemory[256];
+    cl_kernel_arg_desc_intel argDesc = {0, CL_KERNEL_ARG_SVM_POINTER_INTEL, 0, hostMemory};
+
+    auto retVal = clSetKernelArgsINTEL(pMockKernel, 1, &argDesc);
+    EXPECT_EQ(CL_INVALID_ARG_VALUE, retVal);
+    EXPECT_FALSE(pMockKernel->getKernelArgInfo(0).isPatched);
+}
+
+TEST_F(clSetKernelArgsINTELTests, givenInvalidArgIndexWhenSettingArgsThenPrecedingArgsAreSetAndInvalidArgIndexIsReturned) {
+    cl_uint value = 7;
+    cl_kernel_arg_desc_intel argDescs[] = {
+        {1, CL_KERNEL_ARG_VALUE_INTEL, sizeof(value), &value},
+        {2, CL_KERNEL_ARG_VALUE_INTEL, sizeof(value), &value},
+        {0, CL_KERNEL_ARG_SVM_POINTER_INTEL, 0, nullptr}};
+
+    auto retVal = clSetKernelArgsINTEL(pMockKernel, 3, argDescs);
+    EXPECT_EQ(CL_INVALID_ARG_INDEX, retVal);
+
+    EXPECT_EQ(value, getImmediateArg());
+    EXPECT_TRUE(pMockKernel->getKernelArgInfo(1).isPatched);
+    EXPECT_FALSE(pMockKernel->getKernelArgInfo(0).isPatched);
+}
+
+TEST_F(clSetKernelArgsINTELTests, givenInvalidArgIndexForSvmPointerWhenSettingArgsThenInvalidArgIndexIsReturned) {
+    cl_kernel_arg_desc_intel argDesc = {2, CL_KERNEL_ARG_SVM_POINTER_INTEL, 0, nullptr};
+
+    auto retVal = clSetKernelArgsINTEL(pMockKernel, 1, &argDesc);
+    EXPECT_EQ(CL_INVALID_ARG_INDEX, retVal);
+}
+
+TEST_F(clSetKernelArgsINTELTests, givenUnknownArgKindWhenSettingArgsThenInvalidValueIsReturned) {
+    cl_uint value = 7;
+    cl_kernel_arg_desc_intel argDesc = {1, 0, sizeof(value), &value};
+
+    auto retVal = clSetKernelArgsINTEL(pMockKernel, 1, &argDesc);
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+    EXPECT_FALSE(pMockKernel->getKernelArgInfo(1).isPatched);
+}
+
+TEST_F(clSetKernelArgsINTELTests, givenSvmPointerForPrivateArgWhenSettingArgsThenInvalidArgValueIsReturned) {
+    cl_kernel_arg_desc_intel argDesc = {1, CL_KERNEL_ARG_SVM_POINTER_INTEL, 0, nullptr};
+
+    auto retVal = clSetKernelArgsINTEL(pMockKernel, 1, &argDesc);
+    EXPECT_EQ(CL_INVALID_ARG_VALUE, retVal);
+}
+} // namespace ULT
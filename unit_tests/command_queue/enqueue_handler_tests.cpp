@@ -349,3 +349,78 @@ HWTEST_F(EnqueueHandlerTest, givenEnqueueHandlerWhenSubCaptureIsOnThenActivateSu
 
     mockCmdQ->release();
 }
+
+HWTEST_F(EnqueueHandlerTest, givenQueueLocalRecordingEnabledWhenKernelIsEnqueuedThenCommandsAreRecordedIntoQueueStorageAndSplicedIntoQueueCommandStream) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableQueueLocalRecording.set(true);
+
+    MockKernelWithInternals kernelInternals(*pDevice, context);
+    auto &csr = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    auto mockCmdQ = std::unique_ptr<MockCommandQueueHw<FamilyType>>(new MockCommandQueueHw<FamilyType>(context, pDevice, 0));
+
+    size_t gws[] = {1, 1, 1};
+    auto retVal = mockCmdQ->enqueueKernel(kernelInternals.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_FALSE(mockCmdQ->isRecordingLocally());
+    ASSERT_NE(nullptr, mockCmdQ->recordingCommandStream);
+    EXPECT_EQ(0u, mockCmdQ->recordingCommandStream->getUsed());
+    EXPECT_NE(0u, mockCmdQ->getCS(0).getUsed());
+
+    for (auto heapType : {IndirectHeap::DYNAMIC_STATE, IndirectHeap::INDIRECT_OBJECT, IndirectHeap::SURFACE_STATE}) {
+        ASSERT_NE(nullptr, mockCmdQ->recordingHeaps[heapType]);
+        if (csr.indirectHeap[heapType]) {
+            EXPECT_EQ(0u, csr.indirectHeap[heapType]->getUsed());
+        }
+    }
+
+    auto recordingDsh = mockCmdQ->recordingHeaps[IndirectHeap::DYNAMIC_STATE];
+    auto dshUsed = recordingDsh->getUsed();
+    EXPECT_NE(0u, dshUsed);
+    EXPECT_EQ(1u, mockCmdQ->taskCount);
+
+    retVal = mockCmdQ->enqueueKernel(kernelInternals.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_EQ(recordingDsh, mockCmdQ->recordingHeaps[IndirectHeap::DYNAMIC_STATE]);
+    EXPECT_LT(dshUsed, recordingDsh->getUsed());
+    EXPECT_EQ(0u, mockCmdQ->recordingCommandStream->getUsed());
+    EXPECT_EQ(2u, mockCmdQ->taskCount);
+}
+
+HWTEST_F(EnqueueHandlerTest, givenQueueLocalRecordingDisabledWhenKernelIsEnqueuedThenQueueStorageIsNotUsed) {
+    MockKernelWithInternals kernelInternals(*pDevice, context);
+    auto mockCmdQ = std::unique_ptr<MockCommandQueueHw<FamilyType>>(new MockCommandQueueHw<FamilyType>(context, pDevice, 0));
+
+    size_t gws[] = {1, 1, 1};
+    auto retVal = mockCmdQ->enqueueKernel(kernelInternals.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_EQ(nullptr, mockCmdQ->recordingCommandStream);
+    for (auto heap : mockCmdQ->recordingHeaps) {
+        EXPECT_EQ(nullptr, heap);
+    }
+    EXPECT_NE(0u, mockCmdQ->getCS(0).getUsed());
+}
+
+HWTEST_F(EnqueueHandlerTest, givenQueueLocalRecordingEnabledWhenQueueIsBlockedThenCommandsAreNotRecordedLocally) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableQueueLocalRecording.set(true);
+
+    MockKernelWithInternals kernelInternals(*pDevice, context);
+    auto mockCmdQ = std::unique_ptr<MockCommandQueueHw<FamilyType>>(new MockCommandQueueHw<FamilyType>(context, pDevice, 0));
+
+    UserEvent userEvent(context);
+    cl_event waitList[] = {&userEvent};
+
+    size_t gws[] = {1, 1, 1};
+    auto retVal = mockCmdQ->enqueueKernel(kernelInternals.mockKernel, 1, nullptr, gws, nullptr, 1, waitList, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_FALSE(mockCmdQ->isRecordingLocally());
+    EXPECT_EQ(nullptr, mockCmdQ->recordingCommandStream);
+
+    userEvent.setStatus(CL_COMPLETE);
+    EXPECT_EQ(nullptr, mockCmdQ->recordingCommandStream);
+    EXPECT_FALSE(mockCmdQ->isQueueBlocked());
+}
@@ -20,9 +20,18 @@
 * OTHER DEALINGS IN THE SOFTWARE.
 */
 
+#include "runtime/event/event.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/memory_manager/memory_manager.h"
+#include "runtime/utilities/tag_allocator.h"
 #include "unit_tests/mocks/mock_csr.h"
 #include "unit_tests/fixtures/hello_world_fixture.h"
 #include "unit_tests/command_queue/enqueue_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_command_queue.h"
+#include "unit_tests/mocks/mock_context.h"
+#include "unit_tests/mocks/mock_device.h"
 #include "unit_tests/mocks/mock_submissions_aggregator.h"
 
 typedef HelloWorldFixture<HelloWorldFixtureFactory> EnqueueKernelFixture;
@@ -82,3 +91,116 @@ HWTEST_F(EnqueueKernelTest, givenCsrInBatchingModeWhenFinishIsCalledThenBatchesS
 
     EXPECT_EQ(mockedSubmissionsAggregator->peekInspectionId() - 1, (uint32_t)mockCsr->flushCalledCount);
 }
+
+HWTEST_F(EnqueueKernelTest, givenQueueLocalRecordingWhenSameKernelIsEnqueuedFromTwoQueuesThenEachIndirectHeapHoldsItsOwnDispatchParameters) {
+    typedef typename FamilyType::GPGPU_WALKER GPGPU_WALKER;
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableQueueLocalRecording.set(true);
+
+    MockContext context(pDevice);
+    MockKernelWithInternals mockKernel(*pDevice, &context);
+    mockKernel.dataParameterStream.DataParameterStreamSize = 64;
+    mockKernel.kernelInfo.workloadInfo.globalWorkOffsetOffsets[0] = 0;
+    mockKernel.kernelInfo.workloadInfo.globalWorkSizeOffsets[0] = 4;
+    ASSERT_EQ(CL_SUCCESS, mockKernel.mockKernel->initialize());
+
+    std::unique_ptr<MockCommandQueueHw<FamilyType>> cmdQs[2];
+    for (auto &cmdQ : cmdQs) {
+        cmdQ.reset(new MockCommandQueueHw<FamilyType>(&context, pDevice, nullptr));
+    }
+
+    std::atomic<bool> startEnqueueProcess(false);
+    std::atomic<uint32_t> mismatchedDispatches(0);
+    auto enqueueCount = 32;
+
+    auto function = [&](uint32_t queueIndex) {
+        auto &cmdQ = *cmdQs[queueIndex];
+        size_t offset[3] = {16u * (queueIndex + 1), 0, 0};
+        size_t gws[3] = {64u * (queueIndex + 1), 1, 1};
+
+        //wait until we are signalled
+        while (!startEnqueueProcess)
+            ;
+        for (int enqueue = 0; enqueue < enqueueCount; enqueue++) {
+            auto ioh = cmdQ.recordingHeaps[IndirectHeap::INDIRECT_OBJECT];
+            auto iohBase = ioh ? ioh->getCpuBase() : nullptr;
+            auto iohUsed = ioh ? ioh->getUsed() : 0u;
+
+            EXPECT_EQ(CL_SUCCESS, cmdQ.enqueueKernel(mockKernel.mockKernel, 1, offset, gws, nullptr, 0, nullptr, nullptr));
+
+            ioh = cmdQ.recordingHeaps[IndirectHeap::INDIRECT_OBJECT];
+            if (ioh->getCpuBase() != iohBase || ioh->getUsed() < iohUsed) {
+                iohUsed = 0;
+            }
+            auto crossThreadData = reinterpret_cast<uint32_t *>(ptrOffset(ioh->getCpuBase(), alignUp(iohUsed, GPGPU_WALKER::INDIRECTDATASTARTADDRESS_ALIGN_SIZE)));
+            if (crossThreadData[0] != offset[0] || crossThreadData[1] != gws[0]) {
+                mismatchedDispatches++;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t queueIndex = 0; queueIndex < 2; queueIndex++) {
+        threads.push_back(std::thread(function, queueIndex));
+    }
+    startEnqueueProcess = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0u, mismatchedDispatches);
+    EXPECT_FALSE(mockKernel.mockKernel->hasOwnership());
+    EXPECT_EQ(mockKernel.mockKernel->takeOwnershipCalls, mockKernel.mockKernel->releaseOwnershipCalls);
+}
+
+HWTEST_F(EnqueueKernelTest, givenQueueLocalRecordingWhenFirstProfiledEnqueuesRunOnTwoQueuesConcurrentlyThenTagsComeFromSingleAllocators) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableQueueLocalRecording.set(true);
+    DebugManager.flags.EnableTimestampPacket.set(true);
+
+    cl_queue_properties properties[] = {CL_QUEUE_PROPERTIES, CL_QUEUE_PROFILING_ENABLE, 0};
+    size_t gws[3] = {1, 1, 1};
+    auto iterationCount = 8;
+
+    for (int iteration = 0; iteration < iterationCount; iteration++) {
+        // tag allocators of a new device are created by the first profiled enqueues
+        std::unique_ptr<MockDevice> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+        MockContext context(device.get());
+        MockKernelWithInternals mockKernel(*device, &context);
+
+        std::unique_ptr<MockCommandQueueHw<FamilyType>> cmdQs[2];
+        for (auto &cmdQ : cmdQs) {
+            cmdQ.reset(new MockCommandQueueHw<FamilyType>(&context, device.get(), properties));
+        }
+
+        std::atomic<bool> startEnqueueProcess(false);
+        cl_event events[2] = {nullptr, nullptr};
+
+        auto function = [&](uint32_t queueIndex) {
+            //wait until we are signalled
+            while (!startEnqueueProcess)
+                ;
+            EXPECT_EQ(CL_SUCCESS, cmdQs[queueIndex]->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, &events[queueIndex]));
+        };
+
+        std::vector<std::thread> threads;
+        for (uint32_t queueIndex = 0; queueIndex < 2; queueIndex++) {
+            threads.push_back(std::thread(function, queueIndex));
+        }
+        startEnqueueProcess = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        auto memoryManager = device->getMemoryManager();
+        auto tsAllocator = memoryManager->getEventTsAllocator();
+        auto timestampPacketAllocator = memoryManager->getTimestampPacketAllocator();
+        EXPECT_EQ(tsAllocator->peekNumTags() - 2, tsAllocator->peekNumFreeTags());
+        EXPECT_EQ(timestampPacketAllocator->peekNumTags() - 2, timestampPacketAllocator->peekNumFreeTags());
+
+        for (auto &event : events) {
+            ASSERT_NE(nullptr, event);
+            castToObjectOrAbort<Event>(event)->release();
+        }
+    }
+}
@@ -1804,3 +1804,47 @@ HWCMDTEST_F(IGFX_GEN8_CORE, EnqueueAuxKernelTests, givenParentKernelWhenAuxTrans
         EXPECT_EQ(1u, cmdQ.waitCalled);
     }
 }
+
+HWTEST_F(EnqueueKernelTest, givenCommandStreamReceiverInImmediateModeWhenKernelIsEnqueuedRepeatedlyThenSteadyStateEnqueuesDoNotAllocate) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideDispatchPolicy(DispatchMode::ImmediateDispatch);
+
+    MockKernelWithInternals mockKernel(*pDevice, context);
+    size_t gws[3] = {1, 0, 0};
+    auto retVal = pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    auto allocationsBefore = MemoryManagement::fastEventsAllocatedCount.load();
+    for (int i = 0; i < 4; i++) {
+        pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    }
+    auto allocationsAfter = MemoryManagement::fastEventsAllocatedCount.load();
+    EXPECT_EQ(allocationsBefore, allocationsAfter);
+}
+
+HWTEST_F(EnqueueKernelTest, givenCommandStreamReceiverInBatchingModeWhenKernelIsEnqueuedAfterFlushThenRecycledCommandBuffersAreUsedAndEnqueuesDoNotAllocate) {
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.overrideDispatchPolicy(DispatchMode::BatchedDispatch);
+    auto submissionAggregator = commandStreamReceiver.submissionAggregator.get();
+
+    MockKernelWithInternals mockKernel(*pDevice, context);
+    size_t gws[3] = {1, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    }
+    auto retVal = clFlush(pCmdQ);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_TRUE(submissionAggregator->peekCmdBufferList().peekIsEmpty());
+    EXPECT_FALSE(submissionAggregator->peekFreeCmdBufferList().peekIsEmpty());
+
+    auto allocationsBefore = MemoryManagement::fastEventsAllocatedCount.load();
+    for (int i = 0; i < 4; i++) {
+        pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+    }
+    auto allocationsAfter = MemoryManagement::fastEventsAllocatedCount.load();
+    EXPECT_EQ(allocationsBefore, allocationsAfter);
+    EXPECT_TRUE(submissionAggregator->peekFreeCmdBufferList().peekIsEmpty());
+
+    retVal = clFlush(pCmdQ);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+}
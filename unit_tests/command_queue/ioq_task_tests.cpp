@@ -22,6 +22,7 @@
 
 #include "unit_tests/command_queue/enqueue_fixture.h"
 #include "unit_tests/fixtures/hello_world_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 
 using namespace OCLRT;
 
@@ -118,3 +119,57 @@ TEST_F(IOQ, enqueueReadBuffer_blockingAndNonBlockedOnUserEvent) {
 
     alignedFree(alignedReadPtr);
 }
+
+TEST_F(IOQ, givenCsrDependencyTrackingWhenEventOfOtherQueueIsStillRunningThenItsTaskLevelIsInherited) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableCsrDependencyTracking.set(true);
+    auto tagAddress = pDevice->getCommandStreamReceiver().getTagAddress();
+    *tagAddress = 0;
+
+    auto producerQueue = createCommandQueue(pDevice, 0);
+    producerQueue->taskLevel = pCmdQ->taskLevel + 10;
+    cl_event producerEvent;
+    cl_event consumerEvent;
+    EnqueueKernelHelper<>::enqueueKernel(producerQueue, pKernel, EnqueueKernelTraits::workDim, nullptr, EnqueueKernelTraits::globalWorkSize, nullptr, 0, nullptr, &producerEvent);
+    EnqueueKernelHelper<>::enqueueKernel(pCmdQ, pKernel, EnqueueKernelTraits::workDim, nullptr, EnqueueKernelTraits::globalWorkSize, nullptr, 1, &producerEvent, &consumerEvent);
+
+    auto producer = castToObject<Event>(producerEvent);
+    auto consumer = castToObject<Event>(consumerEvent);
+    EXPECT_EQ(producer->taskLevel + 1, pCmdQ->taskLevel);
+
+    CsrDependencies dependencies;
+    consumer->collectCsrDependencies(dependencies);
+    EXPECT_EQ(1u, dependencies.size());
+    EXPECT_EQ(consumer->peekTaskCount(), dependencies.peekTaskCount(pDevice->getCommandStreamReceiver()));
+    EXPECT_TRUE(dependencies.isCovering(pDevice->getCommandStreamReceiver(), producer->peekTaskCount()));
+
+    *tagAddress = initialHardwareTag;
+    clReleaseEvent(consumerEvent);
+    clReleaseEvent(producerEvent);
+    producerQueue->release();
+}
+
+TEST_F(IOQ, givenCsrDependencyTrackingWhenEventOfOtherQueueIsCompletedOnCsrThenItsTaskLevelIsNotInherited) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableCsrDependencyTracking.set(true);
+    auto tagAddress = pDevice->getCommandStreamReceiver().getTagAddress();
+    *tagAddress = 0;
+
+    auto producerQueue = createCommandQueue(pDevice, 0);
+    producerQueue->taskLevel = pCmdQ->taskLevel + 10;
+    cl_event producerEvent;
+    EnqueueKernelHelper<>::enqueueKernel(producerQueue, pKernel, EnqueueKernelTraits::workDim, nullptr, EnqueueKernelTraits::globalWorkSize, nullptr, 0, nullptr, &producerEvent);
+
+    auto producer = castToObject<Event>(producerEvent);
+    *tagAddress = producer->peekTaskCount();
+    EXPECT_TRUE(producer->isCompletedOnCsr());
+
+    auto previousTaskLevel = pCmdQ->taskLevel;
+    EnqueueKernelHelper<>::enqueueKernel(pCmdQ, pKernel, EnqueueKernelTraits::workDim, nullptr, EnqueueKernelTraits::globalWorkSize, nullptr, 1, &producerEvent, nullptr);
+    EXPECT_EQ(previousTaskLevel + 1, pCmdQ->taskLevel);
+    EXPECT_LT(pCmdQ->taskLevel, producer->taskLevel);
+
+    *tagAddress = initialHardwareTag;
+    clReleaseEvent(producerEvent);
+    producerQueue->release();
+}
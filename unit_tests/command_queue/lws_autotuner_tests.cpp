@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/gpgpu_walker.h"
+#include "runtime/command_queue/lws_autotuner.h"
+#include "runtime/helpers/dispatch_info.h"
+#include "runtime/helpers/file_io.h"
+#include "unit_tests/mocks/mock_device.h"
+#include "unit_tests/mocks/mock_kernel.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <sstream>
+
+using namespace OCLRT;
+
+TEST(LwsAutotunerTest, given1DimGwsWhenCandidatesAreGeneratedThenHeuristicComesFirstFollowedByDividingPowersOfTwo) {
+    WorkSizeInfo wsInfo(256, false, 16, 0u, platformDevices[0]->pPlatform->eRenderCoreFamily, 32u, 0u, false, false);
+    auto candidates = LwsAutotuner::generateCandidates({256, 1, 1}, {1024, 1, 1}, 1, wsInfo, 4);
+
+    ASSERT_EQ(4u, candidates.size());
+    EXPECT_EQ(Vec3<size_t>(256, 1, 1), candidates[0]);
+    EXPECT_EQ(Vec3<size_t>(128, 1, 1), candidates[1]);
+    EXPECT_EQ(Vec3<size_t>(64, 1, 1), candidates[2]);
+    EXPECT_EQ(Vec3<size_t>(32, 1, 1), candidates[3]);
+}
+
+TEST(LwsAutotunerTest, given2DimGwsWhenCandidatesAreGeneratedThenEachCandidateDividesGwsAndFitsMaxWorkGroupSize) {
+    WorkSizeInfo wsInfo(256, false, 8, 0u, platformDevices[0]->pPlatform->eRenderCoreFamily, 32u, 0u, false, false);
+    auto candidates = LwsAutotuner::generateCandidates({16, 16, 1}, {64, 48, 1}, 2, wsInfo, 4);
+
+    ASSERT_EQ(4u, candidates.size());
+    EXPECT_EQ(Vec3<size_t>(16, 16, 1), candidates[0]);
+    EXPECT_EQ(Vec3<size_t>(64, 4, 1), candidates[1]);
+    EXPECT_EQ(Vec3<size_t>(32, 8, 1), candidates[2]);
+    EXPECT_EQ(Vec3<size_t>(8, 24, 1), candidates[3]);
+}
+
+TEST(LwsAutotunerTest, givenKernelWithBarriersWhenCandidatesAreGeneratedThenCandidatesBelowMinWorkGroupSizeAreSkipped) {
+    WorkSizeInfo wsInfo(256, true, 32, 0u, platformDevices[0]->pPlatform->eRenderCoreFamily, 56u, 0u, false, false);
+    ASSERT_LT(32u, wsInfo.minWorkGroupSize);
+    auto candidates = LwsAutotuner::generateCandidates({256, 1, 1}, {1024, 1, 1}, 1, wsInfo, 8);
+
+    for (auto &candidate : candidates) {
+        EXPECT_GE(candidate.x, wsInfo.minWorkGroupSize);
+    }
+}
+
+TEST(LwsAutotunerTest, givenWorkgroupSizeWhenValidatedThenEnqueueWorkSizeRulesAreApplied) {
+    EXPECT_TRUE(LwsAutotuner::isValidWorkgroupSize({64, 4, 1}, {256, 16, 1}, 2, 256, false));
+    EXPECT_FALSE(LwsAutotuner::isValidWorkgroupSize({64, 8, 1}, {256, 16, 1}, 2, 256, false));
+    EXPECT_FALSE(LwsAutotuner::isValidWorkgroupSize({48, 1, 1}, {256, 1, 1}, 1, 256, false));
+    EXPECT_TRUE(LwsAutotuner::isValidWorkgroupSize({48, 1, 1}, {256, 1, 1}, 1, 256, true));
+    EXPECT_FALSE(LwsAutotuner::isValidWorkgroupSize({512, 1, 1}, {256, 1, 1}, 1, 1024, true));
+    EXPECT_FALSE(LwsAutotuner::isValidWorkgroupSize({0, 1, 1}, {256, 1, 1}, 1, 256, true));
+    EXPECT_FALSE(LwsAutotuner::isValidWorkgroupSize({64, 2, 1}, {256, 16, 1}, 1, 256, false));
+}
+
+struct LwsAutotunerSelectionTest : public ::testing::Test {
+    void SetUp() override {
+        device.reset(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+        kernel.reset(new MockKernelWithInternals(*device));
+        key = {kernel->mockKernel->getIsaHash(), 1, {1024, 1, 1}};
+    }
+
+    DispatchInfo getDispatchInfo() {
+        return DispatchInfo(kernel->mockKernel, 1, key.gws, {0, 0, 0}, {0, 0, 0});
+    }
+
+    std::unique_ptr<MockDevice> device;
+    std::unique_ptr<MockKernelWithInternals> kernel;
+    LwsAutotuner::Key key = {0, 0, {0, 0, 0}};
+};
+
+TEST_F(LwsAutotunerSelectionTest, givenUnknownKeyWhenSamplesCannotBeMeasuredThenHeuristicIsUsed) {
+    LwsAutotuner autotuner("", 2, 1);
+    Vec3<size_t> lws = {0, 0, 0};
+    uint32_t candidate = 0;
+
+    EXPECT_FALSE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), false, lws, candidate));
+    EXPECT_EQ(LwsAutotuner::noCandidate, candidate);
+}
+
+TEST_F(LwsAutotunerSelectionTest, givenAllSamplesReportedWhenWorkgroupSizeIsSelectedThenFastestCandidateIsUsed) {
+    LwsAutotuner autotuner("", 2, 1);
+    Vec3<size_t> lws[2] = {{0, 0, 0}, {0, 0, 0}};
+    uint32_t candidate = LwsAutotuner::noCandidate;
+
+    EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), true, lws[0], candidate));
+    EXPECT_EQ(0u, candidate);
+    EXPECT_EQ(canonizeWorkgroup(computeWorkgroupSize(getDispatchInfo())), lws[0]);
+    EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), true, lws[1], candidate));
+    EXPECT_EQ(1u, candidate);
+    EXPECT_NE(lws[0], lws[1]);
+
+    Vec3<size_t> heuristicLws = {0, 0, 0};
+    EXPECT_FALSE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), true, heuristicLws, candidate));
+    EXPECT_EQ(LwsAutotuner::noCandidate, candidate);
+
+    autotuner.reportSample(key, 0, true, 100);
+    autotuner.reportSample(key, 1, true, 50);
+
+    Vec3<size_t> selectedLws = {0, 0, 0};
+    EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), false, selectedLws, candidate));
+    EXPECT_EQ(LwsAutotuner::noCandidate, candidate);
+    EXPECT_EQ(lws[1], selectedLws);
+}
+
+TEST_F(LwsAutotunerSelectionTest, givenSampleNotCompletedWhenWorkgroupSizeIsSelectedThenCandidateIsSampledAgain) {
+    LwsAutotuner autotuner("", 2, 1);
+    Vec3<size_t> lws = {0, 0, 0};
+    uint32_t candidate = LwsAutotuner::noCandidate;
+
+    EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), true, lws, candidate));
+    EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), true, lws, candidate));
+    autotuner.reportSample(key, 0, false, 0);
+
+    EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), true, lws, candidate));
+    EXPECT_EQ(0u, candidate);
+}
+
+TEST_F(LwsAutotunerSelectionTest, givenSavedResultsWhenLoadedByNewAutotunerThenDecisionIsReusedWithoutSampling) {
+    std::string fileName("lws_autotuner_results.lws_cache");
+    std::remove(fileName.c_str());
+
+    Vec3<size_t> tunedLws = {0, 0, 0};
+    {
+        LwsAutotuner autotuner(fileName, 2, 1);
+        uint32_t candidate = LwsAutotuner::noCandidate;
+        EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), true, tunedLws, candidate));
+        EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), true, tunedLws, candidate));
+        autotuner.reportSample(key, 0, true, 100);
+        autotuner.reportSample(key, 1, true, 10);
+    }
+
+    LwsAutotuner autotuner(fileName, 2, 1);
+    EXPECT_TRUE(autotuner.loadResults());
+
+    Vec3<size_t> lws = {0, 0, 0};
+    uint32_t candidate = LwsAutotuner::noCandidate;
+    EXPECT_TRUE(autotuner.selectWorkgroupSize(key, getDispatchInfo(), false, lws, candidate));
+    EXPECT_EQ(LwsAutotuner::noCandidate, candidate);
+    EXPECT_EQ(tunedLws, lws);
+
+    std::remove(fileName.c_str());
+}
+
+TEST(LwsAutotunerTest, givenNoResultsFileWhenResultsAreLoadedThenFalseIsReturned) {
+    LwsAutotuner autotuner("", 4, 2);
+    EXPECT_FALSE(autotuner.loadResults());
+    EXPECT_FALSE(autotuner.saveResults());
+}
+
+TEST_F(LwsAutotunerSelectionTest, givenResultsFileWithInvalidWorkgroupSizesWhenLoadedThenTheyAreNeverSelected) {
+    std::string fileName("lws_autotuner_invalid_results.lws_cache");
+    auto maxWorkGroupSize = kernel->mockKernel->getMaxKernelWorkGroupSize();
+    LwsAutotuner::Key tooLargeKey = {key.kernelHash, 1, {maxWorkGroupSize * 4, 1, 1}};
+    LwsAutotuner::Key nonDividingKey = {key.kernelHash, 1, {maxWorkGroupSize, 1, 1}};
+
+    std::ostringstream results;
+    results << std::hex << key.kernelHash << std::dec << " 1 " << key.gws.x << " 1 1 " << key.gws.x * 2 << " 1 1\n";
+    results << std::hex << tooLargeKey.kernelHash << std::dec << " 1 " << tooLargeKey.gws.x << " 1 1 " << maxWorkGroupSize * 2 << " 1 1\n";
+    results << std::hex << nonDividingKey.kernelHash << std::dec << " 1 " << nonDividingKey.gws.x << " 1 1 " << maxWorkGroupSize - 1 << " 1 1\n";
+    auto data = results.str();
+    ASSERT_EQ(data.size(), writeDataToFile(fileName.c_str(), data.c_str(), data.size()));
+
+    LwsAutotuner autotuner(fileName, 2, 1);
+    EXPECT_TRUE(autotuner.loadResults());
+
+    ASSERT_FALSE(kernel->mockKernel->getAllowNonUniform());
+    for (auto &testedKey : {key, tooLargeKey, nonDividingKey}) {
+        Vec3<size_t> lws = {0, 0, 0};
+        uint32_t candidate = LwsAutotuner::noCandidate;
+        DispatchInfo dispatchInfo(kernel->mockKernel, 1, testedKey.gws, {0, 0, 0}, {0, 0, 0});
+        EXPECT_FALSE(autotuner.selectWorkgroupSize(testedKey, dispatchInfo, false, lws, candidate));
+        EXPECT_EQ(LwsAutotuner::noCandidate, candidate);
+    }
+
+    std::remove(fileName.c_str());
+}
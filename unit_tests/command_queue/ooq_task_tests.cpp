@@ -22,7 +22,9 @@
 
 #include "unit_tests/command_queue/enqueue_fixture.h"
 #include "unit_tests/fixtures/hello_world_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_csr.h"
+#include "unit_tests/mocks/mock_kernel.h"
 
 using namespace OCLRT;
 
@@ -293,3 +295,61 @@ TEST_F(OOQTaskTests, givenOutOfOrderCommandQueueWhenBarrierIsCalledThenTaskLevel
 
     EXPECT_GT(newTaskLevel, currentTaskLevel);
 }
+
+HWTEST_F(OOQTaskTests, givenHazardTrackingWhenDependentEnqueuesAccessDisjointMemoryThenTaskLevelIsNotIncreased) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableOOQHazardTracking.set(true);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0], *pDevice->executionEnvironment);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideDispatchPolicy(DispatchMode::BatchedDispatch);
+    auto tagAddress = mockCsr->getTagAddress();
+    *tagAddress = 0;
+
+    MockKernelWithInternals firstKernel(*pDevice);
+    MockKernelWithInternals secondKernel(*pDevice);
+    size_t gws[] = {1, 1, 1};
+    auto currentTaskLevel = this->pCmdQ->taskLevel;
+
+    cl_event firstEvent;
+    cl_event secondEvent;
+    this->pCmdQ->enqueueKernel(firstKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, &firstEvent);
+    this->pCmdQ->enqueueKernel(secondKernel.mockKernel, 1, nullptr, gws, nullptr, 1, &firstEvent, &secondEvent);
+
+    EXPECT_EQ(currentTaskLevel, this->pCmdQ->taskLevel);
+    EXPECT_EQ(castToObject<Event>(firstEvent)->taskLevel, castToObject<Event>(secondEvent)->taskLevel);
+    EXPECT_NE(nullptr, castToObject<Event>(secondEvent)->peekMemoryAccessSet());
+    EXPECT_TRUE(mockCsr->passedDispatchFlags.outOfOrderExecutionAllowed);
+
+    *tagAddress = initialHardwareTag;
+    clReleaseEvent(secondEvent);
+    clReleaseEvent(firstEvent);
+}
+
+HWTEST_F(OOQTaskTests, givenHazardTrackingWhenDependentEnqueuesWriteSameMemoryThenTaskLevelIsIncreased) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableOOQHazardTracking.set(true);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0], *pDevice->executionEnvironment);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    mockCsr->overrideDispatchPolicy(DispatchMode::BatchedDispatch);
+    auto tagAddress = mockCsr->getTagAddress();
+    *tagAddress = 0;
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    GraphicsAllocation privateSurface(reinterpret_cast<void *>(0x1000), 0x1000);
+    mockKernel.mockKernel->setPrivateSurface(&privateSurface, 0x1000);
+    size_t gws[] = {1, 1, 1};
+
+    cl_event firstEvent;
+    cl_event secondEvent;
+    this->pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, &firstEvent);
+    this->pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 1, &firstEvent, &secondEvent);
+
+    EXPECT_EQ(castToObject<Event>(firstEvent)->taskLevel + 1, castToObject<Event>(secondEvent)->taskLevel);
+
+    *tagAddress = initialHardwareTag;
+    clReleaseEvent(secondEvent);
+    clReleaseEvent(firstEvent);
+    mockKernel.mockKernel->setPrivateSurface(nullptr, 0);
+}
@@ -2499,7 +2499,7 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenWaitForT
     auto cmdBuffer = cmdBufferList.peekHead();
     EXPECT_EQ(1u, cmdBuffer->taskCount);
 
-    mockCsr->waitForCompletionWithTimeout(false, 1, 1);
+    mockCsr->waitForCompletionWithTimeout(false, 1, 1, WaitStrategy::Yield);
 
     EXPECT_EQ(1u, mockCsr->peekLatestFlushedTaskCount());
 
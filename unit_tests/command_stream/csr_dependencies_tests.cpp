@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/csr_dependencies.h"
+#include "runtime/helpers/options.h"
+#include "unit_tests/mocks/mock_device.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+struct CsrDependenciesTest : public ::testing::Test {
+    void SetUp() override {
+        device.reset(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+        tagAddress = device->getCommandStreamReceiver().getTagAddress();
+        *tagAddress = 0;
+    }
+
+    void TearDown() override {
+        *tagAddress = initialHardwareTag;
+    }
+
+    std::unique_ptr<MockDevice> device;
+    volatile uint32_t *tagAddress = nullptr;
+};
+
+TEST_F(CsrDependenciesTest, givenTaskCountsOfSameCsrWhenAddedThenKeepOnlyHighestOne) {
+    auto &csr = device->getCommandStreamReceiver();
+    CsrDependencies dependencies;
+    EXPECT_TRUE(dependencies.empty());
+    EXPECT_EQ(0u, dependencies.peekTaskCount(csr));
+
+    dependencies.add(csr, 5);
+    dependencies.add(csr, 3);
+    EXPECT_EQ(1u, dependencies.size());
+    EXPECT_EQ(5u, dependencies.peekTaskCount(csr));
+    EXPECT_TRUE(dependencies.isCovering(csr, 4));
+    EXPECT_FALSE(dependencies.isCovering(csr, 6));
+
+    CsrDependencies laterDependencies;
+    laterDependencies.add(csr, 7);
+    dependencies.merge(laterDependencies);
+    EXPECT_EQ(1u, dependencies.size());
+    EXPECT_EQ(7u, dependencies.peekTaskCount(csr));
+}
+
+TEST_F(CsrDependenciesTest, givenDependenciesOnDifferentCsrsWhenSatisfiedOnesAreRemovedThenOnlyRunningOnesAreLeft) {
+    std::unique_ptr<MockDevice> otherDevice(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    auto &csr = device->getCommandStreamReceiver();
+    auto &otherCsr = otherDevice->getCommandStreamReceiver();
+    auto otherTagAddress = otherCsr.getTagAddress();
+    *otherTagAddress = 0;
+
+    CsrDependencies dependencies;
+    dependencies.add(csr, 2);
+    dependencies.add(otherCsr, 4);
+    EXPECT_EQ(2u, dependencies.size());
+
+    *tagAddress = 2;
+    *otherTagAddress = 3;
+    EXPECT_TRUE(CsrDependencies::isSatisfied(csr, 2));
+    EXPECT_FALSE(CsrDependencies::isSatisfied(otherCsr, 4));
+
+    dependencies.removeSatisfied();
+    EXPECT_EQ(1u, dependencies.size());
+    EXPECT_EQ(0u, dependencies.peekTaskCount(csr));
+    EXPECT_EQ(4u, dependencies.peekTaskCount(otherCsr));
+
+    *otherTagAddress = 4;
+    dependencies.removeSatisfied();
+    EXPECT_TRUE(dependencies.empty());
+    *otherTagAddress = initialHardwareTag;
+}
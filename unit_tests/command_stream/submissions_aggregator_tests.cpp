@@ -622,3 +622,76 @@ HWTEST_F(SubmissionsAggregatorTests, givenMultipleCmdBuffersWhenNotAggregatedDur
     castToObject<Event>(event1)->release();
     castToObject<Event>(event2)->release();
 }
+
+TEST(SubmissionsAggregator, givenRecycledCommandBufferWhenCommandBufferIsObtainedThenRecycledBufferIsReturnedWithResetState) {
+    SubmissionAggregator submissionsAggregator;
+    std::unique_ptr<Device> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    GraphicsAllocation alloc(nullptr, 1);
+
+    auto cmdBuffer = submissionsAggregator.obtainCommandBuffer(*device);
+    ASSERT_NE(nullptr, cmdBuffer);
+    cmdBuffer->surfaces.push_back(&alloc);
+    cmdBuffer->taskCount = 5u;
+    cmdBuffer->inspectionId = 3u;
+    submissionsAggregator.recordCommandBuffer(cmdBuffer);
+
+    submissionsAggregator.recycleCommandBuffer(submissionsAggregator.peekCmdBufferList().removeFrontOne());
+    EXPECT_TRUE(submissionsAggregator.peekCmdBufferList().peekIsEmpty());
+    EXPECT_EQ(cmdBuffer, submissionsAggregator.peekFreeCmdBufferList().peekHead());
+
+    auto recycledCmdBuffer = submissionsAggregator.obtainCommandBuffer(*device);
+    EXPECT_EQ(cmdBuffer, recycledCmdBuffer);
+    EXPECT_TRUE(submissionsAggregator.peekFreeCmdBufferList().peekIsEmpty());
+    EXPECT_EQ(0u, recycledCmdBuffer->surfaces.size());
+    EXPECT_LE(1u, recycledCmdBuffer->surfaces.capacity());
+    EXPECT_EQ(0u, recycledCmdBuffer->taskCount);
+    EXPECT_EQ(0u, recycledCmdBuffer->inspectionId);
+    EXPECT_EQ(nullptr, recycledCmdBuffer->batchBuffer.commandBufferAllocation);
+    delete recycledCmdBuffer;
+}
+
+TEST(SubmissionsAggregator, givenRecycledCommandBufferFromOtherDeviceWhenCommandBufferIsObtainedThenNewBufferIsCreated) {
+    SubmissionAggregator submissionsAggregator;
+    std::unique_ptr<Device> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    std::unique_ptr<Device> otherDevice(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+
+    submissionsAggregator.recycleCommandBuffer(std::unique_ptr<CommandBuffer>(new CommandBuffer(*otherDevice)));
+
+    std::unique_ptr<CommandBuffer> cmdBuffer(submissionsAggregator.obtainCommandBuffer(*device));
+    EXPECT_EQ(device.get(), &cmdBuffer->device);
+    EXPECT_TRUE(submissionsAggregator.peekFreeCmdBufferList().peekIsEmpty());
+}
+
+TEST(SubmissionsAggregator, givenFullFreeListWhenCommandBufferIsRecycledThenItIsDeleted) {
+    SubmissionAggregator submissionsAggregator;
+    std::unique_ptr<Device> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+
+    for (size_t i = 0; i < SubmissionAggregator::maxFreeCmdBuffers + 4; i++) {
+        submissionsAggregator.recycleCommandBuffer(std::unique_ptr<CommandBuffer>(new CommandBuffer(*device)));
+    }
+    auto freeCmdBuffer = submissionsAggregator.peekFreeCmdBufferList().peekHead();
+    ASSERT_NE(nullptr, freeCmdBuffer);
+    EXPECT_EQ(SubmissionAggregator::maxFreeCmdBuffers, freeCmdBuffer->countThisAndAllConnected());
+
+    std::unique_ptr<CommandBuffer> cmdBuffer(submissionsAggregator.obtainCommandBuffer(*device));
+    submissionsAggregator.recycleCommandBuffer(std::move(cmdBuffer));
+    EXPECT_EQ(SubmissionAggregator::maxFreeCmdBuffers, submissionsAggregator.peekFreeCmdBufferList().peekHead()->countThisAndAllConnected());
+}
+
+TEST(SubmissionsAggregator, givenCommandBufferWithFlushStampWhenItIsRecycledThenFlushStampObjectIsReleased) {
+    SubmissionAggregator submissionsAggregator;
+    std::unique_ptr<Device> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    FlushStampTracker queueFlushStamp(true);
+    auto stampObject = queueFlushStamp.getStampReference();
+
+    auto cmdBuffer = submissionsAggregator.obtainCommandBuffer(*device);
+    cmdBuffer->flushStamp->replaceStampObject(stampObject);
+    EXPECT_EQ(2, stampObject->getRefInternalCount());
+
+    submissionsAggregator.recycleCommandBuffer(std::unique_ptr<CommandBuffer>(cmdBuffer));
+    EXPECT_EQ(1, stampObject->getRefInternalCount());
+
+    std::unique_ptr<CommandBuffer> recycledCmdBuffer(submissionsAggregator.obtainCommandBuffer(*device));
+    EXPECT_EQ(cmdBuffer, recycledCmdBuffer.get());
+    EXPECT_EQ(nullptr, recycledCmdBuffer->flushStamp->getStampReference());
+}
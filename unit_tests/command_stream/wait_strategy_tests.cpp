@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/command_stream/wait_strategy.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_device.h"
+#include "public/cl_ext_private.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+TEST(WaitHistogramTest, givenWaitDurationWhenBucketIsComputedThenUsePowersOfTwoMicroseconds) {
+    EXPECT_EQ(0u, WaitHistogram::getBucket(0));
+    EXPECT_EQ(1u, WaitHistogram::getBucket(1));
+    EXPECT_EQ(2u, WaitHistogram::getBucket(2));
+    EXPECT_EQ(2u, WaitHistogram::getBucket(3));
+    EXPECT_EQ(11u, WaitHistogram::getBucket(1024));
+    EXPECT_EQ(WaitHistogram::numBuckets - 1, WaitHistogram::getBucket(INT64_MAX));
+}
+
+TEST(WaitHistogramTest, givenRecordedWaitsThenCountThemPerStrategy) {
+    WaitHistogram histogram;
+    histogram.record(WaitStrategy::Spin, 3);
+    histogram.record(WaitStrategy::Spin, 2);
+    histogram.record(WaitStrategy::Sleep, 100);
+
+    EXPECT_EQ(2u, histogram.getCount(WaitStrategy::Spin, 2));
+    EXPECT_EQ(2u, histogram.getTotalCount(WaitStrategy::Spin));
+    EXPECT_EQ(1u, histogram.getCount(WaitStrategy::Sleep, WaitHistogram::getBucket(100)));
+    EXPECT_EQ(0u, histogram.getTotalCount(WaitStrategy::Yield));
+}
+
+TEST(WaitStrategyHelperTest, givenQueuePropertyValueWhenWaitStrategyIsObtainedThenMapItOrFallBackToDefault) {
+    DebugManagerStateRestore restore;
+    EXPECT_EQ(WaitStrategy::Yield, WaitStrategyHelper::getWaitStrategy(0));
+    EXPECT_EQ(WaitStrategy::Spin, WaitStrategyHelper::getWaitStrategy(CL_QUEUE_WAIT_STRATEGY_SPIN_INTEL));
+    EXPECT_EQ(WaitStrategy::Adaptive, WaitStrategyHelper::getWaitStrategy(CL_QUEUE_WAIT_STRATEGY_ADAPTIVE_INTEL));
+    EXPECT_EQ(WaitStrategy::Yield, WaitStrategyHelper::getWaitStrategy(CL_QUEUE_WAIT_STRATEGY_ADAPTIVE_INTEL + 1));
+
+    DebugManager.flags.OverrideWaitStrategy.set(static_cast<int32_t>(WaitStrategy::Sleep));
+    EXPECT_EQ(WaitStrategy::Sleep, WaitStrategyHelper::getDefaultWaitStrategy());
+    EXPECT_EQ(WaitStrategy::Sleep, WaitStrategyHelper::getWaitStrategy(CL_QUEUE_WAIT_STRATEGY_SPIN_INTEL));
+}
+
+TEST(WaitStrategyHelperTest, givenAnyStrategyWhenWaitStepIsCalledThenItReturns) {
+    for (int32_t strategy = 0; strategy < static_cast<int32_t>(WaitStrategy::Count); strategy++) {
+        WaitStrategyHelper::waitStep(static_cast<WaitStrategy>(strategy), 0);
+        WaitStrategyHelper::waitStep(static_cast<WaitStrategy>(strategy), WaitStrategyHelper::adaptiveYieldIterations);
+    }
+}
+
+TEST(WaitStrategyTest, givenTagNotReachedWhenWaitingWithTimeoutThenRecordWaitInHistogramOfUsedStrategy) {
+    std::unique_ptr<MockDevice> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    auto &csr = device->getCommandStreamReceiver();
+    *csr.getTagAddress() = 0;
+
+    EXPECT_FALSE(csr.waitForCompletionWithTimeout(true, 1, 1, WaitStrategy::Spin));
+    EXPECT_EQ(1u, csr.getWaitHistogram().getTotalCount(WaitStrategy::Spin));
+
+    EXPECT_TRUE(csr.waitForCompletionWithTimeout(true, 1, 0, WaitStrategy::Backoff));
+    EXPECT_EQ(0u, csr.getWaitHistogram().getTotalCount(WaitStrategy::Backoff));
+}
@@ -26,6 +26,9 @@
 #include "runtime/platform/platform.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_async_event_handler.h"
+#include "unit_tests/mocks/mock_command_queue.h"
+#include "unit_tests/mocks/mock_context.h"
+#include "unit_tests/mocks/mock_device.h"
 #include "test.h"
 #include "gmock/gmock.h"
 
@@ -380,3 +383,64 @@ TEST_F(AsyncEventsHandlerTests, asyncProcessCallsProcessListBeforeReturning) {
 
     event->release();
 }
+
+TEST_F(AsyncEventsHandlerTests, givenSubmittedEventsOnQueueWhenTagIsNotReachedThenTrackThemByTaskCount) {
+    std::unique_ptr<MockDevice> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    MockContext context;
+    MockCommandQueue cmdQ(&context, device.get(), nullptr);
+    *device->getTagAddress() = 0;
+
+    int event1Counter(0), event2Counter(0);
+    auto queueEvent1 = new NiceMock<MyEvent>(&cmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 5);
+    auto queueEvent2 = new NiceMock<MyEvent>(&cmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 3);
+    queueEvent1->addCallback(&this->callbackFcn, CL_COMPLETE, &event1Counter);
+    queueEvent2->addCallback(&this->callbackFcn, CL_COMPLETE, &event2Counter);
+    handler->registerEvent(queueEvent1);
+    handler->registerEvent(queueEvent2);
+
+    auto sleepCandidate = handler->process();
+    EXPECT_EQ(queueEvent2, sleepCandidate);
+    EXPECT_TRUE(handler->peekIsListEmpty());
+    EXPECT_EQ(2u, handler->peekNumTrackedEvents());
+
+    *device->getTagAddress() = 3;
+    sleepCandidate = handler->process();
+    EXPECT_EQ(queueEvent1, sleepCandidate);
+    EXPECT_EQ(0, event1Counter);
+    EXPECT_EQ(1, event2Counter);
+    EXPECT_EQ(1u, handler->peekNumTrackedEvents());
+    EXPECT_EQ(1, queueEvent2->getRefInternalCount());
+
+    *device->getTagAddress() = 5;
+    sleepCandidate = handler->process();
+    EXPECT_EQ(nullptr, sleepCandidate);
+    EXPECT_EQ(1, event1Counter);
+    EXPECT_EQ(0u, handler->peekNumTrackedEvents());
+    EXPECT_TRUE(handler->peekIsListEmpty());
+    EXPECT_EQ(1, queueEvent1->getRefInternalCount());
+
+    queueEvent1->release();
+    queueEvent2->release();
+}
+
+TEST_F(AsyncEventsHandlerTests, givenTrackedEventsWhenHandlerIsReleasedThenUnreferenceThem) {
+    std::unique_ptr<MockDevice> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    MockContext context;
+    MockCommandQueue cmdQ(&context, device.get(), nullptr);
+    *device->getTagAddress() = 0;
+
+    auto queueEvent = new NiceMock<MyEvent>(&cmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 1);
+    queueEvent->addCallback(&this->callbackFcn, CL_COMPLETE, &counter);
+    handler->registerEvent(queueEvent);
+    handler->process();
+    EXPECT_EQ(1u, handler->peekNumTrackedEvents());
+    EXPECT_EQ(3, queueEvent->getRefInternalCount());
+
+    handler.reset(new MockHandler());
+    EXPECT_EQ(2, queueEvent->getRefInternalCount());
+
+    *device->getTagAddress() = 1;
+    queueEvent->updateExecutionStatus();
+    EXPECT_EQ(1, counter);
+    queueEvent->release();
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/event/callback_executor.h"
+#include "runtime/event/event.h"
+#include "runtime/platform/platform.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "test.h"
+
+#include <mutex>
+#include <vector>
+
+using namespace OCLRT;
+
+struct CallbackExecutorTests : public ::testing::Test {
+    struct Record {
+        CallbackExecutorTests *fixture;
+        cl_int id;
+    };
+
+    static void CL_CALLBACK recordCallback(cl_event event, cl_int status, void *data) {
+        auto record = reinterpret_cast<Record *>(data);
+        std::unique_lock<std::mutex> lock(record->fixture->mtx);
+        record->fixture->executionOrder.push_back(record->id);
+    }
+
+    void SetUp() override {
+        DebugManager.flags.EnableAsyncEventsHandler.set(false);
+        oldExecutor = platform()->setCallbackExecutor(std::unique_ptr<CallbackExecutor>(new CallbackExecutor(2)));
+    }
+
+    void TearDown() override {
+        platform()->setCallbackExecutor(std::move(oldExecutor));
+    }
+
+    DebugManagerStateRestore dbgRestore;
+    std::unique_ptr<CallbackExecutor> oldExecutor;
+    std::mutex mtx;
+    std::vector<cl_int> executionOrder;
+};
+
+TEST(CallbackExecutorTest, givenNoWorkersWhenCallbacksAreSubmittedThenLeaveThemToCaller) {
+    CallbackExecutor executor(0);
+    std::vector<Event::Callback *> callbacks;
+    EXPECT_EQ(0u, executor.getNumWorkers());
+    EXPECT_FALSE(executor.submit(nullptr, callbacks));
+}
+
+TEST_F(CallbackExecutorTests, givenWorkersWhenEventChangesStatusThenCallbacksAreExecutedInRegistrationOrderPerEvent) {
+    auto event = new Event(nullptr, CL_COMMAND_NDRANGE_KERNEL, 0, 0);
+    Record submitted = {this, CL_SUBMITTED};
+    Record completed = {this, CL_COMPLETE};
+    event->addCallback(recordCallback, CL_COMPLETE, &completed);
+    event->addCallback(recordCallback, CL_SUBMITTED, &submitted);
+
+    event->setStatus(CL_COMPLETE);
+    platform()->getCallbackExecutor()->closeThreads();
+
+    ASSERT_EQ(2u, executionOrder.size());
+    EXPECT_EQ(CL_SUBMITTED, executionOrder[0]);
+    EXPECT_EQ(CL_COMPLETE, executionOrder[1]);
+    EXPECT_FALSE(event->peekHasCallbacks());
+    EXPECT_EQ(1, event->getRefInternalCount());
+
+    auto statistics = platform()->getCallbackExecutor()->getStatistics();
+    EXPECT_EQ(2u, statistics.executedCallbacks);
+    EXPECT_LE(statistics.maxQueueLatencyNs, statistics.totalQueueLatencyNs);
+    EXPECT_LE(statistics.maxExecutionTimeNs, statistics.totalExecutionTimeNs);
+
+    event->release();
+}
+
+TEST_F(CallbackExecutorTests, givenClosedExecutorWhenEventChangesStatusThenCallbacksAreExecutedInline) {
+    platform()->getCallbackExecutor()->closeThreads();
+
+    auto event = new Event(nullptr, CL_COMMAND_NDRANGE_KERNEL, 0, 0);
+    Record completed = {this, CL_COMPLETE};
+    event->addCallback(recordCallback, CL_COMPLETE, &completed);
+    event->setStatus(CL_COMPLETE);
+
+    ASSERT_EQ(1u, executionOrder.size());
+    EXPECT_EQ(0u, platform()->getCallbackExecutor()->getStatistics().executedCallbacks);
+    event->release();
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/event/event.h"
+#include "runtime/event/event_builder.h"
+#include "runtime/event/event_pool.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_command_queue.h"
+#include "unit_tests/mocks/mock_context.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+TEST(EventPoolTest, givenReleasedStorageWhenStorageIsObtainedThenReuseIt) {
+    EventPool eventPool(1);
+    auto storage = eventPool.obtainStorage();
+    ASSERT_NE(nullptr, storage);
+    EXPECT_EQ(0u, eventPool.peekNumCachedEvents());
+
+    eventPool.releaseStorage(storage);
+    EXPECT_EQ(1u, eventPool.peekNumCachedEvents());
+
+    EXPECT_EQ(storage, eventPool.obtainStorage());
+    EXPECT_EQ(0u, eventPool.peekNumCachedEvents());
+    eventPool.releaseStorage(storage);
+}
+
+TEST(EventPoolTest, givenFullPoolWhenStorageIsReleasedThenFreeIt) {
+    EventPool eventPool(1);
+    auto storage1 = eventPool.obtainStorage();
+    auto storage2 = eventPool.obtainStorage();
+    EXPECT_NE(storage1, storage2);
+
+    eventPool.releaseStorage(storage1);
+    eventPool.releaseStorage(storage2);
+    EXPECT_EQ(1u, eventPool.peekNumCachedEvents());
+}
+
+struct EventPoolContextTest : public ::testing::Test {
+    void SetUp() override {
+        cmdQ.reset(new MockCommandQueue(&context, context.getDevice(0), nullptr));
+    }
+
+    MockContext context;
+    std::unique_ptr<MockCommandQueue> cmdQ;
+};
+
+TEST_F(EventPoolContextTest, givenContextWhenCreatedThenEventPoolIsSizedFromDebugVariable) {
+    ASSERT_NE(nullptr, context.getEventPool());
+    EXPECT_EQ(static_cast<size_t>(DebugManager.flags.EventStoragePoolSize.get()), context.getEventPool()->peekMaxCachedEvents());
+
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EventStoragePoolSize.set(0);
+    MockContext contextWithoutPool;
+    EXPECT_EQ(nullptr, contextWithoutPool.getEventPool());
+}
+
+TEST_F(EventPoolContextTest, givenPooledEventWhenReleasedThenStorageIsReusedByNextEvent) {
+    auto &eventPool = context.getEventPool();
+    ASSERT_NE(nullptr, eventPool);
+
+    EventBuilder eventBuilder;
+    eventBuilder.createPooledEvent(cmdQ.get(), CL_COMMAND_NDRANGE_KERNEL, 0, 0);
+    auto event = eventBuilder.finalizeAndRelease();
+    ASSERT_NE(nullptr, event);
+    EXPECT_NE(nullptr, event->getCustomDeleter());
+    EXPECT_EQ(&context, event->getContext());
+    EXPECT_EQ(0u, eventPool->peekNumCachedEvents());
+
+    event->release();
+    EXPECT_EQ(1u, eventPool->peekNumCachedEvents());
+
+    EventBuilder nextEventBuilder;
+    nextEventBuilder.createPooledEvent(cmdQ.get(), CL_COMMAND_READ_BUFFER, 0, 0);
+    auto nextEvent = nextEventBuilder.finalizeAndRelease();
+    EXPECT_EQ(event, nextEvent);
+    EXPECT_EQ(static_cast<cl_command_type>(CL_COMMAND_READ_BUFFER), nextEvent->getCommandType());
+    EXPECT_EQ(0u, eventPool->peekNumCachedEvents());
+
+    nextEvent->release();
+}
+
+TEST_F(EventPoolContextTest, givenContextWithoutEventPoolWhenPooledEventIsCreatedThenUseRegularAllocation) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.EventStoragePoolSize.set(0);
+    MockContext contextWithoutPool;
+    MockCommandQueue cmdQWithoutPool(&contextWithoutPool, contextWithoutPool.getDevice(0), nullptr);
+
+    EventBuilder eventBuilder;
+    eventBuilder.createPooledEvent(&cmdQWithoutPool, CL_COMMAND_NDRANGE_KERNEL, 0, 0);
+    auto event = eventBuilder.finalizeAndRelease();
+    ASSERT_NE(nullptr, event);
+    EXPECT_EQ(nullptr, event->getCustomDeleter());
+
+    event->release();
+}
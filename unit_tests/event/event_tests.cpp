@@ -1364,7 +1364,7 @@ TEST_F(EventTest, addChildForEventCompleted) {
 HWTEST_F(EventTest, givenQuickKmdSleepRequestWhenWaitIsCalledThenPassRequestToWaitingFunction) {
     struct MyCsr : public UltCommandStreamReceiver<FamilyType> {
         MyCsr(const HardwareInfo &hwInfo, const ExecutionEnvironment &executionEnvironment) : UltCommandStreamReceiver<FamilyType>(hwInfo, const_cast<ExecutionEnvironment &>(executionEnvironment)) {}
-        MOCK_METHOD3(waitForCompletionWithTimeout, bool(bool enableTimeout, int64_t timeoutMs, uint32_t taskCountToWait));
+        MOCK_METHOD4(waitForCompletionWithTimeout, bool(bool enableTimeout, int64_t timeoutMs, uint32_t taskCountToWait, WaitStrategy waitStrategy));
     };
     HardwareInfo localHwInfo = pDevice->getHardwareInfo();
     localHwInfo.capabilityTable.kmdNotifyProperties.enableKmdNotify = true;
@@ -1378,7 +1378,7 @@ HWTEST_F(EventTest, givenQuickKmdSleepRequestWhenWaitIsCalledThenPassRequestToWa
     Event event(pCmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 0);
 
     EXPECT_CALL(*csr, waitForCompletionWithTimeout(::testing::_,
-                                                   localHwInfo.capabilityTable.kmdNotifyProperties.delayQuickKmdSleepMicroseconds, ::testing::_))
+                                                   localHwInfo.capabilityTable.kmdNotifyProperties.delayQuickKmdSleepMicroseconds, ::testing::_, ::testing::_))
         .Times(1)
         .WillOnce(::testing::Return(true));
 
@@ -1388,7 +1388,7 @@ HWTEST_F(EventTest, givenQuickKmdSleepRequestWhenWaitIsCalledThenPassRequestToWa
 HWTEST_F(EventTest, givenNonQuickKmdSleepRequestWhenWaitIsCalledThenPassRequestToWaitingFunction) {
     struct MyCsr : public UltCommandStreamReceiver<FamilyType> {
         MyCsr(const HardwareInfo &hwInfo, const ExecutionEnvironment &executionEnvironment) : UltCommandStreamReceiver<FamilyType>(hwInfo, const_cast<ExecutionEnvironment &>(executionEnvironment)) {}
-        MOCK_METHOD3(waitForCompletionWithTimeout, bool(bool enableTimeout, int64_t timeoutMs, uint32_t taskCountToWait));
+        MOCK_METHOD4(waitForCompletionWithTimeout, bool(bool enableTimeout, int64_t timeoutMs, uint32_t taskCountToWait, WaitStrategy waitStrategy));
     };
     HardwareInfo localHwInfo = pDevice->getHardwareInfo();
     localHwInfo.capabilityTable.kmdNotifyProperties.enableKmdNotify = true;
@@ -1402,13 +1402,47 @@ HWTEST_F(EventTest, givenNonQuickKmdSleepRequestWhenWaitIsCalledThenPassRequestT
     Event event(pCmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 0);
 
     EXPECT_CALL(*csr, waitForCompletionWithTimeout(::testing::_,
-                                                   localHwInfo.capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds, ::testing::_))
+                                                   localHwInfo.capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds, ::testing::_, ::testing::_))
         .Times(1)
         .WillOnce(::testing::Return(true));
 
     event.wait(true, false);
 }
 
+HWTEST_F(EventTest, givenEventsOnSameCsrWhenWaitingForEventsThenBlockOnceForHighestTaskCount) {
+    struct MyCsr : public UltCommandStreamReceiver<FamilyType> {
+        MyCsr(const HardwareInfo &hwInfo, const ExecutionEnvironment &executionEnvironment) : UltCommandStreamReceiver<FamilyType>(hwInfo, const_cast<ExecutionEnvironment &>(executionEnvironment)) {}
+        void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool quickKmdSleep, WaitStrategy waitStrategy) override {
+            if (*this->getTagAddress() < taskCountToWait) {
+                blockingWaits++;
+                waitedTaskCount = taskCountToWait;
+                *this->getTagAddress() = taskCountToWait;
+            }
+        }
+        uint32_t blockingWaits = 0;
+        uint32_t waitedTaskCount = 0;
+    };
+
+    auto csr = new MyCsr(pDevice->getHardwareInfo(), *pDevice->executionEnvironment);
+    pDevice->resetCommandStreamReceiver(csr);
+    *csr->getTagAddress() = 0;
+
+    MockCommandQueue cmdQ2(&mockContext, pDevice, nullptr);
+    Event event1(pCmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 10);
+    Event event2(&cmdQ2, CL_COMMAND_NDRANGE_KERNEL, 0, 20);
+    Event event3(pCmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 15);
+    cl_event eventWaitList[] = {&event1, &event2, &event3};
+
+    auto retVal = Event::waitForEvents(3, eventWaitList);
+
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(1u, csr->blockingWaits);
+    EXPECT_EQ(20u, csr->waitedTaskCount);
+    EXPECT_EQ(CL_COMPLETE, event1.peekExecutionStatus());
+    EXPECT_EQ(CL_COMPLETE, event2.peekExecutionStatus());
+    EXPECT_EQ(CL_COMPLETE, event3.peekExecutionStatus());
+}
+
 HWTEST_F(InternalsEventTest, givenCommandWhenSubmitCalledThenUpdateFlushStamp) {
     auto pCmdQ = std::unique_ptr<CommandQueue>(new CommandQueue(mockContext, pDevice, 0));
     MockEvent<Event> *event = new MockEvent<Event>(pCmdQ.get(), CL_COMMAND_MARKER, 0, 0);
@@ -31,6 +31,7 @@
 #include "runtime/helpers/file_io.h"
 #include "runtime/helpers/hash.h"
 #include "runtime/helpers/options.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/kernel/kernel.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/memory_manager/surface.h"
@@ -2204,7 +2205,8 @@ TEST_F(GTPinTests, givenKernelThenVerifyThatKernelCodeSubstitutionWorksWell) {
     uint8_t *pBin2 = reinterpret_cast<uint8_t *>(const_cast<void *>(pKernel->getKernelHeap()));
     EXPECT_EQ(pBin2, &newCode[0]);
 
-    auto kernelIsa = pKernel->getKernelInfo().kernelAllocation->getUnderlyingBuffer();
+    auto &kernelInfo = pKernel->getKernelInfo();
+    auto kernelIsa = ptrOffset(kernelInfo.kernelAllocation->getUnderlyingBuffer(), kernelInfo.getKernelAllocationOffset());
 
     EXPECT_EQ(0, memcmp(kernelIsa, newCode, newCodeSize));
 
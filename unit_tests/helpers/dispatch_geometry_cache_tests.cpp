@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/dispatch_geometry_cache.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_device.h"
+#include "unit_tests/mocks/mock_kernel.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+struct DispatchGeometryCacheTest : public ::testing::Test {
+    void SetUp() override {
+        device.reset(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+        kernel.reset(new MockKernelWithInternals(*device));
+    }
+
+    void pushGeometry(MultiDispatchInfo &multiDispatchInfo, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            multiDispatchInfo.push(DispatchInfo(kernel->mockKernel, 1, {gws[0], 1, 1}, {0, 0, 0}, {0, 0, 0}, {gws[0], 1, 1}, {16 + i, 1, 1}, {4, 1, 1}, {4, 1, 1}, {i, 0, 0}));
+        }
+    }
+
+    std::unique_ptr<MockDevice> device;
+    std::unique_ptr<MockKernelWithInternals> kernel;
+    DispatchGeometryCache cache;
+    size_t gws[3] = {64, 1, 1};
+    size_t offset[3] = {0, 0, 0};
+};
+
+TEST_F(DispatchGeometryCacheTest, givenEmptyCacheWhenRestoringThenNothingIsRestored) {
+    MultiDispatchInfo multiDispatchInfo;
+    EXPECT_FALSE(cache.restore(*kernel->mockKernel, 1, gws, nullptr, offset, multiDispatchInfo));
+    EXPECT_EQ(0u, multiDispatchInfo.size());
+}
+
+TEST_F(DispatchGeometryCacheTest, givenStoredGeometryWhenSameGeometryIsRestoredThenDispatchInfosAddedAfterFirstDispatchAreAppended) {
+    MultiDispatchInfo source;
+    pushGeometry(source, 3);
+    cache.store(*kernel->mockKernel, 1, gws, nullptr, offset, source, 1);
+
+    MultiDispatchInfo target;
+    pushGeometry(target, 1);
+    EXPECT_TRUE(cache.restore(*kernel->mockKernel, 1, gws, nullptr, offset, target));
+    ASSERT_EQ(3u, target.size());
+    EXPECT_EQ(Vec3<size_t>(17, 1, 1), target.begin()[1].getLocalWorkgroupSize());
+    EXPECT_EQ(Vec3<size_t>(18, 1, 1), target.begin()[2].getLocalWorkgroupSize());
+    EXPECT_EQ(Vec3<size_t>(2, 0, 0), target.begin()[2].getStartOfWorkgroups());
+}
+
+TEST_F(DispatchGeometryCacheTest, givenStoredGeometryWhenGeometryOrWorkSizeInputsDifferThenItIsNotRestored) {
+    DebugManagerStateRestore dbgRestore;
+    MultiDispatchInfo source;
+    pushGeometry(source, 1);
+    cache.store(*kernel->mockKernel, 1, gws, nullptr, offset, source, 0);
+
+    MultiDispatchInfo target;
+    size_t otherGws[3] = {128, 1, 1};
+    size_t lws[3] = {16, 1, 1};
+    size_t otherOffset[3] = {4, 0, 0};
+    EXPECT_FALSE(cache.restore(*kernel->mockKernel, 1, otherGws, nullptr, offset, target));
+    EXPECT_FALSE(cache.restore(*kernel->mockKernel, 1, gws, lws, offset, target));
+    EXPECT_FALSE(cache.restore(*kernel->mockKernel, 1, gws, nullptr, otherOffset, target));
+    EXPECT_FALSE(cache.restore(*kernel->mockKernel, 2, gws, nullptr, offset, target));
+
+    kernel->mockKernel->slmTotalSize += 1024;
+    EXPECT_FALSE(cache.restore(*kernel->mockKernel, 1, gws, nullptr, offset, target));
+    kernel->mockKernel->slmTotalSize -= 1024;
+
+    DebugManager.flags.EnableComputeWorkSizeSquared.set(!DebugManager.flags.EnableComputeWorkSizeSquared.get());
+    EXPECT_FALSE(cache.restore(*kernel->mockKernel, 1, gws, nullptr, offset, target));
+    EXPECT_EQ(0u, target.size());
+}
+
+TEST_F(DispatchGeometryCacheTest, givenFullCacheWhenNewGeometryIsStoredThenOldestEntryIsEvicted) {
+    MultiDispatchInfo source;
+    pushGeometry(source, 1);
+    for (size_t i = 0; i <= DispatchGeometryCache::maxEntries; i++) {
+        size_t entryGws[3] = {64 * (i + 1), 1, 1};
+        cache.store(*kernel->mockKernel, 1, entryGws, nullptr, offset, source, 0);
+    }
+    EXPECT_EQ(DispatchGeometryCache::maxEntries, cache.peekNumEntries());
+
+    MultiDispatchInfo target;
+    EXPECT_FALSE(cache.restore(*kernel->mockKernel, 1, gws, nullptr, offset, target));
+    size_t newestGws[3] = {64 * (DispatchGeometryCache::maxEntries + 1), 1, 1};
+    EXPECT_TRUE(cache.restore(*kernel->mockKernel, 1, newestGws, nullptr, offset, target));
+}
@@ -21,7 +21,9 @@
  */
 
 #include "runtime/command_queue/command_queue.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_device.h"
 #include "unit_tests/mocks/mock_context.h"
 #include "test.h"
@@ -57,6 +59,7 @@ struct KmdNotifyTests : public ::testing::Test {
     class MockKmdNotifyHelper : public KmdNotifyHelper {
       public:
         using KmdNotifyHelper::acLineConnected;
+        using KmdNotifyHelper::completionLatencies;
         using KmdNotifyHelper::getMicrosecondsSinceEpoch;
         using KmdNotifyHelper::lastWaitForCompletionTimestampUs;
         using KmdNotifyHelper::maxPowerSavingMode;
@@ -75,8 +78,17 @@ struct KmdNotifyTests : public ::testing::Test {
             updateAcLineStatusCalled++;
         }
 
+        int64_t getMicrosecondsSinceEpoch() const override {
+            if (overrideMicrosecondsSinceEpoch) {
+                return microsecondsSinceEpoch;
+            }
+            return KmdNotifyHelper::getMicrosecondsSinceEpoch();
+        }
+
         uint32_t updateLastWaitForCompletionTimestampCalled = 0u;
         uint32_t updateAcLineStatusCalled = 0u;
+        bool overrideMicrosecondsSinceEpoch = false;
+        int64_t microsecondsSinceEpoch = 0;
     };
 
     template <typename Family>
@@ -84,7 +96,18 @@ struct KmdNotifyTests : public ::testing::Test {
       public:
         MockKmdNotifyCsr(const HardwareInfo &hwInfo, const ExecutionEnvironment &executionEnvironment) : UltCommandStreamReceiver<Family>(hwInfo, const_cast<ExecutionEnvironment &>(executionEnvironment)) {}
         MOCK_METHOD1(waitForFlushStamp, bool(FlushStamp &flushStampToWait));
-        MOCK_METHOD3(waitForCompletionWithTimeout, bool(bool enableTimeout, int64_t timeoutMs, uint32_t taskCountToWait));
+        MOCK_METHOD4(waitForCompletionWithTimeout, bool(bool enableTimeout, int64_t timeoutMs, uint32_t taskCountToWait, WaitStrategy waitStrategy));
+    };
+
+    template <typename Family>
+    class MockCompletingCsr : public UltCommandStreamReceiver<Family> {
+      public:
+        using UltCommandStreamReceiver<Family>::UltCommandStreamReceiver;
+        bool waitForCompletionWithTimeout(bool enableTimeout, int64_t timeoutMicroseconds, uint32_t taskCountToWait, WaitStrategy waitStrategy) override {
+            // task completes while csr polls for it
+            *this->getTagAddress() = taskCountToWait;
+            return true;
+        }
     };
 
     template <typename Family>
@@ -110,7 +133,7 @@ struct KmdNotifyTests : public ::testing::Test {
 HWTEST_F(KmdNotifyTests, givenTaskCountWhenWaitUntilCompletionCalledThenAlwaysTryCpuPolling) {
     auto csr = createMockCsr<FamilyType>();
 
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
     cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, false);
 }
@@ -119,7 +142,7 @@ HWTEST_F(KmdNotifyTests, givenTaskCountAndKmdNotifyDisabledWhenWaitUntilCompleti
     overrideKmdNotifyParams(false, 0, false, 0, false, 0);
     auto csr = createMockCsr<FamilyType>();
 
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(false, 0, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(false, 0, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
     EXPECT_CALL(*csr, waitForFlushStamp(::testing::_)).Times(0);
 
     cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, false);
@@ -130,9 +153,9 @@ HWTEST_F(KmdNotifyTests, givenNotReadyTaskCountWhenWaitUntilCompletionCalledThen
     *csr->getTagAddress() = taskCountToWait - 1;
 
     ::testing::InSequence is;
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait)).Times(1).WillOnce(::testing::Return(false));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(false));
     EXPECT_CALL(*csr, waitForFlushStamp(flushStampToWait)).Times(1).WillOnce(::testing::Return(true));
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(false, 0, taskCountToWait)).Times(1).WillOnce(::testing::Return(false));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(false, 0, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(false));
 
     //we have unrecoverable for this case, this will throw.
     EXPECT_THROW(cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, false), std::exception);
@@ -142,7 +165,7 @@ HWTEST_F(KmdNotifyTests, givenReadyTaskCountWhenWaitUntilCompletionCalledThenTry
     auto csr = createMockCsr<FamilyType>();
 
     ::testing::InSequence is;
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, 2, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
     EXPECT_CALL(*csr, waitForFlushStamp(::testing::_)).Times(0);
 
     cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, false);
@@ -152,7 +175,7 @@ HWTEST_F(KmdNotifyTests, givenDefaultArgumentWhenWaitUntilCompleteIsCalledThenDi
     auto csr = createMockCsr<FamilyType>();
     auto expectedTimeout = device->getHardwareInfo().capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds;
 
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
     cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, false);
 }
@@ -161,7 +184,7 @@ HWTEST_F(KmdNotifyTests, givenEnabledQuickSleepWhenWaitUntilCompleteIsCalledThen
     auto csr = createMockCsr<FamilyType>();
     auto expectedTimeout = device->getHardwareInfo().capabilityTable.kmdNotifyProperties.delayQuickKmdSleepMicroseconds;
 
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
     cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, true);
 }
@@ -171,14 +194,14 @@ HWTEST_F(KmdNotifyTests, givenDisabledQuickSleepWhenWaitUntilCompleteWithQuickSl
     auto csr = createMockCsr<FamilyType>();
     auto expectedTimeout = device->getHardwareInfo().capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds;
 
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
     cmdQ->waitUntilComplete(taskCountToWait, flushStampToWait, true);
 }
 
 HWTEST_F(KmdNotifyTests, givenNotReadyTaskCountWhenPollForCompletionCalledThenTimeout) {
     *device->getTagAddress() = taskCountToWait - 1;
-    auto success = device->getCommandStreamReceiver().waitForCompletionWithTimeout(true, 1, taskCountToWait);
+    auto success = device->getCommandStreamReceiver().waitForCompletionWithTimeout(true, 1, taskCountToWait, WaitStrategy::Yield);
     EXPECT_FALSE(success);
 }
 
@@ -186,10 +209,10 @@ HWTEST_F(KmdNotifyTests, givenZeroFlushStampWhenWaitIsCalledThenDisableTimeout)
     auto csr = createMockCsr<FamilyType>();
 
     EXPECT_TRUE(device->getHardwareInfo().capabilityTable.kmdNotifyProperties.enableKmdNotify);
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(false, ::testing::_, taskCountToWait)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(false, ::testing::_, taskCountToWait, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
     EXPECT_CALL(*csr, waitForFlushStamp(::testing::_)).Times(0);
 
-    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 0, false);
+    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 0, false, WaitStrategy::Yield);
 }
 
 HWTEST_F(KmdNotifyTests, givenNonQuickSleepRequestWhenItsSporadicWaitThenOverrideQuickSleepRequest) {
@@ -197,12 +220,12 @@ HWTEST_F(KmdNotifyTests, givenNonQuickSleepRequestWhenItsSporadicWaitThenOverrid
     auto csr = createMockCsr<FamilyType>();
 
     auto expectedDelay = device->getHardwareInfo().capabilityTable.kmdNotifyProperties.delayQuickKmdSleepMicroseconds;
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(::testing::_, expectedDelay, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(::testing::_, expectedDelay, ::testing::_, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
     int64_t timeSinceLastWait = mockKmdNotifyHelper->properties->delayQuickKmdSleepForSporadicWaitsMicroseconds + 1;
 
     mockKmdNotifyHelper->lastWaitForCompletionTimestampUs = mockKmdNotifyHelper->getMicrosecondsSinceEpoch() - timeSinceLastWait;
-    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, false);
+    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, false, WaitStrategy::Yield);
 }
 
 HWTEST_F(KmdNotifyTests, givenNonQuickSleepRequestWhenItsNotSporadicWaitThenOverrideQuickSleepRequest) {
@@ -210,9 +233,9 @@ HWTEST_F(KmdNotifyTests, givenNonQuickSleepRequestWhenItsNotSporadicWaitThenOver
     auto csr = createMockCsr<FamilyType>();
 
     auto expectedDelay = device->getHardwareInfo().capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds;
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(::testing::_, expectedDelay, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(::testing::_, expectedDelay, ::testing::_, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
-    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, false);
+    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, false, WaitStrategy::Yield);
 }
 
 HWTEST_F(KmdNotifyTests, givenQuickSleepRequestWhenItsSporadicWaitOptimizationIsDisabledThenDontOverrideQuickSleepRequest) {
@@ -220,9 +243,9 @@ HWTEST_F(KmdNotifyTests, givenQuickSleepRequestWhenItsSporadicWaitOptimizationIs
     auto csr = createMockCsr<FamilyType>();
 
     auto expectedDelay = device->getHardwareInfo().capabilityTable.kmdNotifyProperties.delayQuickKmdSleepMicroseconds;
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(::testing::_, expectedDelay, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(::testing::_, expectedDelay, ::testing::_, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
-    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, true);
+    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, true, WaitStrategy::Yield);
 }
 
 HWTEST_F(KmdNotifyTests, givenTaskCountEqualToHwTagWhenWaitCalledThenDontMultiplyTimeout) {
@@ -231,9 +254,9 @@ HWTEST_F(KmdNotifyTests, givenTaskCountEqualToHwTagWhenWaitCalledThenDontMultipl
 
     auto expectedTimeout = device->getHardwareInfo().capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds;
 
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, ::testing::_, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
-    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, false);
+    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, false, WaitStrategy::Yield);
 }
 
 HWTEST_F(KmdNotifyTests, givenTaskCountLowerThanHwTagWhenWaitCalledThenDontMultiplyTimeout) {
@@ -242,9 +265,9 @@ HWTEST_F(KmdNotifyTests, givenTaskCountLowerThanHwTagWhenWaitCalledThenDontMulti
 
     auto expectedTimeout = device->getHardwareInfo().capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds;
 
-    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
+    EXPECT_CALL(*csr, waitForCompletionWithTimeout(true, expectedTimeout, ::testing::_, ::testing::_)).Times(1).WillOnce(::testing::Return(true));
 
-    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, false);
+    csr->waitForTaskCountWithKmdNotifyFallback(taskCountToWait, 1, false, WaitStrategy::Yield);
 }
 
 HWTEST_F(KmdNotifyTests, givenDefaultCommandStreamReceiverWhenWaitCalledThenUpdateWaitTimestamp) {
@@ -254,7 +277,7 @@ HWTEST_F(KmdNotifyTests, givenDefaultCommandStreamReceiverWhenWaitCalledThenUpda
     EXPECT_NE(0, mockKmdNotifyHelper->lastWaitForCompletionTimestampUs.load());
 
     EXPECT_EQ(1u, mockKmdNotifyHelper->updateLastWaitForCompletionTimestampCalled);
-    csr->waitForTaskCountWithKmdNotifyFallback(0, 0, false);
+    csr->waitForTaskCountWithKmdNotifyFallback(0, 0, false, WaitStrategy::Yield);
     EXPECT_EQ(2u, mockKmdNotifyHelper->updateLastWaitForCompletionTimestampCalled);
 }
 
@@ -264,7 +287,7 @@ HWTEST_F(KmdNotifyTests, givenDefaultCommandStreamReceiverWithDisabledSporadicWa
     auto csr = createMockCsr<FamilyType>();
     EXPECT_EQ(0, mockKmdNotifyHelper->lastWaitForCompletionTimestampUs.load());
 
-    csr->waitForTaskCountWithKmdNotifyFallback(0, 0, false);
+    csr->waitForTaskCountWithKmdNotifyFallback(0, 0, false, WaitStrategy::Yield);
     EXPECT_EQ(0u, mockKmdNotifyHelper->updateLastWaitForCompletionTimestampCalled);
 }
 
@@ -379,6 +402,176 @@ TEST_F(KmdNotifyTests, givenDisabledKmdNotifyMechanismAndFlushStampIsZeroWhenAcL
     EXPECT_FALSE(timeoutEnabled);
 }
 
+TEST_F(KmdNotifyTests, givenAdaptiveTimeoutEnabledWhenNotEnoughLatenciesWereLearnedThenUseBaseTimeout) {
+    localHwInfo.capabilityTable.kmdNotifyProperties.enableKmdNotify = true;
+    localHwInfo.capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds = 500;
+    MockKmdNotifyHelper helper(&(localHwInfo.capabilityTable.kmdNotifyProperties));
+    helper.setAdaptiveTimeoutPercentile(90);
+    helper.overrideMicrosecondsSinceEpoch = true;
+
+    for (uint32_t i = 1; i < KmdNotifyConstants::minimumCompletionLatencySamples; i++) {
+        helper.microsecondsSinceEpoch = 1000 * i;
+        helper.notifyFlush(i);
+        helper.microsecondsSinceEpoch += 10;
+        helper.notifyCompletion(i, i - 1);
+    }
+    EXPECT_EQ(0, helper.getAdaptiveTimeout());
+
+    int64_t timeout = 0;
+    EXPECT_TRUE(helper.obtainTimeoutParams(timeout, false, 1, 2, 2));
+    EXPECT_EQ(500, timeout);
+}
+
+TEST_F(KmdNotifyTests, givenAdaptiveTimeoutEnabledWhenEnoughLatenciesWereLearnedThenUsePercentileAsTimeout) {
+    localHwInfo.capabilityTable.kmdNotifyProperties.enableKmdNotify = true;
+    localHwInfo.capabilityTable.kmdNotifyProperties.delayKmdNotifyMicroseconds = 500;
+    MockKmdNotifyHelper helper(&(localHwInfo.capabilityTable.kmdNotifyProperties));
+    helper.setAdaptiveTimeoutPercentile(90);
+    helper.overrideMicrosecondsSinceEpoch = true;
+
+    for (uint32_t i = 1; i <= 20; i++) {
+        helper.microsecondsSinceEpoch = 1000 * i;
+        helper.notifyFlush(i);
+        helper.microsecondsSinceEpoch += 10 * i;
+        helper.notifyCompletion(i, i - 1);
+    }
+    EXPECT_EQ(180, helper.getAdaptiveTimeout());
+
+    int64_t timeout = 0;
+    EXPECT_TRUE(helper.obtainTimeoutParams(timeout, false, 1, 2, 2));
+    EXPECT_EQ(180, timeout);
+
+    timeout = 0;
+    EXPECT_TRUE(helper.obtainTimeoutParams(timeout, true, 1, 2, 2));
+    EXPECT_EQ(localHwInfo.capabilityTable.kmdNotifyProperties.delayQuickKmdSleepMicroseconds, timeout);
+}
+
+TEST_F(KmdNotifyTests, givenAdaptiveTimeoutEnabledWhenOneCompletionCoversManyFlushesThenLatencyIsLearnedForEachOfThem) {
+    localHwInfo.capabilityTable.kmdNotifyProperties.enableKmdNotify = true;
+    MockKmdNotifyHelper helper(&(localHwInfo.capabilityTable.kmdNotifyProperties));
+    helper.setAdaptiveTimeoutPercentile(50);
+    helper.overrideMicrosecondsSinceEpoch = true;
+
+    for (uint32_t i = 1; i <= KmdNotifyConstants::minimumCompletionLatencySamples; i++) {
+        helper.microsecondsSinceEpoch = i;
+        helper.notifyFlush(i);
+    }
+    helper.microsecondsSinceEpoch = 100;
+    helper.notifyCompletion(KmdNotifyConstants::minimumCompletionLatencySamples - 1, 0);
+    EXPECT_EQ(0, helper.getAdaptiveTimeout());
+
+    helper.notifyCompletion(KmdNotifyConstants::minimumCompletionLatencySamples, KmdNotifyConstants::minimumCompletionLatencySamples - 1);
+    EXPECT_EQ(91, helper.getAdaptiveTimeout());
+}
+
+TEST_F(KmdNotifyTests, givenAdaptiveTimeoutEnabledWhenFlushCompletedBeforeWaitStartedThenItsLatencyIsNotLearned) {
+    localHwInfo.capabilityTable.kmdNotifyProperties.enableKmdNotify = true;
+    MockKmdNotifyHelper helper(&(localHwInfo.capabilityTable.kmdNotifyProperties));
+    helper.setAdaptiveTimeoutPercentile(90);
+    helper.overrideMicrosecondsSinceEpoch = true;
+
+    for (uint32_t i = 1; i <= KmdNotifyConstants::minimumCompletionLatencySamples; i++) {
+        helper.microsecondsSinceEpoch = 100000 * i;
+        helper.notifyFlush(i);
+        // application was idle, task was already completed when it started waiting
+        helper.microsecondsSinceEpoch += 50000;
+        helper.notifyCompletion(i, i);
+    }
+    EXPECT_EQ(0, helper.getAdaptiveTimeout());
+
+    for (uint32_t i = 1; i <= KmdNotifyConstants::minimumCompletionLatencySamples; i++) {
+        uint32_t taskCount = KmdNotifyConstants::minimumCompletionLatencySamples + i;
+        helper.microsecondsSinceEpoch = 10000000 + 1000 * i;
+        helper.notifyFlush(taskCount);
+        helper.microsecondsSinceEpoch += 20;
+        helper.notifyCompletion(taskCount, taskCount - 1);
+    }
+    EXPECT_EQ(20, helper.getAdaptiveTimeout());
+}
+
+TEST_F(KmdNotifyTests, givenLearnedAdaptiveTimeoutWhenNoNewLatenciesArriveThenCachedTimeoutIsReturned) {
+    localHwInfo.capabilityTable.kmdNotifyProperties.enableKmdNotify = true;
+    MockKmdNotifyHelper helper(&(localHwInfo.capabilityTable.kmdNotifyProperties));
+    helper.setAdaptiveTimeoutPercentile(100);
+    helper.overrideMicrosecondsSinceEpoch = true;
+
+    uint32_t taskCount = 1;
+    for (; taskCount <= KmdNotifyConstants::minimumCompletionLatencySamples; taskCount++) {
+        helper.microsecondsSinceEpoch = 1000 * taskCount;
+        helper.notifyFlush(taskCount);
+        helper.microsecondsSinceEpoch += 30;
+        helper.notifyCompletion(taskCount, taskCount - 1);
+    }
+    EXPECT_EQ(30, helper.getAdaptiveTimeout());
+
+    // overwriting samples behind helper's back is not observed until a new latency is learned
+    helper.completionLatencies.fill(40);
+    EXPECT_EQ(30, helper.getAdaptiveTimeout());
+
+    helper.microsecondsSinceEpoch = 1000 * taskCount;
+    helper.notifyFlush(taskCount);
+    helper.microsecondsSinceEpoch += 50;
+    helper.notifyCompletion(taskCount, taskCount - 1);
+    EXPECT_EQ(50, helper.getAdaptiveTimeout());
+}
+
+TEST_F(KmdNotifyTests, givenAdaptiveTimeoutEnabledWhenLearnedLatenciesAreLongThenReturnMinimalTimeout) {
+    localHwInfo.capabilityTable.kmdNotifyProperties.enableKmdNotify = true;
+    MockKmdNotifyHelper helper(&(localHwInfo.capabilityTable.kmdNotifyProperties));
+    helper.setAdaptiveTimeoutPercentile(90);
+    helper.overrideMicrosecondsSinceEpoch = true;
+
+    for (uint32_t i = 1; i <= KmdNotifyConstants::minimumCompletionLatencySamples; i++) {
+        helper.microsecondsSinceEpoch = 100000 * i;
+        helper.notifyFlush(i);
+        helper.microsecondsSinceEpoch += KmdNotifyConstants::maxAdaptiveTimeoutMicroseconds + 1;
+        helper.notifyCompletion(i, i - 1);
+    }
+    EXPECT_EQ(KmdNotifyConstants::adaptiveTimeoutForLongCompletionsMicroseconds, helper.getAdaptiveTimeout());
+}
+
+TEST_F(KmdNotifyTests, givenAdaptiveTimeoutDisabledWhenFlushesCompleteThenNothingIsLearned) {
+    MockKmdNotifyHelper helper(&(localHwInfo.capabilityTable.kmdNotifyProperties));
+    helper.overrideMicrosecondsSinceEpoch = true;
+
+    for (uint32_t i = 1; i <= KmdNotifyConstants::minimumCompletionLatencySamples; i++) {
+        helper.microsecondsSinceEpoch = 1000 * i;
+        helper.notifyFlush(i);
+        helper.microsecondsSinceEpoch += 10;
+        helper.notifyCompletion(i, i - 1);
+    }
+    helper.setAdaptiveTimeoutPercentile(90);
+    EXPECT_EQ(0, helper.getAdaptiveTimeout());
+}
+
+HWTEST_F(KmdNotifyTests, givenAdaptiveKmdNotifyTimeoutPercentileSetWhenCsrIsCreatedThenLatenciesAreLearnedFromFlushAndWait) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.AdaptiveKmdNotifyTimeoutPercentile.set(90);
+    auto csr = new MockCompletingCsr<FamilyType>(device->getHardwareInfo(), *device->executionEnvironment);
+    device->resetCommandStreamReceiver(csr);
+
+    for (uint32_t i = 1; i <= KmdNotifyConstants::minimumCompletionLatencySamples; i++) {
+        csr->peekKmdNotifyHelper()->notifyFlush(i);
+        *csr->getTagAddress() = i - 1;
+        csr->waitForTaskCountWithKmdNotifyFallback(i, 0, false, WaitStrategyHelper::getDefaultWaitStrategy());
+    }
+    EXPECT_GT(csr->peekKmdNotifyHelper()->getAdaptiveTimeout(), 0);
+}
+
+HWTEST_F(KmdNotifyTests, givenAdaptiveKmdNotifyTimeoutPercentileSetWhenTasksCompletedBeforeWaitThenNoLatenciesAreLearned) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.AdaptiveKmdNotifyTimeoutPercentile.set(90);
+    auto csr = new UltCommandStreamReceiver<FamilyType>(device->getHardwareInfo(), *device->executionEnvironment);
+    device->resetCommandStreamReceiver(csr);
+
+    for (uint32_t i = 1; i <= KmdNotifyConstants::minimumCompletionLatencySamples; i++) {
+        csr->peekKmdNotifyHelper()->notifyFlush(i);
+        *csr->getTagAddress() = i;
+        csr->waitForTaskCountWithKmdNotifyFallback(i, 0, false, WaitStrategyHelper::getDefaultWaitStrategy());
+    }
+    EXPECT_EQ(0, csr->peekKmdNotifyHelper()->getAdaptiveTimeout());
+}
+
 #if defined(__clang__)
 #pragma clang diagnostic pop
 #endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/memory_access_set.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+struct MemoryAccessSetTest : public ::testing::Test {
+    GraphicsAllocation firstAllocation{reinterpret_cast<void *>(0x1000), 0x1000};
+    GraphicsAllocation secondAllocation{reinterpret_cast<void *>(0x2000), 0x1000};
+    MemoryAccessSet first;
+    MemoryAccessSet second;
+};
+
+TEST_F(MemoryAccessSetTest, givenDisjointAllocationsWhenCheckingConflictThenNoConflictIsReported) {
+    first.addWrite(&firstAllocation);
+    second.addWrite(&secondAllocation);
+
+    EXPECT_FALSE(first.conflictsWith(second));
+    EXPECT_FALSE(second.conflictsWith(first));
+}
+
+TEST_F(MemoryAccessSetTest, givenSharedAllocationReadByBothWhenCheckingConflictThenNoConflictIsReported) {
+    first.addRead(&firstAllocation);
+    second.addRead(&firstAllocation);
+
+    EXPECT_FALSE(first.conflictsWith(second));
+}
+
+TEST_F(MemoryAccessSetTest, givenSharedAllocationWrittenByAnyWhenCheckingConflictThenConflictIsReported) {
+    first.addWrite(&firstAllocation);
+    second.addRead(&firstAllocation);
+    EXPECT_TRUE(first.conflictsWith(second));
+    EXPECT_TRUE(second.conflictsWith(first));
+
+    MemoryAccessSet third;
+    third.addWrite(&firstAllocation);
+    EXPECT_TRUE(first.conflictsWith(third));
+}
+
+TEST_F(MemoryAccessSetTest, givenUntrackedSetWhenCheckingConflictThenConflictIsReported) {
+    second.markUntracked();
+
+    EXPECT_TRUE(first.conflictsWith(second));
+    EXPECT_TRUE(second.conflictsWith(first));
+}
+
+TEST_F(MemoryAccessSetTest, givenAllocationReadAndWrittenWhenAddedThenItIsTrackedOnlyAsWrite) {
+    first.addRead(&firstAllocation);
+    first.addWrite(&firstAllocation);
+    first.addRead(&firstAllocation);
+
+    EXPECT_EQ(0u, first.peekReads().size());
+    ASSERT_EQ(1u, first.peekWrites().size());
+    EXPECT_EQ(&firstAllocation, first.peekWrites()[0]);
+}
+
+TEST_F(MemoryAccessSetTest, givenMergedSetWhenCheckingConflictThenMergedAccessesAreTaken) {
+    second.addWrite(&secondAllocation);
+    first.addRead(&firstAllocation);
+
+    MemoryAccessSet third;
+    third.addRead(&secondAllocation);
+    EXPECT_FALSE(first.conflictsWith(third));
+
+    first.merge(second);
+    EXPECT_TRUE(first.conflictsWith(third));
+    EXPECT_FALSE(first.isUntracked());
+
+    MemoryAccessSet untrackedSet;
+    untrackedSet.markUntracked();
+    first.merge(untrackedSet);
+    EXPECT_TRUE(first.isUntracked());
+}
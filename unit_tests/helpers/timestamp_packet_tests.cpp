@@ -45,7 +45,6 @@ struct TimestampPacketTests : public ::testing::Test {
 
     class MockTagAllocator : public TagAllocator<TimestampPacket> {
       public:
-        using TagAllocator<TimestampPacket>::usedTags;
         MockTagAllocator(MemoryManager *memoryManager) : TagAllocator<TimestampPacket>(memoryManager, 10, 10) {}
 
         void returnTag(NodeType *node) override {
@@ -190,7 +189,7 @@ HWTEST_F(TimestampPacketTests, givenDebugVariableEnabledWhenEnqueueingThenObtain
 
     cmdQ->enqueueKernel(kernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
     EXPECT_EQ(nullptr, cmdQ->timestampPacketNode);
-    EXPECT_EQ(nullptr, mockTagAllocator->usedTags.peekHead());
+    EXPECT_EQ(mockTagAllocator->peekNumTags(), mockTagAllocator->peekNumFreeTags());
 
     DebugManager.flags.EnableTimestampPacket.set(true);
     cl_event event1, event2;
@@ -26,6 +26,7 @@
 #include "unit_tests/fixtures/context_fixture.h"
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/kernel/kernel_arg_buffer_fixture.h"
 #include "test.h"
 #include "unit_tests/mocks/mock_buffer.h"
@@ -183,3 +184,111 @@ TEST_F(KernelArgBufferTest, given32BitDeviceWhenArgPassedIsNullThenOnly4BytesAre
     EXPECT_EQ(0u, *pKernelArg32bit);
     EXPECT_NE(expValue, *pKernelArg64bit);
 }
+
+TEST_F(KernelArgBufferTest, givenBufferArgSetWhenSameBufferIsSetAgainThenArgIsNotPatchedAgain) {
+    MockBuffer buffer;
+    auto val = static_cast<cl_mem>(&buffer);
+
+    auto retVal = pKernel->setArg(0, sizeof(cl_mem), &val);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    auto generation = pKernel->getArgumentsGeneration();
+
+    auto pKernelArg = reinterpret_cast<void **>(pKernel->getCrossThreadData() +
+                                                pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset);
+    *pKernelArg = nullptr;
+
+    retVal = pKernel->setArg(0, sizeof(cl_mem), &val);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(generation, pKernel->getArgumentsGeneration());
+    EXPECT_EQ(nullptr, *pKernelArg);
+}
+
+TEST_F(KernelArgBufferTest, givenBufferArgSetWhenOtherBufferIsSetThenArgIsPatchedAndGenerationChanges) {
+    MockBuffer firstBuffer;
+    MockBuffer secondBuffer;
+    auto firstVal = static_cast<cl_mem>(&firstBuffer);
+    auto secondVal = static_cast<cl_mem>(&secondBuffer);
+
+    pKernel->setArg(0, sizeof(cl_mem), &firstVal);
+    auto generation = pKernel->getArgumentsGeneration();
+
+    auto retVal = pKernel->setArg(0, sizeof(cl_mem), &secondVal);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(generation, pKernel->getArgumentsGeneration());
+
+    auto pKernelArg = reinterpret_cast<void **>(pKernel->getCrossThreadData() +
+                                                pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset);
+    EXPECT_EQ(secondBuffer.getCpuAddress(), *pKernelArg);
+}
+
+TEST_F(KernelArgBufferTest, givenBufferArgSetWhenBufferStateChangesAndSameBufferIsSetAgainThenArgIsPatchedAgain) {
+    MockBuffer buffer;
+    auto val = static_cast<cl_mem>(&buffer);
+
+    pKernel->setArg(0, sizeof(cl_mem), &val);
+    auto generation = pKernel->getArgumentsGeneration();
+
+    auto pKernelArg = reinterpret_cast<void **>(pKernel->getCrossThreadData() +
+                                                pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset);
+    *pKernelArg = nullptr;
+
+    buffer.getSurfaceStateCache().invalidate();
+    pKernel->setArg(0, sizeof(cl_mem), &val);
+    EXPECT_NE(generation, pKernel->getArgumentsGeneration());
+    EXPECT_EQ(buffer.getCpuAddress(), *pKernelArg);
+}
+
+TEST_F(KernelArgBufferTest, givenUnsetArgWhenSameBufferIsSetAgainThenArgIsPatchedAgain) {
+    MockBuffer buffer;
+    auto val = static_cast<cl_mem>(&buffer);
+
+    pKernel->setArg(0, sizeof(cl_mem), &val);
+    pKernel->unsetArg(0);
+    EXPECT_FALSE(pKernel->getKernelArgInfo(0).isPatched);
+
+    auto pKernelArg = reinterpret_cast<void **>(pKernel->getCrossThreadData() +
+                                                pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset);
+    *pKernelArg = nullptr;
+
+    pKernel->setArg(0, sizeof(cl_mem), &val);
+    EXPECT_TRUE(pKernel->getKernelArgInfo(0).isPatched);
+    EXPECT_EQ(buffer.getCpuAddress(), *pKernelArg);
+}
+
+TEST_F(KernelArgBufferTest, givenFailingSetArgWhenSameCallIsRepeatedThenItFailsAgainAndPreviousBufferIsPatchedAgain) {
+    MockBuffer buffer;
+    auto val = static_cast<cl_mem>(&buffer);
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem), &val));
+
+    int notMemObj = 0;
+    auto invalidVal = reinterpret_cast<cl_mem>(&notMemObj);
+    EXPECT_EQ(CL_INVALID_MEM_OBJECT, pKernel->setArg(0, sizeof(cl_mem), &invalidVal));
+    EXPECT_EQ(CL_INVALID_MEM_OBJECT, pKernel->setArg(0, sizeof(cl_mem), &invalidVal));
+
+    auto pKernelArg = reinterpret_cast<void **>(pKernel->getCrossThreadData() +
+                                                pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset);
+    *pKernelArg = nullptr;
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem), &val));
+    EXPECT_EQ(static_cast<const void *>(val), pKernel->getKernelArg(0));
+    EXPECT_EQ(buffer.getCpuAddress(), *pKernelArg);
+}
+
+TEST_F(KernelArgBufferTest, givenDisableKernelArgValueTrackingWhenSameBufferIsSetAgainThenArgIsPatchedAgain) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.DisableKernelArgValueTracking.set(true);
+
+    MockBuffer buffer;
+    auto val = static_cast<cl_mem>(&buffer);
+
+    pKernel->setArg(0, sizeof(cl_mem), &val);
+    auto generation = pKernel->getArgumentsGeneration();
+
+    auto pKernelArg = reinterpret_cast<void **>(pKernel->getCrossThreadData() +
+                                                pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset);
+    *pKernelArg = nullptr;
+
+    pKernel->setArg(0, sizeof(cl_mem), &val);
+    EXPECT_NE(generation, pKernel->getArgumentsGeneration());
+    EXPECT_EQ(buffer.getCpuAddress(), *pKernelArg);
+}
@@ -31,9 +31,11 @@
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/fixtures/execution_model_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
+#include "runtime/helpers/memory_access_set.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/helpers/gtest_helpers.h"
 #include "test.h"
+#include "unit_tests/mocks/mock_buffer.h"
 #include "unit_tests/mocks/mock_kernel.h"
 #include "unit_tests/mocks/mock_program.h"
 #include "unit_tests/mocks/mock_context.h"
@@ -443,7 +445,7 @@ class CommandStreamReceiverMock : public CommandStreamReceiver {
     void addPipeControl(LinearStream &commandStream, bool dcFlush) override {
     }
 
-    void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool quickKmdSleep) override {
+    void waitForTaskCountWithKmdNotifyFallback(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool quickKmdSleep, WaitStrategy waitStrategy) override {
     }
 
     CompletionStamp flushTask(
@@ -1600,6 +1602,87 @@ HWTEST_F(KernelResidencyTest, givenKernelWhenMakeResidentIsCalledThenKernelIsaIs
     memoryManager->freeGraphicsMemory(pKernelInfo->kernelAllocation);
 }
 
+HWTEST_F(KernelResidencyTest, givenSameBufferSetForMultipleArgsWhenMakeResidentIsCalledThenBufferIsMadeResidentOnce) {
+    auto pKernelInfo = std::make_unique<KernelInfo>();
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.storeMakeResidentAllocations = true;
+
+    pKernelInfo->kernelArgInfo.resize(3);
+    MockProgram program(*pDevice->getExecutionEnvironment());
+    std::unique_ptr<MockKernel> pKernel(new MockKernel(&program, *pKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pKernel->initialize());
+
+    MockBuffer sharedBuffer;
+    MockBuffer otherBuffer;
+    pKernel->storeKernelArg(0, Kernel::BUFFER_OBJ, static_cast<cl_mem>(&sharedBuffer), nullptr, sizeof(cl_mem));
+    pKernel->storeKernelArg(1, Kernel::BUFFER_OBJ, static_cast<cl_mem>(&otherBuffer), nullptr, sizeof(cl_mem));
+    pKernel->storeKernelArg(2, Kernel::BUFFER_OBJ, static_cast<cl_mem>(&sharedBuffer), nullptr, sizeof(cl_mem));
+
+    pKernel->makeResident(commandStreamReceiver);
+    EXPECT_EQ(2u, commandStreamReceiver.makeResidentAllocations.size());
+    EXPECT_EQ(1u, commandStreamReceiver.makeResidentAllocations[sharedBuffer.getGraphicsAllocation()]);
+    EXPECT_EQ(1u, commandStreamReceiver.makeResidentAllocations[otherBuffer.getGraphicsAllocation()]);
+}
+
+HWTEST_F(KernelResidencyTest, givenArgChangedAfterMakeResidentWhenMakeResidentIsCalledAgainThenNewArgIsMadeResident) {
+    auto pKernelInfo = std::make_unique<KernelInfo>();
+    auto &commandStreamReceiver = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    commandStreamReceiver.storeMakeResidentAllocations = true;
+
+    pKernelInfo->kernelArgInfo.resize(1);
+    MockProgram program(*pDevice->getExecutionEnvironment());
+    std::unique_ptr<MockKernel> pKernel(new MockKernel(&program, *pKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pKernel->initialize());
+
+    MockBuffer firstBuffer;
+    MockBuffer secondBuffer;
+    pKernel->storeKernelArg(0, Kernel::BUFFER_OBJ, static_cast<cl_mem>(&firstBuffer), nullptr, sizeof(cl_mem));
+    pKernel->makeResident(commandStreamReceiver);
+    EXPECT_TRUE(commandStreamReceiver.isMadeResident(firstBuffer.getGraphicsAllocation()));
+    EXPECT_FALSE(commandStreamReceiver.isMadeResident(secondBuffer.getGraphicsAllocation()));
+
+    pKernel->storeKernelArg(0, Kernel::BUFFER_OBJ, static_cast<cl_mem>(&secondBuffer), nullptr, sizeof(cl_mem));
+    pKernel->makeResident(commandStreamReceiver);
+    EXPECT_EQ(1u, commandStreamReceiver.makeResidentAllocations[firstBuffer.getGraphicsAllocation()]);
+    EXPECT_TRUE(commandStreamReceiver.isMadeResident(secondBuffer.getGraphicsAllocation()));
+}
+
+TEST_F(KernelResidencyTest, givenKernelArgsWhenMemoryAccessSetIsObtainedThenReadOnlyArgsAreReadsAndOtherArgsAreWrites) {
+    auto pKernelInfo = std::make_unique<KernelInfo>();
+    pKernelInfo->kernelArgInfo.resize(2);
+    pKernelInfo->kernelArgInfo[0].accessQualifier = CL_KERNEL_ARG_ACCESS_READ_ONLY;
+    MockProgram program(*pDevice->getExecutionEnvironment());
+    std::unique_ptr<MockKernel> pKernel(new MockKernel(&program, *pKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pKernel->initialize());
+
+    MockBuffer readBuffer;
+    MockBuffer writeBuffer;
+    pKernel->storeKernelArg(0, Kernel::BUFFER_OBJ, static_cast<cl_mem>(&readBuffer), nullptr, sizeof(cl_mem));
+    pKernel->storeKernelArg(1, Kernel::BUFFER_OBJ, static_cast<cl_mem>(&writeBuffer), nullptr, sizeof(cl_mem));
+
+    MemoryAccessSet accessSet;
+    pKernel->getMemoryAccessSet(accessSet);
+    EXPECT_FALSE(accessSet.isUntracked());
+    ASSERT_EQ(1u, accessSet.peekReads().size());
+    EXPECT_EQ(readBuffer.getGraphicsAllocation(), accessSet.peekReads()[0]);
+    ASSERT_EQ(1u, accessSet.peekWrites().size());
+    EXPECT_EQ(writeBuffer.getGraphicsAllocation(), accessSet.peekWrites()[0]);
+}
+
+TEST_F(KernelResidencyTest, givenKernelWithSvmExecInfoWhenMemoryAccessSetIsObtainedThenItIsUntracked) {
+    auto pKernelInfo = std::make_unique<KernelInfo>();
+    MockProgram program(*pDevice->getExecutionEnvironment());
+    std::unique_ptr<MockKernel> pKernel(new MockKernel(&program, *pKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pKernel->initialize());
+
+    GraphicsAllocation svmAllocation(reinterpret_cast<void *>(0x1000), 0x1000);
+    pKernel->setKernelExecInfo(&svmAllocation);
+
+    MemoryAccessSet accessSet;
+    pKernel->getMemoryAccessSet(accessSet);
+    EXPECT_TRUE(accessSet.isUntracked());
+}
+
 TEST(KernelImageDetectionTests, givenKernelWithImagesOnlyWhenItIsAskedIfItHasImagesOnlyThenTrueIsReturned) {
     auto device = std::make_unique<MockDevice>(*platformDevices[0]);
     auto pKernelInfo = std::make_unique<KernelInfo>();
@@ -2254,3 +2337,81 @@ TEST(KernelTest, givenFtrRenderCompressedBuffersWhenInitializingArgsWithNonState
     kernel.mockKernel->initialize();
     EXPECT_TRUE(kernel.mockKernel->isAuxTranslationRequired());
 }
+
+TEST_F(KernelCrossThreadTests, givenValidKernelInfoWhenFirstKernelIsInitializedThenInstanceTemplateIsCapturedAndReusedBySecondKernel) {
+    pKernelInfo->isValid = true;
+    pKernelInfo->workloadInfo.maxWorkGroupSizeOffset = 12;
+    pKernelInfo->kernelArgInfo.resize(2);
+    pKernelInfo->kernelArgInfo[0].typeStr = "char *";
+    pKernelInfo->kernelArgInfo[1].addressQualifier = CL_KERNEL_ARG_ADDRESS_LOCAL;
+    EXPECT_EQ(nullptr, pKernelInfo->instanceTemplate);
+
+    MockKernel firstKernel(program.get(), *pKernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, firstKernel.initialize());
+    auto instanceTemplate = pKernelInfo->instanceTemplate;
+    ASSERT_NE(nullptr, instanceTemplate);
+
+    MockKernel secondKernel(program.get(), *pKernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, secondKernel.initialize());
+    EXPECT_EQ(instanceTemplate, pKernelInfo->instanceTemplate);
+
+    ASSERT_EQ(firstKernel.getCrossThreadDataSize(), secondKernel.getCrossThreadDataSize());
+    EXPECT_EQ(0, memcmp(firstKernel.getCrossThreadData(), secondKernel.getCrossThreadData(), firstKernel.getCrossThreadDataSize()));
+    EXPECT_NE(firstKernel.getCrossThreadData(), secondKernel.getCrossThreadData());
+    EXPECT_EQ(static_cast<void *>(secondKernel.getCrossThreadData() + pKernelInfo->workloadInfo.maxWorkGroupSizeOffset), static_cast<void *>(secondKernel.maxWorkGroupSize));
+    EXPECT_EQ(pDevice->getDeviceInfo().maxWorkGroupSize, *secondKernel.maxWorkGroupSize);
+
+    ASSERT_EQ(2u, secondKernel.kernelArgHandlers.size());
+    EXPECT_EQ(firstKernel.kernelArgHandlers, secondKernel.kernelArgHandlers);
+    EXPECT_EQ(&Kernel::setArgBuffer, secondKernel.kernelArgHandlers[0]);
+    EXPECT_EQ(&Kernel::setArgLocal, secondKernel.kernelArgHandlers[1]);
+    EXPECT_EQ(Kernel::BUFFER_OBJ, secondKernel.getKernelArguments()[0].type);
+    EXPECT_EQ(2u, secondKernel.slmSizes.size());
+}
+
+TEST_F(KernelCrossThreadTests, givenKernelInfoNotDecodedFromBinaryWhenKernelIsInitializedThenInstanceTemplateIsNotCaptured) {
+    pKernelInfo->isValid = false;
+
+    MockKernel kernel(program.get(), *pKernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel.initialize());
+    EXPECT_EQ(nullptr, pKernelInfo->instanceTemplate);
+}
+
+TEST_F(KernelCrossThreadTests, givenDisableKernelInstanceTemplatesWhenKernelIsInitializedThenInstanceTemplateIsNotCaptured) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.DisableKernelInstanceTemplates.set(true);
+    pKernelInfo->isValid = true;
+
+    MockKernel kernel(program.get(), *pKernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel.initialize());
+    EXPECT_EQ(nullptr, pKernelInfo->instanceTemplate);
+}
+
+TEST_F(KernelCrossThreadTests, givenInstanceTemplateWhenKernelWithPrivateSurfaceIsInitializedThenOwnPrivateSurfaceIsPatched) {
+    SPatchAllocateStatelessPrivateSurface tokenSPS;
+    tokenSPS.SurfaceStateHeapOffset = 64;
+    tokenSPS.DataParamOffset = 40;
+    tokenSPS.DataParamSize = 8;
+    tokenSPS.PerThreadPrivateMemorySize = 112;
+    pKernelInfo->patchInfo.pAllocateStatelessPrivateSurface = &tokenSPS;
+    executionEnvironment.CompiledSIMD8 = false;
+    executionEnvironment.CompiledSIMD16 = false;
+    executionEnvironment.CompiledSIMD32 = true;
+    pKernelInfo->isValid = true;
+
+    MockKernel firstKernel(program.get(), *pKernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, firstKernel.initialize());
+    ASSERT_NE(nullptr, pKernelInfo->instanceTemplate);
+
+    MockKernel secondKernel(program.get(), *pKernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, secondKernel.initialize());
+
+    auto firstPrivateSurface = firstKernel.getPrivateSurface();
+    auto secondPrivateSurface = secondKernel.getPrivateSurface();
+    ASSERT_NE(nullptr, firstPrivateSurface);
+    ASSERT_NE(nullptr, secondPrivateSurface);
+    EXPECT_NE(firstPrivateSurface, secondPrivateSurface);
+
+    auto patchedAddress = *reinterpret_cast<uint64_t *>(ptrOffset(secondKernel.getCrossThreadData(), tokenSPS.DataParamOffset));
+    EXPECT_EQ(secondPrivateSurface->getGpuAddressToPatch(), patchedAddress);
+}
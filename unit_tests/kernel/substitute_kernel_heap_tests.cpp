@@ -145,3 +145,31 @@ TEST_F(KernelSubstituteTest, givenKernelWithUsedKernelAllocationWhenSubstituteKe
     memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(secondAllocation);
     memoryManager->cleanAllocationList(firstAllocation->taskCount, TEMPORARY_ALLOCATION);
 }
+
+TEST_F(KernelSubstituteTest, givenKernelWithSharedIsaHeapWhenSubstituteKernelHeapThenAllocatesOwnKernelAllocationAndKeepsSharedHeap) {
+    MockKernelWithInternals kernel(*pDevice);
+    auto pHeader = const_cast<SKernelBinaryHeaderCommon *>(kernel.kernelInfo.heapInfo.pKernelHeader);
+    auto memoryManager = pDevice->getMemoryManager();
+
+    const size_t initialHeapSize = 0x40;
+    pHeader->KernelHeapSize = initialHeapSize;
+
+    auto sharedIsaHeap = memoryManager->allocate32BitGraphicsMemory(MemoryConstants::pageSize, nullptr, AllocationOrigin::INTERNAL_ALLOCATION);
+    kernel.kernelInfo.kernelAllocation = sharedIsaHeap;
+    kernel.kernelInfo.kernelAllocationOffset = static_cast<uint32_t>(KernelInfo::kernelIsaAlignment);
+    kernel.kernelInfo.isKernelAllocationShared = true;
+
+    const size_t newHeapSize = initialHeapSize;
+    char newHeap[newHeapSize];
+
+    kernel.mockKernel->substituteKernelHeap(newHeap, newHeapSize);
+    auto substitutedAllocation = kernel.kernelInfo.kernelAllocation;
+    EXPECT_NE(nullptr, substitutedAllocation);
+    EXPECT_NE(sharedIsaHeap, substitutedAllocation);
+    EXPECT_FALSE(kernel.kernelInfo.isKernelAllocationShared);
+    EXPECT_EQ(0u, kernel.kernelInfo.getKernelAllocationOffset());
+    EXPECT_TRUE(memoryManager->graphicsAllocations.peekIsEmpty());
+
+    memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(substitutedAllocation);
+    memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(sharedIsaHeap);
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/mem_obj/buffer.h"
+#include "runtime/mem_obj/surface_state_cache.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "test.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_context.h"
+
+#include <functional>
+#include <memory>
+
+using namespace OCLRT;
+
+namespace {
+struct TestSurfaceState {
+    uint32_t dwords[4];
+};
+
+struct TestEncoder {
+    void operator()(TestSurfaceState *surfaceState) {
+        encodeCount++;
+        surfaceState->dwords[0] = address;
+        surfaceState->dwords[1] = (surfaceState->dwords[1] & 0xFFFF0000u) | 0x1234u;
+        surfaceState->dwords[3] = 0u;
+    }
+    uint32_t address = 0xABCD0000u;
+    uint32_t encodeCount = 0;
+};
+
+SurfaceStateCache::AllocationState makeAllocationState(uint64_t gpuAddress) {
+    SurfaceStateCache::AllocationState allocationState = {};
+    allocationState.gpuAddress = gpuAddress;
+    return allocationState;
+}
+} // namespace
+
+using MemObjSurfaceStateCacheTest = ::testing::Test;
+
+TEST(SurfaceStateCacheTest, givenCachedEncodingWhenEncodingAgainThenEncoderIsNotCalledAndNotProgrammedBitsAreKept) {
+    SurfaceStateCache cache;
+    TestEncoder encoder;
+    auto allocationState = makeAllocationState(0x1000);
+
+    TestSurfaceState surfaceState = {{0u, 0xAAAA0000u, 0x55555555u, 0xFFFFFFFFu}};
+    cache.encode(&surfaceState, 0u, allocationState, std::ref(encoder));
+    EXPECT_EQ(2u, encoder.encodeCount);
+    EXPECT_EQ(1u, cache.getNumEntries());
+    EXPECT_EQ(0xABCD0000u, surfaceState.dwords[0]);
+    EXPECT_EQ(0xAAAA1234u, surfaceState.dwords[1]);
+    EXPECT_EQ(0x55555555u, surfaceState.dwords[2]);
+    EXPECT_EQ(0u, surfaceState.dwords[3]);
+
+    TestSurfaceState otherSurfaceState = {{0xFFFFFFFFu, 0x1111FFFFu, 0x12345678u, 0x87654321u}};
+    cache.encode(&otherSurfaceState, 0u, allocationState, std::ref(encoder));
+    EXPECT_EQ(2u, encoder.encodeCount);
+    EXPECT_EQ(0xABCD0000u, otherSurfaceState.dwords[0]);
+    EXPECT_EQ(0x11111234u, otherSurfaceState.dwords[1]);
+    EXPECT_EQ(0x12345678u, otherSurfaceState.dwords[2]);
+    EXPECT_EQ(0u, otherSurfaceState.dwords[3]);
+}
+
+TEST(SurfaceStateCacheTest, givenDifferentVariantOrAllocationStateWhenEncodingThenEncoderIsCalledAgain) {
+    SurfaceStateCache cache;
+    TestEncoder encoder;
+    TestSurfaceState surfaceState = {};
+
+    cache.encode(&surfaceState, 0u, makeAllocationState(0x1000), std::ref(encoder));
+    cache.encode(&surfaceState, 1u, makeAllocationState(0x1000), std::ref(encoder));
+    EXPECT_EQ(4u, encoder.encodeCount);
+    EXPECT_EQ(2u, cache.getNumEntries());
+
+    encoder.address = 0x2000u;
+    cache.encode(&surfaceState, 0u, makeAllocationState(0x2000), std::ref(encoder));
+    EXPECT_EQ(6u, encoder.encodeCount);
+    EXPECT_EQ(2u, cache.getNumEntries());
+    EXPECT_EQ(0x2000u, surfaceState.dwords[0]);
+
+    cache.invalidate();
+    EXPECT_EQ(0u, cache.getNumEntries());
+    cache.encode(&surfaceState, 0u, makeAllocationState(0x2000), std::ref(encoder));
+    EXPECT_EQ(8u, encoder.encodeCount);
+}
+
+TEST(SurfaceStateCacheTest, givenMaxEntriesWhenNewVariantIsEncodedThenOldestEntryIsEvicted) {
+    SurfaceStateCache cache;
+    TestEncoder encoder;
+    TestSurfaceState surfaceState = {};
+    auto allocationState = makeAllocationState(0x1000);
+
+    for (uint64_t variant = 0; variant <= SurfaceStateCache::maxEntries; variant++) {
+        cache.encode(&surfaceState, variant, allocationState, std::ref(encoder));
+    }
+    EXPECT_EQ(SurfaceStateCache::maxEntries, cache.getNumEntries());
+
+    encoder.encodeCount = 0;
+    cache.encode(&surfaceState, SurfaceStateCache::maxEntries, allocationState, std::ref(encoder));
+    EXPECT_EQ(0u, encoder.encodeCount);
+    cache.encode(&surfaceState, 0u, allocationState, std::ref(encoder));
+    EXPECT_EQ(2u, encoder.encodeCount);
+}
+
+TEST(SurfaceStateCacheTest, givenDisabledCacheWhenEncodingThenEncoderIsCalledOnceOnDestination) {
+    TestEncoder encoder;
+    TestSurfaceState surfaceState = {};
+    {
+        SurfaceStateCache cache;
+        cache.setEnabled(false);
+        cache.encode(&surfaceState, 0u, makeAllocationState(0x1000), std::ref(encoder));
+        cache.encode(&surfaceState, 0u, makeAllocationState(0x1000), std::ref(encoder));
+        EXPECT_EQ(2u, encoder.encodeCount);
+        EXPECT_EQ(0u, cache.getNumEntries());
+    }
+    {
+        DebugManagerStateRestore restorer;
+        DebugManager.flags.DisableMemObjSurfaceStateCache.set(true);
+        SurfaceStateCache cache;
+        cache.encode(&surfaceState, 0u, makeAllocationState(0x1000), std::ref(encoder));
+        EXPECT_EQ(3u, encoder.encodeCount);
+        EXPECT_EQ(0u, cache.getNumEntries());
+    }
+    EXPECT_EQ(0xABCD0000u, surfaceState.dwords[0]);
+}
+
+HWTEST_F(MemObjSurfaceStateCacheTest, givenBufferWhenSetArgStatefulIsCalledOnDifferentSurfaceStatesThenResultMatchesUncachedEncoding) {
+    using RENDER_SURFACE_STATE = typename FamilyType::RENDER_SURFACE_STATE;
+    MockContext context;
+    auto retVal = CL_SUCCESS;
+    std::unique_ptr<Buffer> buffer(Buffer::create(&context, CL_MEM_READ_WRITE, MemoryConstants::pageSize, nullptr, retVal));
+    ASSERT_NE(nullptr, buffer);
+
+    RENDER_SURFACE_STATE cachedSurfaceStates[2];
+    RENDER_SURFACE_STATE uncachedSurfaceState;
+    memset(&cachedSurfaceStates[0], 0, sizeof(RENDER_SURFACE_STATE));
+    memset(&cachedSurfaceStates[1], 0x5A, sizeof(RENDER_SURFACE_STATE));
+    memset(&uncachedSurfaceState, 0x5A, sizeof(RENDER_SURFACE_STATE));
+
+    buffer->setArgStateful(&cachedSurfaceStates[0], false);
+    buffer->setArgStateful(&cachedSurfaceStates[1], false);
+    EXPECT_EQ(1u, buffer->getSurfaceStateCache().getNumEntries());
+
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.DisableMemObjSurfaceStateCache.set(true);
+    buffer->setArgStateful(&uncachedSurfaceState, false);
+
+    EXPECT_EQ(0, memcmp(&uncachedSurfaceState, &cachedSurfaceStates[1], sizeof(RENDER_SURFACE_STATE)));
+    EXPECT_EQ(buffer->getGraphicsAllocation()->getGpuAddress(), cachedSurfaceStates[0].getSurfaceBaseAddress());
+}
+
+HWTEST_F(MemObjSurfaceStateCacheTest, givenBufferWithCachedSurfaceStateWhenGraphicsAllocationIsResetThenCacheIsInvalidated) {
+    using RENDER_SURFACE_STATE = typename FamilyType::RENDER_SURFACE_STATE;
+    MockContext context;
+    auto retVal = CL_SUCCESS;
+    std::unique_ptr<Buffer> buffer(Buffer::create(&context, CL_MEM_READ_WRITE, MemoryConstants::pageSize, nullptr, retVal));
+    ASSERT_NE(nullptr, buffer);
+
+    RENDER_SURFACE_STATE surfaceState = {};
+    buffer->setArgStateful(&surfaceState, false);
+    buffer->setArgStateful(&surfaceState, true);
+    EXPECT_EQ(2u, buffer->getSurfaceStateCache().getNumEntries());
+
+    auto newAllocation = context.getMemoryManager()->allocateGraphicsMemory(MemoryConstants::pageSize);
+    buffer->resetGraphicsAllocation(newAllocation);
+    EXPECT_EQ(0u, buffer->getSurfaceStateCache().getNumEntries());
+
+    buffer->setArgStateful(&surfaceState, false);
+    EXPECT_EQ(newAllocation->getGpuAddress(), surfaceState.getSurfaceBaseAddress());
+}
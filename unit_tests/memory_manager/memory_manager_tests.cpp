@@ -1096,6 +1096,25 @@ TEST(OsAgnosticMemoryManager, clearResidencyAllocations) {
     memoryManager.freeGraphicsMemory(graphicsAllocation);
 }
 
+TEST(OsAgnosticMemoryManager, givenResidencyAllocationsWhenReserveIsCalledThenCapacityCoversAdditionalAllocationsAndContentIsPreserved) {
+    OsAgnosticMemoryManager memoryManager;
+    auto graphicsAllocation = memoryManager.allocateGraphicsMemory(4096u);
+
+    memoryManager.pushAllocationForResidency(graphicsAllocation);
+    memoryManager.reserveResidencyAllocations(100u);
+
+    EXPECT_LE(101u, memoryManager.getResidencyAllocations().capacity());
+    ASSERT_EQ(1u, memoryManager.getResidencyAllocations().size());
+    EXPECT_EQ(graphicsAllocation, memoryManager.getResidencyAllocations()[0]);
+
+    auto capacity = memoryManager.getResidencyAllocations().capacity();
+    memoryManager.reserveResidencyAllocations(1u);
+    EXPECT_EQ(capacity, memoryManager.getResidencyAllocations().capacity());
+
+    memoryManager.clearResidencyAllocations();
+    memoryManager.freeGraphicsMemory(graphicsAllocation);
+}
+
 TEST(OsAgnosticMemoryManager, pushAllocationForEviction) {
     OsAgnosticMemoryManager memoryManager;
     auto graphicsAllocation = memoryManager.allocateGraphicsMemory(4096u);
@@ -75,6 +75,13 @@ class MockHandler : public AsyncEventsHandler {
 
     bool peekIsListEmpty() { return list.size() == 0; }
     bool peekIsRegisterListEmpty() { return registerList.size() == 0; }
+    size_t peekNumTrackedEvents() {
+        size_t numTracked = 0;
+        for (auto &tracked : trackedEvents) {
+            numTracked += tracked.second.size();
+        }
+        return numTracked;
+    }
     std::atomic<int> transferCounter;
     bool openThreadCalled = false;
     bool allowThreadCreating = false;
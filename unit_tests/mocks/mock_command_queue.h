@@ -77,6 +77,8 @@ class MockCommandQueueHw : public CommandQueueHw<GfxFamily> {
 
   public:
     using BaseClass::createAllocationForHostSurface;
+    using BaseClass::recordingCommandStream;
+    using BaseClass::recordingHeaps;
     using BaseClass::timestampPacketNode;
 
     MockCommandQueueHw(Context *context,
@@ -45,6 +45,10 @@ struct MockEvent : public BaseEventType {
     // make some protected members public :
     FORWARD_FUNC(submitCommand, BaseEventType);
 
+    using BaseEventType::completeTimeStamp;
+    using BaseEventType::dataCalculated;
+    using BaseEventType::endTimeStamp;
+    using BaseEventType::startTimeStamp;
     using BaseEventType::timeStampNode;
     using Event::magic;
 };
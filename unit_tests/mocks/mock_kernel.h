@@ -202,6 +202,8 @@ class MockKernel : public Kernel {
 
     void setKernelArguments(std::vector<SimpleKernelArgInfo> kernelArguments) {
         this->kernelArguments = kernelArguments;
+        this->argFingerprints.resize(kernelArguments.size());
+        this->argumentsGeneration++;
     }
 
     template <typename PatchTokenT>
@@ -37,6 +37,7 @@ class GraphicsAllocation;
 ////////////////////////////////////////////////////////////////////////////////
 class MockProgram : public Program {
   public:
+    using Program::createKernelIsaHeap;
     using Program::createProgramFromBinary;
     using Program::getProgramCompilerVersion;
     using Program::isKernelDebugEnabled;
@@ -52,6 +53,7 @@ class MockProgram : public Program {
     using Program::irBinarySize;
     using Program::isProgramBinaryResolved;
     using Program::isSpirV;
+    using Program::kernelMetadata;
     using Program::programBinaryType;
 
     using Program::sourceCode;
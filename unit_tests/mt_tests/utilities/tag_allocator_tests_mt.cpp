@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/utilities/tag_allocator.h"
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+
+struct TagAllocatorMtTestTag {
+    uint64_t start;
+    uint64_t end;
+};
+
+TEST(TagAllocatorMtTest, givenManyThreadsTakingAndReturningTagsWhenDoneThenEveryTagIsFreeAndNoneWasSharedConcurrently) {
+    OsAgnosticMemoryManager memoryManager;
+    TagAllocator<TagAllocatorMtTestTag> tagAllocator(&memoryManager, 8, 64);
+
+    constexpr uint32_t numThreads = 8;
+    constexpr uint32_t numIterations = 2000;
+    constexpr uint32_t tagsPerIteration = 4;
+    std::atomic<bool> start{false};
+    std::atomic<uint32_t> numConflicts{0};
+    std::vector<std::thread> threads;
+
+    for (uint32_t threadId = 0; threadId < numThreads; threadId++) {
+        threads.push_back(std::thread([&, threadId] {
+            while (!start) {
+            }
+            TagNode<TagAllocatorMtTestTag> *tags[tagsPerIteration];
+            for (uint32_t i = 0; i < numIterations; i++) {
+                for (auto &tag : tags) {
+                    tag = tagAllocator.getTag();
+                    tag->tag->start = threadId;
+                }
+                for (auto &tag : tags) {
+                    if (tag->tag->start != threadId) {
+                        numConflicts++;
+                    }
+                    tagAllocator.returnTag(tag);
+                }
+            }
+        }));
+    }
+    start = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0u, numConflicts.load());
+    EXPECT_EQ(tagAllocator.peekNumTags(), tagAllocator.peekNumFreeTags());
+}
+
+TEST(TagAllocatorMtTest, givenTagsReturnedOnOtherThreadWhenFreeListIsEmptyThenCachedTagsAreTakenWithoutGrowingPool) {
+    OsAgnosticMemoryManager memoryManager;
+    TagAllocator<TagAllocatorMtTestTag> tagAllocator(&memoryManager, 8, 64);
+
+    std::vector<TagNode<TagAllocatorMtTestTag> *> tags;
+    while (tagAllocator.peekNumFreeTags() > 0) {
+        tags.push_back(tagAllocator.getTag());
+    }
+    auto numTags = tagAllocator.peekNumTags();
+    ASSERT_LE(static_cast<size_t>(TagAllocatorConstants::cachedNodesPerSlot), tags.size());
+
+    std::thread returningThread([&] {
+        for (uint32_t i = 0; i < TagAllocatorConstants::cachedNodesPerSlot; i++) {
+            tagAllocator.returnTag(tags.back());
+            tags.pop_back();
+        }
+    });
+    returningThread.join();
+    EXPECT_EQ(static_cast<size_t>(TagAllocatorConstants::cachedNodesPerSlot), tagAllocator.peekNumFreeTags());
+
+    for (uint32_t i = 0; i < TagAllocatorConstants::cachedNodesPerSlot; i++) {
+        tags.push_back(tagAllocator.getTag());
+    }
+    EXPECT_EQ(numTags, tagAllocator.peekNumTags());
+    EXPECT_EQ(0u, tagAllocator.peekNumFreeTags());
+
+    for (auto tag : tags) {
+        tagAllocator.returnTag(tag);
+    }
+    EXPECT_EQ(numTags, tagAllocator.peekNumFreeTags());
+}
+} // namespace OCLRT
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "environment.h"
+#include "mock/mock_batch_compiler.h"
+#include "elf/reader.h"
+#include "runtime/helpers/file_io.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+
+extern Environment *gEnvironment;
+
+namespace OCLRT {
+
+TEST(BatchCompilerTest, givenCommandLineWithBatchOptionThenItIsRecognizedAsBatchCommandLine) {
+    auto argvBatch = {"cloc", "-batch", "manifest.txt"};
+    auto argvSingle = {"cloc", "-file", "test_files/copybuffer.cl", "-device", "skl"};
+
+    EXPECT_TRUE(BatchCompiler::isBatchCommandLine(argvBatch.size(), argvBatch.begin()));
+    EXPECT_FALSE(BatchCompiler::isBatchCommandLine(argvSingle.size(), argvSingle.begin()));
+}
+
+TEST(BatchCompilerTest, givenLineWithQuotedArgumentsWhenSplitThenQuotedArgumentIsKeptWhole) {
+    std::vector<std::string> args;
+    EXPECT_TRUE(BatchCompiler::splitCommandLine("-file a.cl  -options \"-cl-mad-enable -DX=1\"\t-q", args));
+
+    ASSERT_EQ(5u, args.size());
+    EXPECT_EQ("-file", args[0]);
+    EXPECT_EQ("a.cl", args[1]);
+    EXPECT_EQ("-options", args[2]);
+    EXPECT_EQ("-cl-mad-enable -DX=1", args[3]);
+    EXPECT_EQ("-q", args[4]);
+}
+
+TEST(BatchCompilerTest, givenLineWithUnterminatedQuoteWhenSplitThenFalseIsReturned) {
+    std::vector<std::string> args;
+    EXPECT_FALSE(BatchCompiler::splitCommandLine("-file a.cl -options \"-cl-mad-enable", args));
+}
+
+TEST(BatchCompilerTest, givenManifestWithDeviceListWhenParsedThenOneItemPerDeviceIsCreated) {
+    MockBatchCompiler batchCompiler;
+    std::string manifest = "# comment\n"
+                           "\n"
+                           "-file a.cl -device skl,kbl -options \"-cl-fast-relaxed-math\"\r\n"
+                           "-file b.cl -device skl\n";
+
+    EXPECT_EQ(CL_SUCCESS, batchCompiler.parseManifest(manifest));
+
+    ASSERT_EQ(3u, batchCompiler.items.size());
+    std::vector<std::string> expectedArgs = {"-file", "a.cl", "-device", "skl", "-options", "-cl-fast-relaxed-math"};
+    EXPECT_EQ(expectedArgs, batchCompiler.items[0].args);
+    EXPECT_EQ(3u, batchCompiler.items[0].lineNumber);
+    expectedArgs[3] = "kbl";
+    EXPECT_EQ(expectedArgs, batchCompiler.items[1].args);
+    EXPECT_EQ(3u, batchCompiler.items[1].lineNumber);
+    expectedArgs = {"-file", "b.cl", "-device", "skl"};
+    EXPECT_EQ(expectedArgs, batchCompiler.items[2].args);
+    EXPECT_EQ(4u, batchCompiler.items[2].lineNumber);
+}
+
+TEST(BatchCompilerTest, givenManifestWithoutBuildsWhenParsedThenErrorIsReturned) {
+    MockBatchCompiler batchCompiler;
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_FILE, batchCompiler.parseManifest("# only a comment\n\n"));
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_TRUE(batchCompiler.items.empty());
+}
+
+TEST(BatchCompilerTest, givenMissingManifestWhenCreatingBatchCompilerThenInvalidFileIsReturned) {
+    auto argv = {"cloc", "-batch", "test_files/missing_manifest.txt"};
+    int retVal = CL_SUCCESS;
+
+    testing::internal::CaptureStdout();
+    auto pBatchCompiler = BatchCompiler::create(argv.size(), argv.begin(), retVal);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(nullptr, pBatchCompiler);
+    EXPECT_EQ(INVALID_FILE, retVal);
+}
+
+TEST(BatchCompilerTest, givenManifestWhenBuildIsCalledThenAllItemsAreCompiledWithSharedLibraries) {
+    std::string manifestFileName = "test_files/batch_manifest.txt";
+    std::string manifest = "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + " -output batch_first\n" +
+                           "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + " -output batch_second\n";
+    writeDataToFile(manifestFileName.c_str(), manifest.c_str(), manifest.size());
+
+    auto argv = {"cloc", "-batch", manifestFileName.c_str(), "-threads", "2", "-q"};
+    auto batchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+    int retVal = batchCompiler->initialize(argv.size(), argv.begin());
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(2u, batchCompiler->numThreads);
+    EXPECT_NE(nullptr, batchCompiler->compilerLibraries);
+
+    testing::internal::CaptureStdout();
+    retVal = batchCompiler->build();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    ASSERT_EQ(2u, batchCompiler->items.size());
+    for (auto &item : batchCompiler->items) {
+        EXPECT_EQ(CL_SUCCESS, item.retVal);
+    }
+    EXPECT_TRUE(fileExists("batch_first_" + gEnvironment->familyNameWithType + ".bin"));
+    EXPECT_TRUE(fileExists("batch_second_" + gEnvironment->familyNameWithType + ".bin"));
+
+    std::remove(manifestFileName.c_str());
+}
+
+TEST(BatchCompilerTest, givenManifestWithFailingItemWhenBuildIsCalledThenFailureIsReportedAndOtherItemsAreBuilt) {
+    std::string manifestFileName = "test_files/batch_manifest_failing.txt";
+    std::string manifest = "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + "\n" +
+                           "-file test_files/missing_file.cl -device " + gEnvironment->devicePrefix + "\n";
+    writeDataToFile(manifestFileName.c_str(), manifest.c_str(), manifest.size());
+
+    auto argv = {"cloc", "-batch", manifestFileName.c_str(), "-threads", "1"};
+    int retVal = CL_SUCCESS;
+    auto pBatchCompiler = std::unique_ptr<BatchCompiler>(BatchCompiler::create(argv.size(), argv.begin(), retVal));
+    ASSERT_NE(nullptr, pBatchCompiler);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    testing::internal::CaptureStdout();
+    retVal = pBatchCompiler->build();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(INVALID_FILE, retVal);
+    EXPECT_NE(std::string::npos, output.find("[1/2] line 1, test_files/copybuffer.cl (" + gEnvironment->devicePrefix + "): Build succeeded."));
+    EXPECT_NE(std::string::npos, output.find("[2/2] line 2, test_files/missing_file.cl (" + gEnvironment->devicePrefix + "): Build failed with error code: " + std::to_string(INVALID_FILE)));
+    EXPECT_NE(std::string::npos, output.find("1 succeeded, 1 failed"));
+
+    std::remove(manifestFileName.c_str());
+}
+
+TEST(BatchCompilerTest, givenPackOptionWhenBuildIsCalledThenMultiDeviceBinaryWithAllDeviceBinariesIsWritten) {
+    std::string manifestFileName = "test_files/batch_manifest_pack.txt";
+    std::string packFileName = "batch_packed.bin";
+    std::string manifest = "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + "\n";
+    writeDataToFile(manifestFileName.c_str(), manifest.c_str(), manifest.size());
+
+    auto argv = {"cloc", "-batch", manifestFileName.c_str(), "-pack", packFileName.c_str(), "-q"};
+    auto batchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+    int retVal = batchCompiler->initialize(argv.size(), argv.begin());
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(packFileName, batchCompiler->packFile);
+
+    testing::internal::CaptureStdout();
+    retVal = batchCompiler->build();
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    void *pBinary = nullptr;
+    size_t binarySize = loadDataFromFile(packFileName.c_str(), pBinary);
+    ASSERT_NE(0u, binarySize);
+    CLElfLib::ElfBinaryStorage binary(reinterpret_cast<char *>(pBinary), reinterpret_cast<char *>(pBinary) + binarySize);
+    deleteDataReadFromFile(pBinary);
+
+    CLElfLib::CElfReader elfReader(binary);
+    EXPECT_EQ(CLElfLib::E_EH_TYPE::EH_TYPE_OPENCL_EXECUTABLE, elfReader.getElfHeader()->Type);
+    size_t numVariants = 0;
+    size_t numIrSections = 0;
+    for (auto &sectionHeader : elfReader.getSectionHeaders()) {
+        if (sectionHeader.Type == CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_DEV_BINARY_VARIANT) {
+            auto pHeader = reinterpret_cast<const DeviceBinaryVariant::Header *>(elfReader.getSectionData(sectionHeader.DataOffset));
+            EXPECT_EQ(DeviceBinaryVariant::magic, pHeader->magic);
+            numVariants++;
+        } else if (sectionHeader.Type == CLElfLib::E_SH_TYPE::SH_TYPE_SPIRV || sectionHeader.Type == CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_LLVM_BINARY) {
+            numIrSections++;
+        }
+    }
+    EXPECT_EQ(1u, numVariants);
+    EXPECT_EQ(1u, numIrSections);
+
+    std::remove(packFileName.c_str());
+    std::remove(manifestFileName.c_str());
+}
+
+TEST(BatchCompilerTest, givenPackOptionAndSameDeviceOnTwoLinesWhenBuildIsCalledThenErrorIsReturned) {
+    std::string manifestFileName = "test_files/batch_manifest_pack_duplicate.txt";
+    std::string packFileName = "batch_packed_duplicate.bin";
+    std::string manifest = "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + "\n" +
+                           "-file test_files/copybuffer.cl -device " + gEnvironment->devicePrefix + "\n";
+    writeDataToFile(manifestFileName.c_str(), manifest.c_str(), manifest.size());
+
+    auto argv = {"cloc", "-batch", manifestFileName.c_str(), "-pack", packFileName.c_str(), "-q"};
+    int retVal = CL_SUCCESS;
+    auto pBatchCompiler = std::unique_ptr<BatchCompiler>(BatchCompiler::create(argv.size(), argv.begin(), retVal));
+    ASSERT_NE(nullptr, pBatchCompiler);
+
+    testing::internal::CaptureStdout();
+    retVal = pBatchCompiler->build();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(INVALID_COMMAND_LINE, retVal);
+    EXPECT_FALSE(fileExists(packFileName));
+
+    std::remove(manifestFileName.c_str());
+}
+} // namespace OCLRT
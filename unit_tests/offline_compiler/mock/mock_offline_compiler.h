@@ -30,6 +30,8 @@ class MockOfflineCompiler : public OfflineCompiler {
   public:
     using OfflineCompiler::generateFilePathForIr;
     using OfflineCompiler::generateOptsSuffix;
+    using OfflineCompiler::getRuntimeInternalOptions;
+    using OfflineCompiler::hwInfo;
     using OfflineCompiler::igcDeviceCtx;
     using OfflineCompiler::inputFileLlvm;
     using OfflineCompiler::inputFileSpirV;
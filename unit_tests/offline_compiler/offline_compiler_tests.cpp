@@ -23,9 +23,12 @@
 #include "environment.h"
 #include "mock/mock_offline_compiler.h"
 #include "offline_compiler_tests.h"
+#include "runtime/compiler_interface/binary_cache.h"
+#include "runtime/compiler_interface/compiler_options.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/file_io.h"
 #include "runtime/helpers/options.h"
+#include "runtime/memory_manager/memory_constants.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_compilers.h"
@@ -820,4 +823,75 @@ TEST(OfflineCompilerTest, givenEnabledOptsSuffixWhenGenerateOptsSuffixIsCalledTh
     EXPECT_STREQ("A_B_C", suffix.c_str());
 }
 
+TEST(OfflineCompilerTest, givenCacheDirOptionWhenSourceIsBuiltThenCacheEntryWithRuntimeCacheKeyIsWritten) {
+    auto argv = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-device",
+        gEnvironment->devicePrefix.c_str(),
+        "-cache_dir",
+        "offline_compiler_test/cache",
+        "-q"};
+
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    int retVal = mockOfflineCompiler->initialize(argv.size(), argv.begin());
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    retVal = mockOfflineCompiler->build();
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    auto &internalOptions = mockOfflineCompiler->getInternalOptions();
+    auto kernelFileHash = BinaryCache::getCachedFileName(*mockOfflineCompiler->hwInfo,
+                                                         ArrayRef<const char>(mockOfflineCompiler->sourceCode.c_str(), mockOfflineCompiler->sourceCode.size()),
+                                                         ArrayRef<const char>(mockOfflineCompiler->options.c_str(), mockOfflineCompiler->options.size()),
+                                                         ArrayRef<const char>(internalOptions.c_str(), internalOptions.size()));
+    std::string cacheFile = "offline_compiler_test/cache/" + kernelFileHash + BinaryCache::cacheFileExtension;
+    EXPECT_TRUE(fileExists(cacheFile));
+    std::remove(cacheFile.c_str());
+}
+
+TEST(OfflineCompilerTest, givenCacheDirOptionWhenCommandLineIsParsedThenRuntimeInternalOptionsAreUsed) {
+    auto argv = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-device",
+        gEnvironment->devicePrefix.c_str(),
+        "-internal_options",
+        "-cl-intel-some-internal-option",
+        "-cache_dir",
+        "offline_compiler_test/cache"};
+
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    int retVal = mockOfflineCompiler->parseCommandLine(argv.size(), argv.begin());
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    auto &internalOptions = mockOfflineCompiler->getInternalOptions();
+    EXPECT_EQ(mockOfflineCompiler->getRuntimeInternalOptions(is64bit), internalOptions);
+    EXPECT_THAT(internalOptions, ::testing::HasSubstr(std::string("-ocl-version=")));
+    EXPECT_THAT(internalOptions, ::testing::HasSubstr(std::string(CompilerOptions::preserveVec3Type)));
+    EXPECT_THAT(internalOptions, ::testing::HasSubstr(std::string("-cl-ext=-all,+cl")));
+    EXPECT_THAT(internalOptions, ::testing::Not(::testing::HasSubstr(std::string("-cl-intel-some-internal-option"))));
+}
+
+TEST(OfflineCompilerTest, givenCacheDirOptionAndIntermediateRepresentationInputWhenCommandLineIsParsedThenErrorIsReturned) {
+    auto argv = {
+        "cloc",
+        "-spirv_input",
+        "-file",
+        "test_files/binary_with_zeroes",
+        "-device",
+        gEnvironment->devicePrefix.c_str(),
+        "-cache_dir",
+        "offline_compiler_test/cache"};
+
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    testing::internal::CaptureStdout();
+    int retVal = mockOfflineCompiler->parseCommandLine(argv.size(), argv.begin());
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(INVALID_COMMAND_LINE, retVal);
+}
+
 } // namespace OCLRT
@@ -20,6 +20,7 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/os_interface/linux/device_command_stream_fixture.h"
 #include "unit_tests/os_interface/linux/mock_os_time_linux.h"
 #include "runtime/os_interface/linux/drm_neo.h"
@@ -41,6 +42,14 @@ int getTimeFuncTrue(clockid_t clkId, struct timespec *tp) throw() {
     return 0;
 }
 
+static uint64_t fakeCpuTimeNs = 0;
+
+int getTimeFuncFake(clockid_t clkId, struct timespec *tp) throw() {
+    tp->tv_sec = fakeCpuTimeNs / NSEC_PER_SEC;
+    tp->tv_nsec = fakeCpuTimeNs % NSEC_PER_SEC;
+    return 0;
+}
+
 int resolutionFuncFalse(clockid_t clkId, struct timespec *res) throw() {
     return -1;
 }
@@ -51,6 +60,23 @@ int resolutionFuncTrue(clockid_t clkId, struct timespec *res) throw() {
 }
 
 using namespace OCLRT;
+
+// timestamp register ticking at 80ns resolution of fake cpu clock
+class DrmMockLinearTime : public DrmMockSuccess {
+  public:
+    int ioctl(unsigned long request, void *arg) override {
+        if (request == DRM_IOCTL_I915_REG_READ) {
+            regReads++;
+            drm_i915_reg_read *reg = reinterpret_cast<drm_i915_reg_read *>(arg);
+            reg->val = (fakeCpuTimeNs / 80 + tickOffset) & 0x0000000FFFFFFFFF;
+        }
+        return 0;
+    };
+
+    uint32_t regReads = 0;
+    uint64_t tickOffset = 0;
+};
+
 struct DrmTimeTest : public ::testing::Test {
   public:
     void SetUp() override {
@@ -235,3 +261,116 @@ TEST_F(DrmTimeTest, givenAlwaysPassingResolutionFuncWhenGetCpuRawTimestampIsCall
     auto retVal = osTime->getCpuRawTimestamp();
     EXPECT_EQ(1ull, retVal);
 }
+
+struct DrmTimeClockModelTest : public ::testing::Test {
+    void SetUp() override {
+        DebugManager.flags.CpuGpuTimeModelValidityMicroseconds.set(10000);
+        osInterface = std::unique_ptr<OSInterface>(new OSInterface());
+        osTime = MockOSTimeLinux::create(osInterface.get());
+        osTime->setGetTimeFunc(getTimeFuncFake);
+        drm = std::unique_ptr<DrmMockLinearTime>(new DrmMockLinearTime());
+        osTime->updateDrm(drm.get());
+        drm->regReads = 0;
+        fakeCpuTimeNs = 1000000;
+    }
+
+    DebugManagerStateRestore restore;
+    std::unique_ptr<OSInterface> osInterface;
+    std::unique_ptr<MockOSTimeLinux> osTime;
+    std::unique_ptr<DrmMockLinearTime> drm;
+};
+
+TEST_F(DrmTimeClockModelTest, givenCalibratedClockModelWhenGetCpuGpuTimeIsCalledWithinValidityThenPredictGpuTimeWithoutRegisterRead) {
+    TimeStampData cpuGpuTime = {0, 0};
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(1u, drm->regReads);
+
+    // interval too short to fit drift, register is still read
+    fakeCpuTimeNs += 1000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(2u, drm->regReads);
+
+    fakeCpuTimeNs = 1000000 + 6000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(3u, drm->regReads);
+
+    fakeCpuTimeNs += 4000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(3u, drm->regReads);
+    EXPECT_EQ(fakeCpuTimeNs, cpuGpuTime.CPUTimeinNS);
+    EXPECT_EQ(fakeCpuTimeNs / 80, cpuGpuTime.GPUTimeStamp);
+}
+
+TEST_F(DrmTimeClockModelTest, givenCalibratedClockModelWhenValidityExpiresThenSampleRegisterAgain) {
+    TimeStampData cpuGpuTime = {0, 0};
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    fakeCpuTimeNs += 6000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(2u, drm->regReads);
+
+    fakeCpuTimeNs += 10000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(3u, drm->regReads);
+    EXPECT_EQ(fakeCpuTimeNs / 80, cpuGpuTime.GPUTimeStamp);
+
+    fakeCpuTimeNs += 1000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(3u, drm->regReads);
+}
+
+TEST_F(DrmTimeClockModelTest, givenPredictedGpuTimeBeyondTimestampWidthWhenGetCpuGpuTimeIsCalledThenWrapIt) {
+    TimeStampData cpuGpuTime = {0, 0};
+    uint64_t wrapCpuTimeNs = (1ull << 36) * 80;
+    fakeCpuTimeNs = wrapCpuTimeNs - 6000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    fakeCpuTimeNs = wrapCpuTimeNs - 800;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(2u, drm->regReads);
+
+    fakeCpuTimeNs = wrapCpuTimeNs + 8000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(2u, drm->regReads);
+    EXPECT_EQ(100u, cpuGpuTime.GPUTimeStamp);
+}
+
+TEST_F(DrmTimeClockModelTest, givenRegisterSampleBehindLastPredictionWhenGetCpuGpuTimeIsCalledThenGpuTimeDoesNotGoBackwards) {
+    TimeStampData cpuGpuTime = {0, 0};
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    fakeCpuTimeNs += 6000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    fakeCpuTimeNs += 9000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(2u, drm->regReads);
+    auto lastGpuTimeStamp = cpuGpuTime.GPUTimeStamp;
+
+    drm->tickOffset = static_cast<uint64_t>(-20000);
+    fakeCpuTimeNs += 1000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(3u, drm->regReads);
+    EXPECT_EQ(fakeCpuTimeNs, cpuGpuTime.CPUTimeinNS);
+    EXPECT_EQ(lastGpuTimeStamp, cpuGpuTime.GPUTimeStamp);
+
+    fakeCpuTimeNs += 1000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(lastGpuTimeStamp, cpuGpuTime.GPUTimeStamp);
+
+    // once the register catches up, reported time follows it again
+    fakeCpuTimeNs += 20000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+    EXPECT_EQ(fakeCpuTimeNs / 80 - 20000, cpuGpuTime.GPUTimeStamp);
+}
+
+TEST_F(DrmTimeClockModelTest, givenDisabledClockModelWhenGetCpuGpuTimeIsCalledThenAlwaysReadRegister) {
+    DebugManager.flags.CpuGpuTimeModelValidityMicroseconds.set(0);
+    osTime = MockOSTimeLinux::create(osInterface.get());
+    osTime->setGetTimeFunc(getTimeFuncFake);
+    osTime->updateDrm(drm.get());
+    drm->regReads = 0;
+
+    TimeStampData cpuGpuTime = {0, 0};
+    for (uint32_t i = 1; i <= 3; i++) {
+        fakeCpuTimeNs += 6000000;
+        EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+        EXPECT_EQ(i, drm->regReads);
+    }
+}
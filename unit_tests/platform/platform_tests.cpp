@@ -168,6 +168,29 @@ TEST_F(PlatformTest, givenNotSupportingCl21WhenPlatformNotSupportFp64ThenNotFill
     EXPECT_THAT(compilerExtensions, ::testing::EndsWith(std::string(" ")));
 }
 
+TEST_F(PlatformTest, givenInitializedPlatformWhenGettingDeviceExtensionsForDeviceHardwareThenReportedDeviceExtensionsStartWithThem) {
+    ASSERT_TRUE(pPlatform->initialize());
+    auto device = pPlatform->getDevice(0);
+
+    std::string deviceExtensions = getDeviceExtensions(device->getHardwareInfo(), device->getEnabledClVersion());
+    std::string reportedExtensions = device->getDeviceInfo().deviceExtensions;
+
+    EXPECT_EQ(0u, reportedExtensions.find(deviceExtensions));
+}
+
+TEST_F(PlatformTest, givenFp64OverrideWhenGettingDeviceExtensionsThenFp64IsReportedAccordingToOverride) {
+    DebugManagerStateRestore dbgRestorer;
+    HardwareInfo testHwInfo = *platformDevices[0];
+    testHwInfo.capabilityTable.ftrSupportsFP64 = false;
+
+    DebugManager.flags.OverrideDefaultFP64Settings.set(1);
+    EXPECT_THAT(getDeviceExtensions(testHwInfo, 12), ::testing::HasSubstr(std::string("cl_khr_fp64")));
+
+    testHwInfo.capabilityTable.ftrSupportsFP64 = true;
+    DebugManager.flags.OverrideDefaultFP64Settings.set(0);
+    EXPECT_THAT(getDeviceExtensions(testHwInfo, 12), ::testing::Not(::testing::HasSubstr(std::string("cl_khr_fp64"))));
+}
+
 TEST_F(PlatformTest, testRemoveLastSpace) {
     std::string emptyString = "";
     removeLastSpace(emptyString);
@@ -462,6 +462,82 @@ TEST(EventProfilingTest, givenEventWhenCompleteIsZeroThenCalcProfilingDataSetsEn
     cmdQ.device = nullptr;
 }
 
+TEST(EventProfilingTest, givenCompletedEventsWhenProfilingDataIsCalculatedInBatchThenResultsMatchPerEventCalculation) {
+    std::unique_ptr<MockDevice> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    MockContext context;
+    cl_command_queue_properties props[5] = {0, 0, 0, 0, 0};
+    MockCommandQueue cmdQ(&context, device.get(), props);
+    cmdQ.setProfilingEnabled();
+    cmdQ.device = device.get();
+
+    HwTimeStamps timestamps[3] = {{10, 20, 80, 56, 0, 0}, {100, 120, 0, 200, 0, 260}, {1000, 0xFFFFFFF0, 0, 0x10, 0, 0}};
+    HwTimeStamps referenceTimestamps[3];
+    memcpy(referenceTimestamps, timestamps, sizeof(timestamps));
+    MockTagNode<HwTimeStamps> timestampNodes[3];
+    MockTagNode<HwTimeStamps> referenceTimestampNodes[3];
+    TimeStampData queueTimeStamp = {40, 5000};
+
+    std::vector<std::unique_ptr<MockEvent<Event>>> events;
+    std::vector<std::unique_ptr<MockEvent<Event>>> referenceEvents;
+    std::vector<Event *> completedEvents;
+    for (int i = 0; i < 3; i++) {
+        timestampNodes[i].tag = &timestamps[i];
+        referenceTimestampNodes[i].tag = &referenceTimestamps[i];
+
+        events.emplace_back(new MockEvent<Event>(&cmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 0));
+        events[i]->setCPUProfilingPath(false);
+        events[i]->timeStampNode = &timestampNodes[i];
+        events[i]->setQueueTimeStamp(&queueTimeStamp);
+        completedEvents.push_back(events[i].get());
+
+        referenceEvents.emplace_back(new MockEvent<Event>(&cmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 0));
+        referenceEvents[i]->setCPUProfilingPath(false);
+        referenceEvents[i]->timeStampNode = &referenceTimestampNodes[i];
+        referenceEvents[i]->setQueueTimeStamp(&queueTimeStamp);
+    }
+
+    Event::calcProfilingDataBatch(completedEvents);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(events[i]->dataCalculated);
+        EXPECT_TRUE(referenceEvents[i]->calcProfilingData());
+        EXPECT_EQ(referenceEvents[i]->startTimeStamp, events[i]->startTimeStamp);
+        EXPECT_EQ(referenceEvents[i]->endTimeStamp, events[i]->endTimeStamp);
+        EXPECT_EQ(referenceEvents[i]->completeTimeStamp, events[i]->completeTimeStamp);
+        EXPECT_EQ(timestamps[i].ContextCompleteTS, referenceTimestamps[i].ContextCompleteTS);
+
+        events[i]->timeStampNode = nullptr;
+        referenceEvents[i]->timeStampNode = nullptr;
+    }
+    events.clear();
+    referenceEvents.clear();
+    cmdQ.device = nullptr;
+}
+
+TEST(EventProfilingTest, givenEventWithCpuProfilingPathWhenProfilingDataIsCalculatedInBatchThenSkipIt) {
+    std::unique_ptr<MockDevice> device(MockDevice::createWithNewExecutionEnvironment<MockDevice>(nullptr));
+    MockContext context;
+    cl_command_queue_properties props[5] = {0, 0, 0, 0, 0};
+    MockCommandQueue cmdQ(&context, device.get(), props);
+    cmdQ.setProfilingEnabled();
+    cmdQ.device = device.get();
+
+    HwTimeStamps timestamp = {10, 20, 80, 56, 0, 0};
+    MockTagNode<HwTimeStamps> timestampNode;
+    timestampNode.tag = &timestamp;
+
+    MockEvent<Event> event(&cmdQ, CL_COMMAND_MAP_BUFFER, 0, 0);
+    event.setCPUProfilingPath(true);
+    event.timeStampNode = &timestampNode;
+    Event *completedEvents[] = {&event};
+
+    Event::calcProfilingDataBatch(completedEvents);
+    EXPECT_FALSE(event.dataCalculated);
+
+    event.timeStampNode = nullptr;
+    cmdQ.device = nullptr;
+}
+
 struct ProfilingWithPerfCountersTests : public ProfilingTests,
                                         public PerformanceCountersFixture {
     void SetUp() override {
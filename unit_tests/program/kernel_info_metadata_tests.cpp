@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/kernel_info_metadata.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_program.h"
+#include "unit_tests/program/program_from_binary.h"
+#include "elf/reader.h"
+#include "test.h"
+
+#include <memory>
+
+using namespace OCLRT;
+
+class KernelInfoMetadataTest : public ProgramSimpleFixture,
+                               public ::testing::Test {
+  public:
+    void SetUp() override {
+        ProgramSimpleFixture::SetUp();
+        device = pDevice;
+        CreateProgramFromBinary<MockProgram>(pContext, &device, "CopyBuffer_simd8");
+        ASSERT_NE(nullptr, pProgram);
+        retVal = pProgram->build(1, &device, nullptr, nullptr, nullptr, false);
+        ASSERT_EQ(CL_SUCCESS, retVal);
+        kernelInfo = pProgram->getKernelInfo("CopyBuffer");
+        ASSERT_NE(nullptr, kernelInfo);
+    }
+
+    void TearDown() override {
+        ProgramSimpleFixture::TearDown();
+    }
+
+    void expectSameKernelInfo(const KernelInfo &expected, const KernelInfo &actual) {
+        EXPECT_EQ(expected.patchInfo.executionEnvironment, actual.patchInfo.executionEnvironment);
+        EXPECT_EQ(expected.patchInfo.threadPayload, actual.patchInfo.threadPayload);
+        EXPECT_EQ(expected.patchInfo.dataParameterStream, actual.patchInfo.dataParameterStream);
+        EXPECT_EQ(expected.patchInfo.bindingTableState, actual.patchInfo.bindingTableState);
+        EXPECT_EQ(expected.patchInfo.interfaceDescriptorData, actual.patchInfo.interfaceDescriptorData);
+        EXPECT_EQ(expected.patchInfo.pKernelAttributesInfo, actual.patchInfo.pKernelAttributesInfo);
+        EXPECT_EQ(expected.patchInfo.dataParameterBuffers, actual.patchInfo.dataParameterBuffers);
+        EXPECT_EQ(expected.patchInfo.statelessGlobalMemObjKernelArgs, actual.patchInfo.statelessGlobalMemObjKernelArgs);
+        EXPECT_EQ(expected.patchInfo.kernelArgumentInfo, actual.patchInfo.kernelArgumentInfo);
+        EXPECT_EQ(0, memcmp(&expected.workloadInfo, &actual.workloadInfo, sizeof(WorkloadInfo)));
+        EXPECT_EQ(expected.attributes, actual.attributes);
+        EXPECT_EQ(expected.requiredSubGroupSize, actual.requiredSubGroupSize);
+        EXPECT_EQ(expected.usesSsh, actual.usesSsh);
+        EXPECT_EQ(expected.requiresSshForBuffers, actual.requiresSshForBuffers);
+        EXPECT_EQ(expected.argumentsToPatchNum, actual.argumentsToPatchNum);
+        EXPECT_EQ(expected.workgroupDimensionsOrder, actual.workgroupDimensionsOrder);
+        for (uint32_t i = 0; i < 3; i++) {
+            EXPECT_EQ(expected.reqdWorkGroupSize[i], actual.reqdWorkGroupSize[i]);
+        }
+
+        ASSERT_EQ(expected.kernelArgInfo.size(), actual.kernelArgInfo.size());
+        for (size_t i = 0; i < expected.kernelArgInfo.size(); i++) {
+            const auto &expectedArg = expected.kernelArgInfo[i];
+            const auto &actualArg = actual.kernelArgInfo[i];
+            EXPECT_EQ(expectedArg.name, actualArg.name);
+            EXPECT_EQ(expectedArg.typeStr, actualArg.typeStr);
+            EXPECT_EQ(expectedArg.offsetHeap, actualArg.offsetHeap);
+            EXPECT_EQ(expectedArg.isBuffer, actualArg.isBuffer);
+            EXPECT_EQ(expectedArg.needPatch, actualArg.needPatch);
+            EXPECT_EQ(expectedArg.accessQualifier, actualArg.accessQualifier);
+            EXPECT_EQ(expectedArg.addressQualifier, actualArg.addressQualifier);
+            EXPECT_EQ(expectedArg.typeQualifier, actualArg.typeQualifier);
+            ASSERT_EQ(expectedArg.kernelArgPatchInfoVector.size(), actualArg.kernelArgPatchInfoVector.size());
+            for (size_t j = 0; j < expectedArg.kernelArgPatchInfoVector.size(); j++) {
+                EXPECT_EQ(expectedArg.kernelArgPatchInfoVector[j].crossthreadOffset, actualArg.kernelArgPatchInfoVector[j].crossthreadOffset);
+                EXPECT_EQ(expectedArg.kernelArgPatchInfoVector[j].size, actualArg.kernelArgPatchInfoVector[j].size);
+                EXPECT_EQ(expectedArg.kernelArgPatchInfoVector[j].sourceOffset, actualArg.kernelArgPatchInfoVector[j].sourceOffset);
+            }
+        }
+    }
+
+    cl_device_id device = nullptr;
+    const KernelInfo *kernelInfo = nullptr;
+};
+
+TEST_F(KernelInfoMetadataTest, givenEncodedKernelInfoWhenDecodedThenKernelInfoMatchesParsedPatchTokens) {
+    std::vector<char> metadata;
+    ASSERT_TRUE(KernelInfoMetadataEncoder::encode({kernelInfo}, metadata));
+
+    KernelInfoMetadataDecoder decoder(metadata.data(), metadata.size(), 1);
+    ASSERT_TRUE(decoder.isValid());
+
+    KernelInfo decodedKernelInfo;
+    decodedKernelInfo.heapInfo = kernelInfo->heapInfo;
+    const void *igcInfo = nullptr;
+    EXPECT_EQ(KernelInfoMetadataDecoder::DecodeStatus::Success, decoder.decodeNextKernel(decodedKernelInfo, igcInfo));
+    expectSameKernelInfo(*kernelInfo, decodedKernelInfo);
+}
+
+TEST_F(KernelInfoMetadataTest, givenMetadataWithDifferentVersionOrKernelCountWhenDecoderIsCreatedThenItIsInvalid) {
+    std::vector<char> metadata;
+    ASSERT_TRUE(KernelInfoMetadataEncoder::encode({kernelInfo}, metadata));
+
+    KernelInfoMetadataDecoder decoderWithWrongKernelCount(metadata.data(), metadata.size(), 2);
+    EXPECT_FALSE(decoderWithWrongKernelCount.isValid());
+
+    reinterpret_cast<KernelInfoMetadata::Header *>(metadata.data())->version++;
+    KernelInfoMetadataDecoder decoderWithWrongVersion(metadata.data(), metadata.size(), 1);
+    EXPECT_FALSE(decoderWithWrongVersion.isValid());
+
+    KernelInfoMetadataDecoder decoderWithoutMetadata(nullptr, 0, 1);
+    EXPECT_FALSE(decoderWithoutMetadata.isValid());
+}
+
+TEST_F(KernelInfoMetadataTest, givenKernelWithDifferentCheckSumWhenDecodedThenKernelMismatchIsReturnedAndKernelInfoIsUntouched) {
+    std::vector<char> metadata;
+    ASSERT_TRUE(KernelInfoMetadataEncoder::encode({kernelInfo}, metadata));
+
+    auto kernelHeader = *kernelInfo->heapInfo.pKernelHeader;
+    kernelHeader.CheckSum++;
+
+    KernelInfo decodedKernelInfo;
+    decodedKernelInfo.heapInfo = kernelInfo->heapInfo;
+    decodedKernelInfo.heapInfo.pKernelHeader = &kernelHeader;
+
+    KernelInfoMetadataDecoder decoder(metadata.data(), metadata.size(), 1);
+    const void *igcInfo = nullptr;
+    EXPECT_EQ(KernelInfoMetadataDecoder::DecodeStatus::KernelMismatch, decoder.decodeNextKernel(decodedKernelInfo, igcInfo));
+    EXPECT_EQ(nullptr, decodedKernelInfo.patchInfo.executionEnvironment);
+    EXPECT_EQ(0u, decodedKernelInfo.kernelArgInfo.size());
+}
+
+TEST_F(KernelInfoMetadataTest, givenTruncatedMetadataWhenDecodedThenInvalidMetadataIsReturned) {
+    std::vector<char> metadata;
+    ASSERT_TRUE(KernelInfoMetadataEncoder::encode({kernelInfo}, metadata));
+    metadata.resize(metadata.size() - 1);
+
+    KernelInfoMetadataDecoder decoder(metadata.data(), metadata.size(), 1);
+    ASSERT_TRUE(decoder.isValid());
+
+    KernelInfo decodedKernelInfo;
+    decodedKernelInfo.heapInfo = kernelInfo->heapInfo;
+    const void *igcInfo = nullptr;
+    EXPECT_EQ(KernelInfoMetadataDecoder::DecodeStatus::InvalidMetadata, decoder.decodeNextKernel(decodedKernelInfo, igcInfo));
+}
+
+TEST_F(KernelInfoMetadataTest, givenBuiltExecutableWhenBinaryIsResolvedThenKernelMetadataSectionIsAddedAndUsedByNewProgram) {
+    auto mockProgram = static_cast<MockProgram *>(pProgram);
+    mockProgram->isProgramBinaryResolved = false;
+    EXPECT_EQ(CL_SUCCESS, mockProgram->resolveProgramBinary());
+    EXPECT_FALSE(mockProgram->kernelMetadata.empty());
+
+    CLElfLib::CElfReader elfReader(mockProgram->elfBinary);
+    bool hasKernelMetadataSection = false;
+    for (const auto &sectionHeader : elfReader.getSectionHeaders()) {
+        hasKernelMetadataSection |= (sectionHeader.Type == CLElfLib::E_SH_TYPE::SH_TYPE_OPENCL_KERNEL_METADATA);
+    }
+    EXPECT_TRUE(hasKernelMetadataSection);
+
+    auto binary = reinterpret_cast<const unsigned char *>(mockProgram->elfBinary.data());
+    size_t binarySize = mockProgram->elfBinarySize;
+    std::unique_ptr<MockProgram> programFromElf(Program::create<MockProgram>(pContext, 1, &device, &binarySize, &binary, nullptr, retVal));
+    ASSERT_NE(nullptr, programFromElf);
+    EXPECT_FALSE(programFromElf->kernelMetadata.empty());
+
+    retVal = programFromElf->build(1, &device, nullptr, nullptr, nullptr, false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    auto kernelInfoFromElf = programFromElf->Program::getKernelInfo("CopyBuffer");
+    ASSERT_NE(nullptr, kernelInfoFromElf);
+    EXPECT_TRUE(kernelInfoFromElf->isValid);
+    EXPECT_EQ(kernelInfo->kernelArgInfo.size(), kernelInfoFromElf->kernelArgInfo.size());
+    EXPECT_EQ(kernelInfo->patchInfo.dataParameterBuffers.size(), kernelInfoFromElf->patchInfo.dataParameterBuffers.size());
+    EXPECT_EQ(kernelInfo->getConstantBufferSize(), kernelInfoFromElf->getConstantBufferSize());
+    EXPECT_NE(nullptr, kernelInfoFromElf->getGraphicsAllocation());
+}
+
+TEST_F(KernelInfoMetadataTest, givenDisabledKernelInfoMetadataWhenBinaryIsResolvedThenMetadataIsNotGenerated) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.DisableKernelInfoMetadata.set(true);
+
+    auto mockProgram = static_cast<MockProgram *>(pProgram);
+    mockProgram->isProgramBinaryResolved = false;
+    EXPECT_EQ(CL_SUCCESS, mockProgram->resolveProgramBinary());
+    EXPECT_TRUE(mockProgram->kernelMetadata.empty());
+}
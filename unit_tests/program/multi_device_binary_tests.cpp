@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/options.h"
+#include "runtime/program/multi_device_binary.h"
+#include "unit_tests/mocks/mock_program.h"
+#include "unit_tests/program/program_from_binary.h"
+#include "test.h"
+
+#include <memory>
+
+using namespace OCLRT;
+
+namespace {
+std::string makeVariantSection(GFXCORE_FAMILY coreFamily, PRODUCT_FAMILY productFamily, const std::string &deviceBinary) {
+    DeviceBinaryVariant::Header header = {};
+    header.magic = DeviceBinaryVariant::magic;
+    header.coreFamily = coreFamily;
+    header.productFamily = productFamily;
+    return std::string(reinterpret_cast<const char *>(&header), sizeof(header)) + deviceBinary;
+}
+
+GFXCORE_FAMILY getOtherCoreFamily(GFXCORE_FAMILY coreFamily) {
+    return coreFamily == IGFX_GEN8_CORE ? IGFX_GEN9_CORE : IGFX_GEN8_CORE;
+}
+
+class MockProgramWithIrRebuild : public MockProgram {
+  public:
+    using MockProgram::MockProgram;
+
+    cl_int rebuildProgramFromIr() override {
+        rebuildCalled++;
+        return rebuildRetVal;
+    }
+
+    uint32_t rebuildCalled = 0;
+    cl_int rebuildRetVal = CL_SUCCESS;
+};
+} // namespace
+
+TEST(DeviceBinaryVariantSelectorTest, givenVariantsOfSameCoreFamilyWhenSelectingThenVariantOfDeviceProductIsPreferred) {
+    const HardwareInfo &hwInfo = *platformDevices[0];
+    auto coreFamily = hwInfo.pPlatform->eRenderCoreFamily;
+    auto productFamily = hwInfo.pPlatform->eProductFamily;
+    auto otherProductFamily = static_cast<PRODUCT_FAMILY>(productFamily + 1);
+
+    auto otherFamilySection = makeVariantSection(getOtherCoreFamily(coreFamily), productFamily, "other family");
+    auto otherProductSection = makeVariantSection(coreFamily, otherProductFamily, "other product");
+    auto exactSection = makeVariantSection(coreFamily, productFamily, "exact");
+
+    DeviceBinaryVariantSelector selector(hwInfo);
+    EXPECT_FALSE(selector.hasVariants());
+
+    EXPECT_TRUE(selector.addVariant(otherFamilySection.data(), otherFamilySection.size()));
+    EXPECT_TRUE(selector.hasVariants());
+    EXPECT_EQ(nullptr, selector.getSelectedBinary());
+
+    EXPECT_TRUE(selector.addVariant(otherProductSection.data(), otherProductSection.size()));
+    ASSERT_NE(nullptr, selector.getSelectedBinary());
+    EXPECT_EQ("other product", std::string(selector.getSelectedBinary(), selector.getSelectedBinarySize()));
+
+    EXPECT_TRUE(selector.addVariant(exactSection.data(), exactSection.size()));
+    ASSERT_NE(nullptr, selector.getSelectedBinary());
+    EXPECT_EQ("exact", std::string(selector.getSelectedBinary(), selector.getSelectedBinarySize()));
+
+    EXPECT_TRUE(selector.addVariant(otherProductSection.data(), otherProductSection.size()));
+    EXPECT_EQ("exact", std::string(selector.getSelectedBinary(), selector.getSelectedBinarySize()));
+}
+
+TEST(DeviceBinaryVariantSelectorTest, givenMalformedVariantSectionWhenAddingThenFalseIsReturned) {
+    const HardwareInfo &hwInfo = *platformDevices[0];
+    auto section = makeVariantSection(hwInfo.pPlatform->eRenderCoreFamily, hwInfo.pPlatform->eProductFamily, "binary");
+
+    DeviceBinaryVariantSelector selector(hwInfo);
+    EXPECT_FALSE(selector.addVariant(nullptr, 0));
+    EXPECT_FALSE(selector.addVariant(section.data(), sizeof(DeviceBinaryVariant::Header)));
+
+    section[0] = ~section[0];
+    EXPECT_FALSE(selector.addVariant(section.data(), section.size()));
+    EXPECT_FALSE(selector.hasVariants());
+}
+
+class MultiDeviceBinaryTest : public ProgramSimpleFixture,
+                              public ::testing::Test {
+  public:
+    void SetUp() override {
+        ProgramSimpleFixture::SetUp();
+        device = pDevice;
+        CreateProgramFromBinary<MockProgram>(pContext, &device, "CopyBuffer_simd8");
+        ASSERT_NE(nullptr, pProgram);
+
+        size_t genBinarySize = 0;
+        auto pGenBinary = pProgram->getGenBinary(genBinarySize);
+        ASSERT_NE(nullptr, pGenBinary);
+        deviceBinary.assign(pGenBinary, genBinarySize);
+        coreFamily = pDevice->getHardwareInfo().pPlatform->eRenderCoreFamily;
+        productFamily = pDevice->getHardwareInfo().pPlatform->eProductFamily;
+    }
+
+    void TearDown() override {
+        ProgramSimpleFixture::TearDown();
+    }
+
+    cl_device_id device = nullptr;
+    std::string deviceBinary;
+    GFXCORE_FAMILY coreFamily = IGFX_UNKNOWN_CORE;
+    PRODUCT_FAMILY productFamily = IGFX_UNKNOWN;
+};
+
+TEST_F(MultiDeviceBinaryTest, givenMultiDeviceBinaryWhenProgramIsCreatedThenDeviceBinaryOfMatchingVariantIsUsed) {
+    std::string otherDeviceBinary(deviceBinary.size(), 0);
+    std::vector<DeviceBinaryVariant::Desc> variants = {
+        {getOtherCoreFamily(coreFamily), productFamily, otherDeviceBinary},
+        {coreFamily, productFamily, deviceBinary}};
+
+    CLElfLib::ElfBinaryStorage binary;
+    MultiDeviceBinaryWriter::write(variants, "", false, "-cl-opt-disable", binary);
+
+    MockProgram program(*pDevice->getExecutionEnvironment(), pContext, false);
+    EXPECT_EQ(CL_SUCCESS, program.createProgramFromBinary(binary.data(), binary.size()));
+    EXPECT_EQ(static_cast<cl_uint>(CL_PROGRAM_BINARY_TYPE_EXECUTABLE), program.getProgramBinaryType());
+    EXPECT_STREQ("-cl-opt-disable", program.getOptions().c_str());
+
+    size_t genBinarySize = 0;
+    auto pGenBinary = program.getGenBinary(genBinarySize);
+    ASSERT_NE(nullptr, pGenBinary);
+    EXPECT_EQ(deviceBinary, std::string(pGenBinary, genBinarySize));
+
+    retVal = program.build(1, &device, nullptr, nullptr, nullptr, false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(nullptr, program.Program::getKernelInfo("CopyBuffer"));
+}
+
+TEST_F(MultiDeviceBinaryTest, givenMultiDeviceBinaryWithoutMatchingVariantWhenProgramIsCreatedThenProgramIsRebuiltFromIr) {
+    std::vector<DeviceBinaryVariant::Desc> variants = {
+        {getOtherCoreFamily(coreFamily), productFamily, deviceBinary}};
+    const uint32_t spirvMagic = 0x07230203;
+    std::string irBinary(reinterpret_cast<const char *>(&spirvMagic), sizeof(spirvMagic));
+
+    CLElfLib::ElfBinaryStorage binary;
+    MultiDeviceBinaryWriter::write(variants, irBinary, true, "", binary);
+
+    MockProgramWithIrRebuild program(*pDevice->getExecutionEnvironment(), pContext, false);
+    EXPECT_EQ(CL_SUCCESS, program.createProgramFromBinary(binary.data(), binary.size()));
+    EXPECT_EQ(1u, program.rebuildCalled);
+    EXPECT_TRUE(program.getIsSpirV());
+    EXPECT_EQ(irBinary, std::string(program.irBinary, program.irBinarySize));
+
+    program.rebuildRetVal = CL_BUILD_PROGRAM_FAILURE;
+    EXPECT_EQ(CL_INVALID_BINARY, program.createProgramFromBinary(binary.data(), binary.size()));
+    EXPECT_EQ(2u, program.rebuildCalled);
+}
+
+TEST_F(MultiDeviceBinaryTest, givenMultiDeviceBinaryWithoutMatchingVariantAndIrWhenProgramIsCreatedThenInvalidBinaryIsReturned) {
+    std::vector<DeviceBinaryVariant::Desc> variants = {
+        {getOtherCoreFamily(coreFamily), productFamily, deviceBinary}};
+
+    CLElfLib::ElfBinaryStorage binary;
+    MultiDeviceBinaryWriter::write(variants, "", false, "", binary);
+
+    MockProgram program(*pDevice->getExecutionEnvironment(), pContext, false);
+    EXPECT_EQ(CL_INVALID_BINARY, program.createProgramFromBinary(binary.data(), binary.size()));
+}
@@ -652,9 +652,9 @@ TEST_P(ProgramFromBinaryTest, givenProgramWhenItIsBeingBuildThenItContainsGraphi
     auto graphicsAllocation = kernelInfo->getGraphicsAllocation();
     ASSERT_NE(nullptr, graphicsAllocation);
     EXPECT_TRUE(graphicsAllocation->is32BitAllocation);
-    EXPECT_EQ(graphicsAllocation->getUnderlyingBufferSize(), kernelInfo->heapInfo.pKernelHeader->KernelHeapSize);
+    EXPECT_LE(kernelInfo->getKernelAllocationOffset() + kernelInfo->heapInfo.pKernelHeader->KernelHeapSize, graphicsAllocation->getUnderlyingBufferSize());
 
-    auto kernelIsa = graphicsAllocation->getUnderlyingBuffer();
+    auto kernelIsa = ptrOffset(graphicsAllocation->getUnderlyingBuffer(), kernelInfo->getKernelAllocationOffset());
     EXPECT_NE(kernelInfo->heapInfo.pKernelHeap, kernelIsa);
     EXPECT_EQ(0, memcmp(kernelIsa, kernelInfo->heapInfo.pKernelHeap, kernelInfo->heapInfo.pKernelHeader->KernelHeapSize));
     if (sizeof(void *) == sizeof(uint32_t)) {
@@ -1720,6 +1720,16 @@ TEST_F(ProgramTests, ProgramCtorSetsProperInternalOptionsForced20) {
     pDevice->getMutableDeviceInfo()->clVersion = defaultVersion;
 }
 
+TEST_F(ProgramTests, givenDeviceWhenProgramIsCreatedThenInternalOptionsMatchDeviceInternalOptions) {
+    MockProgram program(*pDevice->getExecutionEnvironment(), pContext, false);
+
+    auto expectedInternalOptions = CompilerOptions::getDeviceInternalOptions(pDevice->getEnabledClVersion(),
+                                                                             pDevice->getDeviceInfo().force32BitAddressess,
+                                                                             pDevice->getHardwareCapabilities().isStatelesToStatefullWithOffsetSupported);
+    expectedInternalOptions += CompilerOptions::preserveVec3Type;
+    EXPECT_EQ(expectedInternalOptions, program.getInternalOptions());
+}
+
 TEST_F(ProgramTests, ProgramCtorSetsProperInternalOptionsWhenStatelessToStatefulIsDisabled) {
     cl_int retVal = CL_DEVICE_NOT_FOUND;
     auto defaultSetting = DebugManager.flags.DisableStatelessToStatefulOptimization.get();
@@ -2499,6 +2509,60 @@ TEST_F(ProgramTests, givenProgramWithBlockKernelsWhenfreeBlockResourcesisCalledT
     delete program;
 }
 
+TEST_F(ProgramTests, givenProgramWithMultipleKernelsWhenKernelIsaHeapIsCreatedThenAllKernelsSharePackedAllocation) {
+    auto program = std::make_unique<MockProgram>(*pDevice->getExecutionEnvironment(), pContext, false);
+
+    const uint32_t kernelHeapSizes[] = {0x44, 0x100, 0x10};
+    char kernelHeaps[3][0x100];
+    SKernelBinaryHeaderCommon kernelHeaders[3] = {};
+    for (uint32_t i = 0; i < 3; i++) {
+        memset(kernelHeaps[i], static_cast<int>(i + 1), sizeof(kernelHeaps[i]));
+        kernelHeaders[i].KernelHeapSize = kernelHeapSizes[i];
+        auto kernelInfo = new KernelInfo;
+        kernelInfo->heapInfo.pKernelHeader = &kernelHeaders[i];
+        kernelInfo->heapInfo.pKernelHeap = kernelHeaps[i];
+        program->addKernelInfo(kernelInfo);
+    }
+
+    EXPECT_EQ(CL_SUCCESS, program->createKernelIsaHeap());
+
+    auto &kernelInfoArray = program->getKernelInfoArray();
+    auto isaHeap = kernelInfoArray[0]->getGraphicsAllocation();
+    ASSERT_NE(nullptr, isaHeap);
+    EXPECT_TRUE(isaHeap->is32BitAllocation);
+    size_t expectedOffset = 0;
+    for (uint32_t i = 0; i < 3; i++) {
+        auto kernelInfo = kernelInfoArray[i];
+        expectedOffset = alignUp(expectedOffset, KernelInfo::kernelIsaAlignment);
+        EXPECT_EQ(isaHeap, kernelInfo->getGraphicsAllocation());
+        EXPECT_TRUE(kernelInfo->isKernelAllocationShared);
+        EXPECT_EQ(expectedOffset, kernelInfo->getKernelAllocationOffset());
+        EXPECT_EQ(isaHeap->getGpuAddressToPatch() + expectedOffset, kernelInfo->getKernelIsaGpuAddressToPatch());
+        EXPECT_EQ(0, memcmp(ptrOffset(isaHeap->getUnderlyingBuffer(), expectedOffset), kernelHeaps[i], kernelHeapSizes[i]));
+        expectedOffset += kernelHeapSizes[i];
+    }
+    EXPECT_LE(expectedOffset + KernelInfo::kernelIsaPrefetchPadding, isaHeap->getUnderlyingBufferSize());
+}
+
+TEST_F(ProgramTests, givenKernelsPackedIntoIsaHeapWhenGettingIsaGpuAddressThenEachKernelHasDistinctStartAddress) {
+    auto program = std::make_unique<MockProgram>(*pDevice->getExecutionEnvironment(), pContext, false);
+
+    char kernelHeap[0x40] = {};
+    SKernelBinaryHeaderCommon kernelHeader = {};
+    kernelHeader.KernelHeapSize = sizeof(kernelHeap);
+    for (uint32_t i = 0; i < 2; i++) {
+        auto kernelInfo = new KernelInfo;
+        kernelInfo->heapInfo.pKernelHeader = &kernelHeader;
+        kernelInfo->heapInfo.pKernelHeap = kernelHeap;
+        program->addKernelInfo(kernelInfo);
+    }
+    EXPECT_EQ(CL_SUCCESS, program->createKernelIsaHeap());
+
+    auto &kernelInfoArray = program->getKernelInfoArray();
+    EXPECT_EQ(kernelInfoArray[0]->getGraphicsAllocation(), kernelInfoArray[1]->getGraphicsAllocation());
+    EXPECT_NE(kernelInfoArray[0]->getKernelIsaGpuAddressToPatch(), kernelInfoArray[1]->getKernelIsaGpuAddressToPatch());
+}
+
 class Program32BitTests : public ProgramTests {
   public:
     void SetUp() override {
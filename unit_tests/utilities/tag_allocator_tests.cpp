@@ -46,20 +46,15 @@ class MockTagAllocator : public TagAllocator<timeStamps> {
     }
 
     TagNode<timeStamps> *getFreeTagsHead() {
-        return TagAllocator<timeStamps>::freeTags.peekHead();
+        auto index = static_cast<uint32_t>(freeHead.load());
+        return index == TagAllocatorConstants::invalidIndex ? nullptr : getNode(index);
     }
 
-    TagNode<timeStamps> *getUsedTagsHead() {
-        return TagAllocator<timeStamps>::usedTags.peekHead();
+    size_t getNumUsedTags() {
+        return peekNumTags() - peekNumFreeTags();
     }
 
-    IDList<TagNode<timeStamps>> &getFreeTags() {
-        return TagAllocator<timeStamps>::freeTags;
-    }
-
-    IDList<TagNode<timeStamps>> &getUsedTags() {
-        return TagAllocator<timeStamps>::usedTags;
-    }
+    using TagAllocator<timeStamps>::popFromFreeTags;
 
     size_t getGraphicsAllocationsCount() {
         return gfxAllocations.size();
@@ -77,7 +72,7 @@ TEST_F(TagAllocatorTest, Initialize) {
     ASSERT_NE(nullptr, tagAllocator.getGraphicsAllocation());
 
     ASSERT_NE(nullptr, tagAllocator.getFreeTagsHead());
-    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_EQ(0u, tagAllocator.getNumUsedTags());
 
     void *gfxMemory = tagAllocator.getGraphicsAllocation()->getUnderlyingBuffer();
     void *head = reinterpret_cast<void *>(tagAllocator.getFreeTagsHead()->tag);
@@ -90,28 +85,19 @@ TEST_F(TagAllocatorTest, GetReturnTagCheckFreeAndUsedLists) {
 
     ASSERT_NE(nullptr, tagAllocator.getGraphicsAllocation());
     ASSERT_NE(nullptr, tagAllocator.getFreeTagsHead());
-    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_EQ(0u, tagAllocator.getNumUsedTags());
 
     TagNode<timeStamps> *tagNode = tagAllocator.getTag();
 
     EXPECT_NE(nullptr, tagNode);
 
-    IDList<TagNode<timeStamps>> &freeList = tagAllocator.getFreeTags();
-    IDList<TagNode<timeStamps>> &usedList = tagAllocator.getUsedTags();
-
-    bool isFoundOnUsedList = usedList.peekContains(*tagNode);
-    bool isFoundOnFreeList = freeList.peekContains(*tagNode);
-
-    EXPECT_FALSE(isFoundOnFreeList);
-    EXPECT_TRUE(isFoundOnUsedList);
+    EXPECT_FALSE(tagAllocator.peekIsFreeTag(tagNode));
+    EXPECT_EQ(1u, tagAllocator.getNumUsedTags());
 
     tagAllocator.returnTag(tagNode);
 
-    isFoundOnUsedList = usedList.peekContains(*tagNode);
-    isFoundOnFreeList = freeList.peekContains(*tagNode);
-
-    EXPECT_TRUE(isFoundOnFreeList);
-    EXPECT_FALSE(isFoundOnUsedList);
+    EXPECT_TRUE(tagAllocator.peekIsFreeTag(tagNode));
+    EXPECT_EQ(0u, tagAllocator.getNumUsedTags());
 }
 
 TEST_F(TagAllocatorTest, TagAlignment) {
@@ -175,24 +161,23 @@ TEST_F(TagAllocatorTest, GetTagsAndReturnInDifferentOrder) {
     EXPECT_EQ(2u, tagAllocator.getGraphicsAllocationsCount());
     EXPECT_EQ(2u, tagAllocator.getTagPoolCount());
 
-    IDList<TagNode<timeStamps>> &freeList = tagAllocator.getFreeTags();
-    bool isFoundOnFreeList = freeList.peekContains(*tagNodes[0]);
+    bool isFoundOnFreeList = tagAllocator.peekIsFreeTag(tagNodes[0]);
     EXPECT_FALSE(isFoundOnFreeList);
 
     tagAllocator.returnTag(tagNodes[2]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[2]);
+    isFoundOnFreeList = tagAllocator.peekIsFreeTag(tagNodes[2]);
     EXPECT_TRUE(isFoundOnFreeList);
     EXPECT_NE(nullptr, tagAllocator.getFreeTagsHead());
 
     tagAllocator.returnTag(tagNodes[3]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[3]);
+    isFoundOnFreeList = tagAllocator.peekIsFreeTag(tagNodes[3]);
     EXPECT_TRUE(isFoundOnFreeList);
 
     tagAllocator.returnTag(tagNodes[1]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[1]);
+    isFoundOnFreeList = tagAllocator.peekIsFreeTag(tagNodes[1]);
     EXPECT_TRUE(isFoundOnFreeList);
 
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[0]);
+    isFoundOnFreeList = tagAllocator.peekIsFreeTag(tagNodes[0]);
     EXPECT_FALSE(isFoundOnFreeList);
 
     tagAllocator.returnTag(tagNodes[0]);
@@ -256,16 +241,60 @@ TEST_F(TagAllocatorTest, givenMultipleReferencesOnTagWhenReleasingThenReturnWhen
     MockTagAllocator tagAllocator(memoryManager, 2, 1);
 
     auto tag = tagAllocator.getTag();
-    EXPECT_NE(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_EQ(1u, tagAllocator.getNumUsedTags());
     tagAllocator.returnTag(tag);
-    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead()); // only 1 reference
+    EXPECT_EQ(0u, tagAllocator.getNumUsedTags()); // only 1 reference
 
     tag = tagAllocator.getTag();
     tag->incRefCount();
-    EXPECT_NE(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_EQ(1u, tagAllocator.getNumUsedTags());
 
     tagAllocator.returnTag(tag);
-    EXPECT_NE(nullptr, tagAllocator.getUsedTagsHead()); // 1 reference left
+    EXPECT_EQ(1u, tagAllocator.getNumUsedTags()); // 1 reference left
+    tagAllocator.returnTag(tag);
+    EXPECT_EQ(0u, tagAllocator.getNumUsedTags());
+}
+
+TEST_F(TagAllocatorTest, givenReturnedTagWhenTagIsTakenOnSameThreadThenReuseCachedNode) {
+    MockTagAllocator tagAllocator(memoryManager, 10, 16);
+
+    auto tag = tagAllocator.getTag();
+    auto freeHead = tagAllocator.getFreeTagsHead();
+    tagAllocator.returnTag(tag);
+    EXPECT_EQ(freeHead, tagAllocator.getFreeTagsHead()); // returned to thread cache, shared free list untouched
+
+    EXPECT_EQ(tag, tagAllocator.getTag());
     tagAllocator.returnTag(tag);
-    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead());
+}
+
+TEST_F(TagAllocatorTest, givenFullCacheWhenTagIsReturnedThenPushItToFreeList) {
+    MockTagAllocator tagAllocator(memoryManager, 64, 16);
+
+    TagNode<timeStamps> *tagNodes[TagAllocatorConstants::cachedNodesPerSlot + 1];
+    for (auto &tagNode : tagNodes) {
+        tagNode = tagAllocator.getTag();
+    }
+    for (auto &tagNode : tagNodes) {
+        tagAllocator.returnTag(tagNode);
+    }
+
+    EXPECT_EQ(tagNodes[TagAllocatorConstants::cachedNodesPerSlot], tagAllocator.getFreeTagsHead());
+    EXPECT_EQ(0u, tagAllocator.getNumUsedTags());
+}
+
+TEST_F(TagAllocatorTest, givenEmptyFreeListWhenTagIsTakenThenGrowAndKeepPreviousNodesValid) {
+    // Big alignment to force only 1 tag
+    MockTagAllocator tagAllocator(memoryManager, 1, 4096);
+
+    auto tagNode1 = tagAllocator.getTag();
+    EXPECT_EQ(nullptr, tagAllocator.popFromFreeTags());
+
+    auto tagNode2 = tagAllocator.getTag();
+    EXPECT_NE(tagNode1, tagNode2);
+    EXPECT_EQ(2u, tagAllocator.peekNumTags());
+
+    tagAllocator.returnTag(tagNode1);
+    tagAllocator.returnTag(tagNode2);
+    EXPECT_TRUE(tagAllocator.peekIsFreeTag(tagNode1));
+    EXPECT_TRUE(tagAllocator.peekIsFreeTag(tagNode2));
 }